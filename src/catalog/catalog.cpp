@@ -556,6 +556,7 @@ ResultType Catalog::CreateTable(concurrency::TransactionContext *txn,
                                column.IsNotNull(),
                                column.HasDefault(),
                                column.GetDefaultValue(),
+                               column.IsDictionaryEncoded(),
                                pool_.get());
     column_id++;
   }
@@ -15,6 +15,7 @@
 #include <sstream>
 
 #include "common/internal_types.h"
+#include "storage/string_dictionary.h"
 
 namespace peloton {
 namespace catalog {
@@ -42,6 +43,13 @@ void Column::SetInlined() {
   }
 }
 
+void Column::SetDictionaryEncoded() {
+  PELOTON_ASSERT(column_type_ == type::TypeId::VARCHAR && is_inlined_ == false);
+  if (dictionary_ == nullptr) {
+    dictionary_.reset(new storage::StringDictionary());
+  }
+}
+
 const std::string Column::GetInfo() const {
   std::ostringstream os;
 
@@ -56,6 +64,10 @@ const std::string Column::GetInfo() const {
     os << "VarLength:" << variable_length_;
   }
 
+  if (dictionary_ != nullptr) {
+    os << ", Dictionary";
+  }
+
   if (is_not_null_ && has_default_) {
     os << ", {NOT NULL, DEFAULT:"
        << default_value_->ToString() << "}";
@@ -46,7 +46,11 @@ ColumnCatalogEntry::ColumnCatalogEntry(executor::LogicalTile *tile,
       is_not_null_(tile->GetValue(tupleId, ColumnCatalog::ColumnId::IS_NOT_NULL)
                       .GetAs<bool>()),
       has_default_(tile->GetValue(tupleId, ColumnCatalog::ColumnId::HAS_DEFAULT)
-                      .GetAs<bool>()) {
+                      .GetAs<bool>()),
+      is_dictionary_encoded_(
+          tile->GetValue(tupleId,
+                         ColumnCatalog::ColumnId::IS_DICTIONARY_ENCODED)
+              .GetAs<bool>()) {
   // deserialize default value if the column has default constraint
   if (has_default_) {
     auto dv_val =
@@ -91,6 +95,7 @@ ColumnCatalog::ColumnCatalog(concurrency::TransactionContext *txn,
                  column.IsNotNull(),
                  column.HasDefault(),
                  column.GetDefaultValue(),
+                 column.IsDictionaryEncoded(),
                  pool);
     column_id++;
   }
@@ -154,11 +159,17 @@ std::unique_ptr<catalog::Schema> ColumnCatalog::InitializeSchema() {
       type::TypeId::VARBINARY, type::Type::GetTypeSize(type::TypeId::VARBINARY),
       "default_value_bin", false);
 
+  auto is_dictionary_encoded_column = catalog::Column(
+      type::TypeId::BOOLEAN, type::Type::GetTypeSize(type::TypeId::BOOLEAN),
+      "is_dictionary_encoded", true);
+  is_dictionary_encoded_column.SetNotNull();
+
   std::unique_ptr<catalog::Schema> column_catalog_schema(new catalog::Schema(
       {table_id_column, column_name_column, column_id_column,
        column_offset_column, column_type_column, column_length_column,
        is_inlined_column, is_not_null_column, has_default_column,
-       default_value_src_column, default_value_bin_column}));
+       default_value_src_column, default_value_bin_column,
+       is_dictionary_encoded_column}));
 
   column_catalog_schema->AddConstraint(std::make_shared<Constraint>(
       COLUMN_CATALOG_CON_PKEY_OID, ConstraintType::PRIMARY, "con_primary",
@@ -186,6 +197,7 @@ bool ColumnCatalog::InsertColumn(concurrency::TransactionContext *txn,
                                  bool is_not_null,
                                  bool is_default,
                                  const std::shared_ptr<type::Value> default_value,
+                                 bool is_dictionary_encoded,
                                  type::AbstractPool *pool) {
   // Create the tuple first
   std::unique_ptr<storage::Tuple> tuple(
@@ -201,6 +213,7 @@ bool ColumnCatalog::InsertColumn(concurrency::TransactionContext *txn,
   auto val6 = type::ValueFactory::GetBooleanValue(is_inlined);
   auto val7 = type::ValueFactory::GetBooleanValue(is_not_null);
   auto val8 = type::ValueFactory::GetBooleanValue(is_default);
+  auto val11 = type::ValueFactory::GetBooleanValue(is_dictionary_encoded);
 
   tuple->SetValue(ColumnId::TABLE_OID, val0, pool);
   tuple->SetValue(ColumnId::COLUMN_NAME, val1, pool);
@@ -211,6 +224,7 @@ bool ColumnCatalog::InsertColumn(concurrency::TransactionContext *txn,
   tuple->SetValue(ColumnId::IS_INLINED, val6, pool);
   tuple->SetValue(ColumnId::IS_NOT_NULL, val7, pool);
   tuple->SetValue(ColumnId::HAS_DEFAULT, val8, pool);
+  tuple->SetValue(ColumnId::IS_DICTIONARY_ENCODED, val11, pool);
 
   // set default value if the column has default constraint
   if (is_default) {
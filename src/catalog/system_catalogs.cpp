@@ -71,6 +71,7 @@ SystemCatalogs::SystemCatalogs(concurrency::TransactionContext *txn,
                                   column.IsNotNull(),
                                   column.HasDefault(),
                                   column.GetDefaultValue(),
+                                  column.IsDictionaryEncoded(),
                                   pool);
       column_id++;
     }
@@ -11,9 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "codegen/expression/comparison_translator.h"
+#include "codegen/string_dictionary.h"
 #include "codegen/type/type_system.h"
 
 #include "expression/comparison_expression.h"
+#include "expression/tuple_value_expression.h"
 
 namespace peloton {
 namespace codegen {
@@ -22,8 +24,39 @@ namespace codegen {
 ComparisonTranslator::ComparisonTranslator(
     const expression::ComparisonExpression &comparison,
     CompilationContext &context)
-    : ExpressionTranslator(comparison, context) {
+    : ExpressionTranslator(comparison, context),
+      dictionary_(nullptr),
+      lookup_left_(false),
+      lookup_right_(false),
+      code_cache_id_(0) {
   PELOTON_ASSERT(comparison.GetChildrenSize() == 2);
+
+  // (In)equality of the strings of a dictionary-encoded column is evaluated on
+  // their codes
+  auto comparison_type = comparison.GetExpressionType();
+  if (comparison_type != ExpressionType::COMPARE_EQUAL &&
+      comparison_type != ExpressionType::COMPARE_NOTEQUAL) {
+    return;
+  }
+
+  const auto &left = *comparison.GetChild(0);
+  const auto &right = *comparison.GetChild(1);
+  const auto *left_dictionary = GetDictionary(left);
+  const auto *right_dictionary = GetDictionary(right);
+  if (left_dictionary != nullptr && left_dictionary == right_dictionary) {
+    dictionary_ = left_dictionary;
+  } else if (left_dictionary != nullptr && IsConstantString(right)) {
+    dictionary_ = left_dictionary;
+    lookup_right_ = true;
+  } else if (right_dictionary != nullptr && IsConstantString(left)) {
+    dictionary_ = right_dictionary;
+    lookup_left_ = true;
+  }
+
+  if (lookup_left_ || lookup_right_) {
+    code_cache_id_ = context.GetQueryState().RegisterState(
+        "dictionaryCode", context.GetCodeGen().Int32Type());
+  }
 }
 
 // Produce the result of performing the comparison of left and right values
@@ -34,6 +67,10 @@ codegen::Value ComparisonTranslator::DeriveValue(CodeGen &codegen,
   codegen::Value left = row.DeriveValue(codegen, *comparison.GetChild(0));
   codegen::Value right = row.DeriveValue(codegen, *comparison.GetChild(1));
 
+  if (dictionary_ != nullptr) {
+    return DeriveCodeComparison(codegen, left, right);
+  }
+
   switch (comparison.GetExpressionType()) {
     case ExpressionType::COMPARE_EQUAL:
       return left.CompareEq(codegen, right);
@@ -66,5 +103,52 @@ codegen::Value ComparisonTranslator::DeriveValue(CodeGen &codegen,
   }
 }
 
+const storage::StringDictionary *ComparisonTranslator::GetDictionary(
+    const expression::AbstractExpression &expression) {
+  if (expression.GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    return nullptr;
+  }
+  const auto &tuple_value =
+      static_cast<const expression::TupleValueExpression &>(expression);
+  const auto *ai = tuple_value.GetAttributeRef();
+  return ai != nullptr ? ai->dictionary : nullptr;
+}
+
+bool ComparisonTranslator::IsConstantString(
+    const expression::AbstractExpression &expression) {
+  auto expression_type = expression.GetExpressionType();
+  return (expression_type == ExpressionType::VALUE_CONSTANT ||
+          expression_type == ExpressionType::VALUE_PARAMETER) &&
+         expression.GetValueType() == peloton::type::TypeId::VARCHAR;
+}
+
+codegen::Value ComparisonTranslator::DeriveCodeComparison(
+    CodeGen &codegen, const codegen::Value &left,
+    const codegen::Value &right) const {
+  StringDictionary dictionary{*dictionary_};
+
+  // A string is equal to a string of the column iff it has the same code. A
+  // constant that is not in the dictionary gets a code that no string of the
+  // column has.
+  llvm::Value *code_cache_ptr = nullptr;
+  if (lookup_left_ || lookup_right_) {
+    code_cache_ptr =
+        context_.GetQueryState().LoadStatePtr(codegen, code_cache_id_);
+  }
+  codegen::Value left_code =
+      lookup_left_ ? dictionary.LookupCode(codegen, left, code_cache_ptr)
+                   : dictionary.GetCode(codegen, left);
+  codegen::Value right_code =
+      lookup_right_ ? dictionary.LookupCode(codegen, right, code_cache_ptr)
+                    : dictionary.GetCode(codegen, right);
+
+  const auto &comparison = GetExpressionAs<expression::ComparisonExpression>();
+  if (comparison.GetExpressionType() == ExpressionType::COMPARE_EQUAL) {
+    return left_code.CompareEq(codegen, right_code);
+  } else {
+    return left_code.CompareNe(codegen, right_code);
+  }
+}
+
 }  // namespace codegen
 }  // namespace peloton
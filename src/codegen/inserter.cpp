@@ -11,6 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "codegen/inserter.h"
+
+#include <algorithm>
+
 #include "codegen/transaction_runtime.h"
 #include "common/container_tuple.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -25,14 +28,33 @@ namespace peloton {
 namespace codegen {
 
 void Inserter::Init(storage::DataTable *table,
-                    executor::ExecutorContext *executor_context) {
+                    executor::ExecutorContext *executor_context,
+                    bool bulk_load) {
   PELOTON_ASSERT(table && executor_context);
   table_ = table;
   executor_context_ = executor_context;
+  bulk_load_ = bulk_load;
+  bulk_tile_group_ = nullptr;
+  bulk_tuple_start_ = 0;
 }
 
 char *Inserter::AllocateTupleStorage() {
-  location_ = table_->GetEmptyTupleSlot(nullptr);
+  if (bulk_load_) {
+    oid_t tuple_id = INVALID_OID;
+    if (bulk_tile_group_ != nullptr) {
+      tuple_id = bulk_tile_group_->InsertTuple(nullptr);
+    }
+    // The tile group is full, insert its tuples and start a new one
+    if (tuple_id == INVALID_OID) {
+      Flush();
+      bulk_tile_group_ = table_->AddBulkLoadTileGroup();
+      bulk_tuple_start_ = 0;
+      tuple_id = bulk_tile_group_->InsertTuple(nullptr);
+    }
+    location_ = ItemPointer(bulk_tile_group_->GetTileGroupId(), tuple_id);
+  } else {
+    location_ = table_->GetEmptyTupleSlot(nullptr);
+  }
 
   // Get the tile offset assuming that it is a row store
   auto tile_group = table_->GetTileGroupById(location_.block);
@@ -54,8 +76,16 @@ void Inserter::Insert() {
   auto *txn = executor_context_->GetTransaction();
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
-  ContainerTuple<storage::TileGroup> tuple(
-      table_->GetTileGroupById(location_.block).get(), location_.offset);
+  // the tuple is written to the tile directly
+  auto tile_group = table_->GetTileGroupById(location_.block).get();
+  tile_group->UpdateZoneMap(location_.offset);
+
+  // The tuples of a bulk load are inserted when their tile group is full
+  if (bulk_load_) {
+    return;
+  }
+
+  ContainerTuple<storage::TileGroup> tuple(tile_group, location_.offset);
   ItemPointer *index_entry_ptr = nullptr;
   bool result = table_->InsertTuple(&tuple, location_, txn, &index_entry_ptr);
   if (result == false) {
@@ -66,6 +96,30 @@ void Inserter::Insert() {
   executor_context_->num_processed++;
 }
 
+void Inserter::Flush() {
+  PELOTON_ASSERT(table_ && executor_context_);
+  if (bulk_tile_group_ == nullptr) {
+    return;
+  }
+
+  auto *txn = executor_context_->GetTransaction();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Once a tuple is not inserted, the load is aborted
+  oid_t tuple_end = std::min(bulk_tile_group_->GetNextTupleSlot(),
+                             bulk_tile_group_->GetAllocatedTupleCount());
+  if (txn->GetResult() == ResultType::SUCCESS) {
+    bool result = table_->BulkInsertTuples(bulk_tile_group_, bulk_tuple_start_,
+                                           tuple_end, txn);
+    if (result == false) {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+    } else {
+      executor_context_->num_processed += tuple_end - bulk_tuple_start_;
+    }
+  }
+  bulk_tuple_start_ = tuple_end;
+}
+
 void Inserter::TearDown() {
   // Updater object does not destruct its own data structures
   tile_.reset();
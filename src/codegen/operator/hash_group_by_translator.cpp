@@ -17,6 +17,7 @@
 #include "codegen/proxy/oa_hash_table_proxy.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/lang/vectorized_loop.h"
+#include "codegen/string_dictionary.h"
 #include "codegen/type/integer_type.h"
 
 namespace peloton {
@@ -56,12 +57,18 @@ HashGroupByTranslator::HashGroupByTranslator(
     context.Prepare(*group_by.GetPredicate());
   }
 
-  // Prepare the grouping expressions
+  // Prepare the grouping expressions. The strings of a dictionary-encoded
+  // column are grouped on their codes.
   // TODO: We need to handle grouping keys that are expressions (i.e., prepare)
   std::vector<type::Type> key_type;
   const auto &grouping_ais = group_by.GetGroupbyAIs();
   for (const auto *grouping_ai : grouping_ais) {
-    key_type.push_back(grouping_ai->type);
+    if (grouping_ai->dictionary != nullptr) {
+      key_type.push_back(
+          type::Type{type::Integer::Instance(), grouping_ai->type.nullable});
+    } else {
+      key_type.push_back(grouping_ai->type);
+    }
   }
 
   // Prepare all the aggregation expressions and setup the storage format of
@@ -260,7 +267,11 @@ void HashGroupByTranslator::CollectHashKeys(
   CodeGen &codegen = GetCodeGen();
   const auto &plan = GetPlanAs<planner::AggregatePlan>();
   for (const auto *gb_ai : plan.GetGroupbyAIs()) {
-    key.push_back(row.DeriveValue(codegen, gb_ai));
+    codegen::Value gb_val = row.DeriveValue(codegen, gb_ai);
+    if (gb_ai->dictionary != nullptr) {
+      gb_val = StringDictionary{*gb_ai->dictionary}.GetCode(codegen, gb_val);
+    }
+    key.push_back(gb_val);
   }
 }
 
@@ -270,8 +281,10 @@ void HashGroupByTranslator::CollectHashKeys(
 
 HashGroupByTranslator::AggregateFinalizer::AggregateFinalizer(
     const Aggregation &aggregation,
+    const std::vector<const planner::AttributeInfo *> &grouping_ais,
     HashTable::HashTableAccess &hash_table_access)
     : aggregation_(aggregation),
+      grouping_ais_(grouping_ais),
       hash_table_access_(hash_table_access),
       finalized_(false) {}
 
@@ -284,6 +297,15 @@ HashGroupByTranslator::AggregateFinalizer::GetAggregates(CodeGen &codegen,
     // First extract keys from buckets
     hash_table_access_.ExtractBucketKeys(codegen, index, final_aggregates_);
 
+    // Turn the codes of dictionary-encoded keys back into their strings
+    for (uint32_t i = 0; i < grouping_ais_.size(); i++) {
+      const auto *dictionary = grouping_ais_[i]->dictionary;
+      if (dictionary != nullptr) {
+        final_aggregates_[i] = StringDictionary{*dictionary}.GetString(
+            codegen, final_aggregates_[i]);
+      }
+    }
+
     // Now extract aggregate values
     llvm::Value *data_area = hash_table_access_.BucketValue(codegen, index);
     aggregation_.FinalizeValues(codegen, data_area, final_aggregates_);
@@ -322,9 +344,10 @@ void HashGroupByTranslator::ProduceResults::ProcessEntries(
   RowBatch batch{ctx_.GetCompilationContext(), start, end, selection_vector,
                  true};
 
-  AggregateFinalizer finalizer{aggregation_, access};
-
   auto &grouping_ais = plan_.GetGroupbyAIs();
+
+  AggregateFinalizer finalizer{aggregation_, grouping_ais, access};
+
   auto &aggregates = plan_.GetUniqueAggTerms();
 
   std::vector<AggregateAccess> accessors;
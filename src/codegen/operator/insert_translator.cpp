@@ -53,10 +53,13 @@ void InsertTranslator::InitializeQueryState() {
       {GetStorageManagerPtr(), codegen.Const32(table->GetDatabaseOid()),
        codegen.Const32(table->GetOid())});
 
-  // Initialize the inserter with txn and table
+  // Initialize the inserter with txn and table. The tuples of a child are
+  // bulk loaded.
+  bool bulk_load = GetInsertPlan().GetChildrenSize() != 0;
   llvm::Value *inserter = LoadStatePtr(inserter_state_id_);
-  codegen.Call(InserterProxy::Init,
-               {inserter, table_ptr, GetExecutorContextPtr()});
+  codegen.Call(InserterProxy::Init, {inserter, table_ptr,
+                                     GetExecutorContextPtr(),
+                                     codegen.ConstBool(bulk_load)});
 }
 
 void InsertTranslator::Produce() const {
@@ -68,6 +71,10 @@ void InsertTranslator::Produce() const {
   if (GetInsertPlan().GetChildrenSize() != 0) {
     /// First case
     GetCompilationContext().Produce(*GetInsertPlan().GetChild(0));
+
+    /// Insert the tuples of the last tile group of the bulk load
+    auto *inserter = LoadStatePtr(inserter_state_id_);
+    GetCodeGen().Call(InserterProxy::Flush, {inserter});
   } else {
     /// Regular insert with constants
     auto producer = [this](UNUSED_ATTRIBUTE ConsumerContext &ctx) {
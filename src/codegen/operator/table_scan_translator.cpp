@@ -184,11 +184,8 @@ void TableScanTranslator::ProduceSerial() const {
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
     size_t num_preds = 0;
 
-    auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
-    if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
-      if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
-      }
+    if (predicate != nullptr && predicate->IsZoneMappable()) {
+      num_preds = predicate->GetNumberofParsedPredicates();
     }
 
     ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
@@ -241,11 +238,8 @@ void TableScanTranslator::ProduceParallel() const {
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
     size_t num_preds = 0;
 
-    auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
-    if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
-      if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
-      }
+    if (predicate != nullptr && predicate->IsZoneMappable()) {
+      num_preds = predicate->GetNumberofParsedPredicates();
     }
 
     // Scan the given range of the table
@@ -27,6 +27,7 @@ DEFINE_METHOD(peloton::codegen, Inserter, Init);
 DEFINE_METHOD(peloton::codegen, Inserter, AllocateTupleStorage);
 DEFINE_METHOD(peloton::codegen, Inserter, GetPool);
 DEFINE_METHOD(peloton::codegen, Inserter, Insert);
+DEFINE_METHOD(peloton::codegen, Inserter, Flush);
 DEFINE_METHOD(peloton::codegen, Inserter, TearDown);
 
 }  // namespace codegen
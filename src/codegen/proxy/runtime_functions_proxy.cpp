@@ -21,7 +21,7 @@ namespace peloton {
 namespace codegen {
 
 DEFINE_TYPE(ColumnLayoutInfo, "peloton::ColumnLayoutInfo", col_start_ptr,
-            stride, columnar);
+            stride, columnar, encoding, reference, bit_width);
 
 DEFINE_TYPE(AbstractExpression, "peloton::expression::AbstractExpression",
             opaque);
@@ -32,6 +32,10 @@ DEFINE_METHOD(peloton::codegen, RuntimeFunctions, HashMurmur3);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, HashCrc64);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroup);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroupLayout);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetCompressedValue);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, InternString);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetDictionaryCode);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetDictionaryVarlen);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, FillPredicateArray);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecuteTableScan);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecutePerState);
@@ -12,6 +12,8 @@
 
 #include "codegen/proxy/tile_group_proxy.h"
 
+#include "codegen/proxy/zone_map_proxy.h"
+
 namespace peloton {
 namespace codegen {
 
@@ -19,6 +21,7 @@ DEFINE_TYPE(TileGroup, "peloton::storage::TileGroup", opaque);
 
 DEFINE_METHOD(peloton::storage, TileGroup, GetNextTupleSlot);
 DEFINE_METHOD(peloton::storage, TileGroup, GetTileGroupId);
+DEFINE_METHOD(peloton::storage, TileGroup, ShouldScan);
 
 }  // namespace codegen
 }  // namespace peloton
@@ -17,6 +17,7 @@
 #include "planner/hash_join_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace codegen {
@@ -90,6 +91,12 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
   switch (plan.GetPlanNodeType()) {
     case PlanNodeType::SEQSCAN: {
       auto &scan_plan = static_cast<const planner::SeqScanPlan &>(plan);
+      // Generated scans read the tiles directly, and can not follow the
+      // columns that delta versions inherit from older versions
+      if (scan_plan.GetTable() != nullptr &&
+          scan_plan.GetTable()->UsesDeltaVersions()) {
+        return false;
+      }
       pred = scan_plan.GetPredicate();
       break;
     }
@@ -24,6 +24,7 @@
 #include "storage/data_table.h"
 #include "storage/layout.h"
 #include "storage/storage_manager.h"
+#include "storage/string_dictionary.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "threadpool/mono_queue_pool.h"
@@ -78,6 +79,13 @@ uint64_t RuntimeFunctions::HashCrc64(const char *buf, uint64_t length,
 storage::TileGroup *RuntimeFunctions::GetTileGroup(storage::DataTable *table,
                                                    uint64_t tile_group_index) {
   auto tile_group = table->GetTileGroup(tile_group_index);
+
+  // Evicted tile groups ahead of the scan are read back in the background,
+  // while the scan reads this one
+  for (uint64_t prefetch_itr = 1;
+       prefetch_itr <= EVICTED_TILE_GROUP_PREFETCH_COUNT; prefetch_itr++) {
+    table->PrefetchTileGroup(tile_group_index + prefetch_itr);
+  }
   return tile_group.get();
 }
 
@@ -119,10 +127,7 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
   auto tile_map = layout.GetTileMap();
   // Find the mapping for each tile in the layout.
   for (auto tile_entry : tile_map) {
-    // Get the tile schema.
     auto tile_idx = tile_entry.first;
-    auto *tile = tile_group->GetTile(tile_idx);
-    auto tile_schema = tile->GetSchema();
     // Map the current column to a tile and a column offset in the tile.
     for (auto column_entry : tile_entry.second) {
       // Now grab the column information
@@ -130,11 +135,38 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
       oid_t tile_col_offset = column_entry.second;
       // Ensure that the col_idx is within the num_cols range
       PELOTON_ASSERT(col_idx < num_cols);
+      last_col_idx = col_idx;
+
+      // The column of a frozen tile is decoded from its compressed values,
+      // so that the tile is not thawed.
+      auto *compressed_column = tile_group->GetCompressedColumn(col_idx);
+      if (compressed_column != nullptr) {
+        auto encoding = compressed_column->GetEncoding();
+        if (encoding == storage::ColumnEncoding::FRAME_OF_REFERENCE) {
+          infos[col_idx].column =
+              const_cast<char *>(compressed_column->GetPackedData());
+        } else {
+          infos[col_idx].column = reinterpret_cast<char *>(
+              const_cast<storage::CompressedColumn *>(compressed_column));
+        }
+        infos[col_idx].stride = 0;
+        infos[col_idx].is_columnar = true;
+        infos[col_idx].encoding = static_cast<uint32_t>(encoding);
+        infos[col_idx].reference = compressed_column->GetReference();
+        infos[col_idx].bit_width = compressed_column->GetBitWidth();
+        continue;
+      }
+
+      auto *tile = tile_group->GetTile(tile_idx);
+      auto tile_schema = tile->GetSchema();
       infos[col_idx].column =
           tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_col_offset);
       infos[col_idx].stride = tile_schema->GetLength();
       infos[col_idx].is_columnar = tile_schema->GetColumnCount() == 1;
-      last_col_idx = col_idx;
+      infos[col_idx].encoding =
+          static_cast<uint32_t>(storage::ColumnEncoding::NONE);
+      infos[col_idx].reference = 0;
+      infos[col_idx].bit_width = 0;
       LOG_TRACE("Col [%u] start: %p, stride: %u, columnar: %s", col_idx,
                 infos[col_idx].column, infos[col_idx].stride,
                 infos[col_idx].is_columnar ? "true" : "false");
@@ -145,6 +177,37 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
                  (last_col_idx == (num_cols - 1)));
 }
 
+int64_t RuntimeFunctions::GetCompressedValue(const char *column,
+                                             uint32_t tuple_id) {
+  auto *compressed_column =
+      reinterpret_cast<const storage::CompressedColumn *>(column);
+  return compressed_column->GetRawValue(tuple_id);
+}
+
+void RuntimeFunctions::InternString(const char *dictionary, const char *data,
+                                    uint32_t len, char *buf) {
+  auto *string_dictionary = reinterpret_cast<storage::StringDictionary *>(
+      const_cast<char *>(dictionary));
+  *reinterpret_cast<const char **>(buf) = string_dictionary->Intern(data, len);
+}
+
+int32_t RuntimeFunctions::GetDictionaryCode(const char *dictionary,
+                                            const char *data, uint32_t len) {
+  if (data == nullptr) {
+    return storage::StringDictionary::invalid_code_;
+  }
+  auto *string_dictionary =
+      reinterpret_cast<const storage::StringDictionary *>(dictionary);
+  return string_dictionary->GetCode(data, len);
+}
+
+const char *RuntimeFunctions::GetDictionaryVarlen(const char *dictionary,
+                                                  int32_t code) {
+  auto *string_dictionary =
+      reinterpret_cast<const storage::StringDictionary *>(dictionary);
+  return string_dictionary->GetVarlen(code);
+}
+
 void RuntimeFunctions::ExecuteTableScan(
     void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
     uint32_t db_oid, uint32_t table_oid, void *func) {
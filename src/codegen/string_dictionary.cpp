@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.cpp
+//
+// Identification: src/codegen/string_dictionary.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/string_dictionary.h"
+
+#include "codegen/lang/if.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+#include "codegen/proxy/varlen_proxy.h"
+#include "codegen/type/integer_type.h"
+#include "codegen/type/varchar_type.h"
+#include "codegen/varlen.h"
+#include "storage/string_dictionary.h"
+
+namespace peloton {
+namespace codegen {
+
+StringDictionary::StringDictionary(const storage::StringDictionary &dictionary)
+    : dictionary_(dictionary) {}
+
+void StringDictionary::StoreString(CodeGen &codegen, const codegen::Value &str,
+                                   llvm::Value *buf) const {
+  codegen.Call(RuntimeFunctionsProxy::InternString,
+               {GetDictionaryPtr(codegen), str.GetValue(), str.GetLength(),
+                buf});
+}
+
+codegen::Value StringDictionary::GetCode(CodeGen &codegen,
+                                         const codegen::Value &str) const {
+  // The code is stored in the four bytes in front of the length of the string
+  auto load_code = [&codegen, &str]() {
+    auto *code_ptr = codegen->CreateInBoundsGEP(
+        codegen.ByteType(), str.GetValue(),
+        codegen.Const64(-static_cast<int64_t>(sizeof(int32_t) +
+                                              sizeof(uint32_t))));
+    return codegen->CreateLoad(codegen->CreateBitCast(
+        code_ptr, codegen.Int32Type()->getPointerTo()));
+  };
+
+  if (!str.IsNullable()) {
+    return codegen::Value{type::Integer::Instance(), load_code()};
+  }
+
+  // A NULL string has no entry, it gets an invalid code
+  llvm::Value *is_null = str.IsNull(codegen);
+  llvm::Value *null_code = codegen.Const32(0);
+  llvm::Value *code = nullptr;
+  lang::If str_not_null{codegen, codegen->CreateNot(is_null)};
+  {
+    code = load_code();
+  }
+  str_not_null.EndIf();
+  code = str_not_null.BuildPHI(code, null_code);
+
+  return codegen::Value{type::Type{type::Integer::Instance(), true}, code,
+                        nullptr, is_null};
+}
+
+codegen::Value StringDictionary::LookupCode(CodeGen &codegen,
+                                            const codegen::Value &str,
+                                            llvm::Value *code_cache_ptr) const {
+  // Look the string up once, the code of a constant does not change while the
+  // query runs
+  llvm::Value *cached_code = codegen->CreateLoad(code_cache_ptr);
+  llvm::Value *looked_up_code = nullptr;
+  lang::If not_looked_up{
+      codegen, codegen->CreateICmpEQ(cached_code, codegen.Const32(0))};
+  {
+    looked_up_code = codegen.Call(
+        RuntimeFunctionsProxy::GetDictionaryCode,
+        {GetDictionaryPtr(codegen), str.GetValue(), str.GetLength()});
+    codegen->CreateStore(looked_up_code, code_cache_ptr);
+  }
+  not_looked_up.EndIf();
+  llvm::Value *code = not_looked_up.BuildPHI(looked_up_code, cached_code);
+
+  if (!str.IsNullable()) {
+    return codegen::Value{type::Integer::Instance(), code};
+  }
+  return codegen::Value{type::Type{type::Integer::Instance(), true}, code,
+                        nullptr, str.IsNull(codegen)};
+}
+
+codegen::Value StringDictionary::GetString(CodeGen &codegen,
+                                           const codegen::Value &code) const {
+  llvm::Value *varlen_ptr =
+      codegen.Call(RuntimeFunctionsProxy::GetDictionaryVarlen,
+                   {GetDictionaryPtr(codegen), code.GetValue()});
+  varlen_ptr = codegen->CreateBitCast(
+      varlen_ptr, VarlenProxy::GetType(codegen)->getPointerTo());
+
+  llvm::Value *data_ptr = nullptr, *length = nullptr, *is_null = nullptr;
+  if (!code.IsNullable()) {
+    Varlen::SafeGetPtrAndLength(codegen, varlen_ptr, data_ptr, length);
+    return codegen::Value{type::Varchar::Instance(), data_ptr, length};
+  }
+
+  // The code of a NULL string is not a valid code, so it has no varlen
+  Varlen::GetPtrAndLength(codegen, varlen_ptr, data_ptr, length, is_null);
+  return codegen::Value{type::Type{type::Varchar::Instance(), true}, data_ptr,
+                        length, is_null};
+}
+
+llvm::Value *StringDictionary::GetDictionaryPtr(CodeGen &codegen) const {
+  return codegen->CreateIntToPtr(codegen.Const64((int64_t)&dictionary_),
+                                 codegen.CharPtrType());
+}
+
+}  // namespace codegen
+}  // namespace peloton
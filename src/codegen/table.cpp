@@ -17,6 +17,7 @@
 #include "codegen/lang/loop.h"
 #include "codegen/lang/if.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
+#include "codegen/proxy/tile_group_proxy.h"
 #include "codegen/proxy/zone_map_proxy.h"
 #include "storage/data_table.h"
 
@@ -40,11 +41,6 @@ llvm::Value *Table::GetTileGroup(CodeGen &codegen, llvm::Value *table_ptr,
                       {table_ptr, tile_group_id});
 }
 
-// We acquire a Zone Map manager instance
-llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
-  return codegen.Call(ZoneMapManagerProxy::GetInstance, {});
-}
-
 // Generate a scan over all tile groups.
 //
 // @code
@@ -57,8 +53,9 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 // num_tile_groups = GetTileGroupCount(table_ptr)
 //
 // for (; tile_group_idx < num_tile_groups; ++tile_group_idx) {
-//   if (ShouldScanTileGroup(predicate_array, tile_group_idx)) {
-//      tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
+//   tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
+//   if (tile_group_ptr != nullptr &&
+//       tile_group_ptr->ShouldScan(predicate_array, num_predicates)) {
 //      consumer.TileGroupStart(tile_group_ptr);
 //      tile_group.TidScan(tile_group_ptr, column_layouts, vector_size,
 //                         consumer);
@@ -103,28 +100,39 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
     tile_group_idx = loop.GetLoopVar(0);
     llvm::Value *tile_group_ptr =
         GetTileGroup(codegen, table_ptr, tile_group_idx);
-    llvm::Value *tile_group_id =
-        tile_group_.GetTileGroupId(codegen, tile_group_ptr);
-
-    // Check zone map
-    llvm::Value *cond = codegen.Call(
-        ZoneMapManagerProxy::ShouldScanTileGroup,
-        {GetZoneMapManager(codegen), predicate_array,
-         codegen.Const32(num_predicates), table_ptr, tile_group_idx});
 
-    codegen::lang::If should_scan_tilegroup{codegen, cond};
+    // Skip the tile group if it has been dropped after compaction
+    codegen::lang::If tile_group_exists{
+        codegen, codegen->CreateIsNotNull(tile_group_ptr)};
     {
-      // Inform the consumer that we're starting iteration over the tile group
-      consumer.TileGroupStart(codegen, tile_group_id, tile_group_ptr);
-
-      // Generate the scan cover over the given tile group
-      tile_group_.GenerateTidScan(codegen, tile_group_ptr, column_layouts,
-                                  batch_size, consumer);
-
-      // Inform the consumer that we've finished iteration over the tile group
-      consumer.TileGroupFinish(codegen, tile_group_ptr);
+      llvm::Value *tile_group_id =
+          tile_group_.GetTileGroupId(codegen, tile_group_ptr);
+
+      // Check the zone map of the tile group
+      llvm::Value *cond = codegen.ConstBool(true);
+      if (num_predicates != 0) {
+        cond = codegen.Call(
+            TileGroupProxy::ShouldScan,
+            {tile_group_ptr, predicate_array, codegen.Const32(num_predicates)});
+      }
+
+      codegen::lang::If should_scan_tilegroup{codegen, cond};
+      {
+        // Inform the consumer that we're starting iteration over the tile
+        // group
+        consumer.TileGroupStart(codegen, tile_group_id, tile_group_ptr);
+
+        // Generate the scan cover over the given tile group
+        tile_group_.GenerateTidScan(codegen, tile_group_ptr, column_layouts,
+                                    batch_size, consumer);
+
+        // Inform the consumer that we've finished iteration over the tile
+        // group
+        consumer.TileGroupFinish(codegen, tile_group_ptr);
+      }
+      should_scan_tilegroup.EndIf();
     }
-    should_scan_tilegroup.EndIf();
+    tile_group_exists.EndIf();
 
     // Move to next tile group in the table
     tile_group_idx = codegen->CreateAdd(tile_group_idx, codegen.Const64(1));
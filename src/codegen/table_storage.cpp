@@ -15,6 +15,7 @@
 #include "catalog/schema.h"
 #include "codegen/lang/if.h"
 #include "codegen/proxy/string_functions_proxy.h"
+#include "codegen/string_dictionary.h"
 #include "codegen/type/sql_type.h"
 #include "codegen/type/type.h"
 #include "codegen/value.h"
@@ -49,8 +50,14 @@ void TableStorage::StoreValues(CodeGen &codegen, llvm::Value *tuple_ptr,
       }
       value_is_null.ElseBlock();
       {
-        codegen.Call(StringFunctionsProxy::WriteString,
-                     {value.GetValue(), value.GetLength(), val_ptr, pool});
+        auto *dictionary = schema_.GetDictionary(i);
+        if (dictionary != nullptr) {
+          // The strings of a dictionary-encoded column are interned
+          StringDictionary{*dictionary}.StoreString(codegen, value, val_ptr);
+        } else {
+          codegen.Call(StringFunctionsProxy::WriteString,
+                       {value.GetValue(), value.GetLength(), val_ptr, pool});
+        }
       }
       value_is_null.EndIf();
     } else {
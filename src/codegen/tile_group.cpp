@@ -22,6 +22,7 @@
 #include "codegen/vector.h"
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/type/boolean_type.h"
+#include "storage/compressed_column.h"
 
 namespace peloton {
 namespace codegen {
@@ -104,7 +105,14 @@ std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
         layout_type, column_layout_infos, col_id, 1));
     auto *columnar = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
         layout_type, column_layout_infos, col_id, 2));
-    layouts.push_back(ColumnLayout{col_id, start, stride, columnar});
+    auto *encoding = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+        layout_type, column_layout_infos, col_id, 3));
+    auto *reference = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+        layout_type, column_layout_infos, col_id, 4));
+    auto *bit_width = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+        layout_type, column_layout_infos, col_id, 5));
+    layouts.push_back(ColumnLayout{col_id, start, stride, columnar, encoding,
+                                   reference, bit_width});
   }
   return layouts;
 }
@@ -145,10 +153,14 @@ codegen::Value TileGroup::LoadColumn(
     sql_type.GetTypeForMaterialization(codegen, col_type, col_len_type);
     PELOTON_ASSERT(col_type != nullptr && col_len_type == nullptr);
 
-    // val = *(col_type*)col_address;
-    val = codegen->CreateLoad(
-        col_type,
-        codegen->CreateBitCast(col_address, col_type->getPointerTo()));
+    if (storage::CompressedColumn::IsCompressedType(sql_type.TypeId())) {
+      val = LoadCompressibleColumn(codegen, tid, col_address, col_type, layout);
+    } else {
+      // val = *(col_type*)col_address;
+      val = codegen->CreateLoad(
+          col_type,
+          codegen->CreateBitCast(col_address, col_type->getPointerTo()));
+    }
 
     if (is_nullable) {
       // To check for NULL, we need to perform a comparison between the value we
@@ -178,6 +190,81 @@ codegen::Value TileGroup::LoadColumn(
   return codegen::Value{type, val, length, is_null};
 }
 
+// The column of a frozen tile group may be compressed, so the load is
+// guarded by the encoding of the column in this tile group:
+//
+// @code
+// if (encoding == NONE) {
+//   val := *(col_type*)col_address
+// } else if (encoding == FRAME_OF_REFERENCE) {
+//   bit := tid * bit_width
+//   word := *(uint64_t*)(col_start + bit / 8)
+//   val := reference + ((word >> (bit % 8)) & ((1 << bit_width) - 1))
+// } else {
+//   val := GetCompressedValue(col_start, tid)
+// }
+// @endcode
+//
+llvm::Value *TileGroup::LoadCompressibleColumn(
+    CodeGen &codegen, llvm::Value *tid, llvm::Value *col_address,
+    llvm::Type *col_type, const TileGroup::ColumnLayout &layout) const {
+  auto *is_plain = codegen->CreateICmpEQ(
+      layout.encoding,
+      codegen.Const32(static_cast<uint32_t>(storage::ColumnEncoding::NONE)));
+
+  llvm::Value *plain_val = nullptr, *decoded_val = nullptr;
+  lang::If is_plain_column{codegen, is_plain, "plainColumn"};
+  {
+    plain_val = codegen->CreateLoad(
+        col_type,
+        codegen->CreateBitCast(col_address, col_type->getPointerTo()));
+  }
+  is_plain_column.ElseBlock("compressedColumn");
+  {
+    auto *is_frame_of_reference = codegen->CreateICmpEQ(
+        layout.encoding,
+        codegen.Const32(static_cast<uint32_t>(
+            storage::ColumnEncoding::FRAME_OF_REFERENCE)));
+
+    llvm::Value *unpacked_val = nullptr, *run_val = nullptr;
+    lang::If is_packed{codegen, is_frame_of_reference, "packedColumn"};
+    {
+      auto *bit_width =
+          codegen->CreateZExt(layout.bit_width, codegen.Int64Type());
+      auto *bit_offset = codegen->CreateMul(
+          codegen->CreateZExt(tid, codegen.Int64Type()), bit_width);
+      auto *word_address = codegen->CreateInBoundsGEP(
+          codegen.ByteType(), layout.col_start_ptr,
+          codegen->CreateLShr(bit_offset, codegen.Const64(3)));
+      auto *word = codegen->CreateAlignedLoad(
+          codegen->CreateBitCast(word_address,
+                                 codegen.Int64Type()->getPointerTo()),
+          1);
+      auto *mask = codegen->CreateSub(
+          codegen->CreateShl(codegen.Const64(1), bit_width), codegen.Const64(1));
+      auto *offset = codegen->CreateAnd(
+          codegen->CreateLShr(
+              word, codegen->CreateAnd(bit_offset, codegen.Const64(7))),
+          mask);
+      unpacked_val = codegen->CreateAdd(layout.reference, offset);
+    }
+    is_packed.ElseBlock("runLengthColumn");
+    {
+      run_val = codegen.Call(RuntimeFunctionsProxy::GetCompressedValue,
+                             {layout.col_start_ptr, tid});
+    }
+    is_packed.EndIf();
+    decoded_val = is_packed.BuildPHI(unpacked_val, run_val);
+
+    if (col_type != codegen.Int64Type()) {
+      decoded_val = codegen->CreateTrunc(decoded_val, col_type);
+    }
+  }
+  is_plain_column.EndIf();
+
+  return is_plain_column.BuildPHI(plain_val, decoded_val);
+}
+
 //===----------------------------------------------------------------------===//
 // TILE GROUP ROW
 //===----------------------------------------------------------------------===//
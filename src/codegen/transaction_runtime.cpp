@@ -12,6 +12,10 @@
 
 #include "codegen/transaction_runtime.h"
 
+#include <immintrin.h>
+#include <cstddef>
+#include <limits>
+
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "concurrency/transaction_context.h"
@@ -22,6 +26,79 @@
 namespace peloton {
 namespace codegen {
 
+namespace {
+
+// A version that is not owned by any transaction is visible iff it was
+// committed, and not invalidated, as of the read id. Versions that are owned
+// by a transaction take the full check of the transaction manager. Returns
+// the bitmask of the versions of the batch that are visible, and the bitmask
+// of the versions that are owned.
+template <uint32_t kBatchSize>
+uint32_t CheckBatchVisibility(const storage::TupleHeader *tuple_headers,
+                              cid_t read_id, uint32_t &owned_mask) {
+  uint32_t visible_mask = 0;
+  owned_mask = 0;
+  for (uint32_t i = 0; i < kBatchSize; i++) {
+    const auto &tuple_header = tuple_headers[i];
+    bool owned = tuple_header.txn_id != INITIAL_TXN_ID;
+    bool visible =
+        tuple_header.begin_ts <= read_id && read_id < tuple_header.end_ts;
+    owned_mask |= static_cast<uint32_t>(owned) << i;
+    visible_mask |= static_cast<uint32_t>(visible) << i;
+  }
+  return visible_mask;
+}
+
+#if defined(__AVX2__)
+// Check four versions at a time. The fields of the headers of the versions
+// are gathered into vectors, one header every 64 bytes. Commit ids are
+// unsigned, so they are compared with their sign bits flipped.
+template <>
+uint32_t CheckBatchVisibility<4>(const storage::TupleHeader *tuple_headers,
+                                 cid_t read_id, uint32_t &owned_mask) {
+  static_assert(sizeof(storage::TupleHeader) == 8 * sizeof(int64_t),
+                "The visibility check expects 64 byte tuple headers");
+
+  const auto *base = reinterpret_cast<const char *>(tuple_headers);
+  const __m256i header_idx = _mm256_setr_epi64x(0, 8, 16, 24);
+  const __m256i sign_bit =
+      _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+
+  __m256i txn_ids = _mm256_i64gather_epi64(
+      reinterpret_cast<const long long *>(
+          base + offsetof(storage::TupleHeader, txn_id)),
+      header_idx, 8);
+  __m256i begin_cids = _mm256_i64gather_epi64(
+      reinterpret_cast<const long long *>(
+          base + offsetof(storage::TupleHeader, begin_ts)),
+      header_idx, 8);
+  __m256i end_cids = _mm256_i64gather_epi64(
+      reinterpret_cast<const long long *>(
+          base + offsetof(storage::TupleHeader, end_ts)),
+      header_idx, 8);
+
+  __m256i read_ids = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(read_id)), sign_bit);
+  begin_cids = _mm256_xor_si256(begin_cids, sign_bit);
+  end_cids = _mm256_xor_si256(end_cids, sign_bit);
+
+  // owned = txn_id != INITIAL_TXN_ID
+  __m256i not_owned = _mm256_cmpeq_epi64(
+      txn_ids, _mm256_set1_epi64x(static_cast<int64_t>(INITIAL_TXN_ID)));
+  // visible = !(begin_cid > read_id) && end_cid > read_id
+  __m256i visible = _mm256_andnot_si256(
+      _mm256_cmpgt_epi64(begin_cids, read_ids),
+      _mm256_cmpgt_epi64(end_cids, read_ids));
+
+  owned_mask = ~static_cast<uint32_t>(_mm256_movemask_pd(
+                   _mm256_castsi256_pd(not_owned))) & 0xF;
+  return static_cast<uint32_t>(
+      _mm256_movemask_pd(_mm256_castsi256_pd(visible)));
+}
+#endif
+
+}  // namespace
+
 uint32_t TransactionRuntime::PerformVisibilityCheck(
     concurrency::TransactionContext &txn, storage::TileGroup &tile_group,
     uint32_t tid_start, uint32_t tid_end, uint32_t *selection_vector) {
@@ -31,10 +108,45 @@ uint32_t TransactionRuntime::PerformVisibilityCheck(
   // Get the tile group header
   auto tile_group_header = tile_group.GetHeader();
 
+  // Every tuple of an all-visible tile group is visible
+  if (tile_group_header->IsAllVisible(txn.GetReadId())) {
+    uint32_t out_idx = 0;
+    for (uint32_t i = tid_start; i < tid_end; i++) {
+      selection_vector[out_idx++] = i;
+    }
+    return out_idx;
+  }
+
   // Check visibility of tuples in the range [tid_start, tid_end), storing all
-  // visible tuple IDs in the provided selection vector
+  // visible tuple IDs in the provided selection vector. Most versions are not
+  // owned by any transaction, they are checked in batches.
+  static constexpr uint32_t kBatchSize = 4;
+  cid_t read_id = txn.GetReadId();
   uint32_t out_idx = 0;
-  for (uint32_t i = tid_start; i < tid_end; i++) {
+  uint32_t i = tid_start;
+  for (; i + kBatchSize <= tid_end; i += kBatchSize) {
+    uint32_t owned_mask;
+    uint32_t visible_mask = CheckBatchVisibility<kBatchSize>(
+        tile_group_header->GetTupleHeader(i), read_id, owned_mask);
+
+    // Owned versions are rare, check them one at a time
+    while (owned_mask != 0) {
+      uint32_t owned_idx = __builtin_ctz(owned_mask);
+      owned_mask &= owned_mask - 1;
+      auto visibility =
+          txn_manager.IsVisible(&txn, tile_group_header, i + owned_idx);
+      visible_mask &= ~(1u << owned_idx);
+      visible_mask |=
+          static_cast<uint32_t>(visibility == VisibilityType::OK) << owned_idx;
+    }
+
+    for (uint32_t batch_idx = 0; batch_idx < kBatchSize; batch_idx++) {
+      selection_vector[out_idx] = i + batch_idx;
+      out_idx += (visible_mask >> batch_idx) & 1;
+    }
+  }
+
+  for (; i < tid_end; i++) {
     // Perform the visibility check
     auto visibility = txn_manager.IsVisible(&txn, tile_group_header, i);
 
@@ -48,6 +160,11 @@ uint32_t TransactionRuntime::PerformVisibilityCheck(
 uint32_t TransactionRuntime::PerformVectorizedRead(
     concurrency::TransactionContext &txn, storage::TileGroup &tile_group,
     uint32_t *selection_vector, uint32_t end_idx, bool is_for_update) {
+  // A read-only transaction can read every visible tuple
+  if (txn.IsReadOnly()) {
+    return end_idx;
+  }
+
   // Get the transaction manager
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
@@ -139,7 +139,8 @@ void Updater::Update() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   // Either update in-place
   if (is_owner_ == true) {
-    txn_manager.PerformUpdate(txn, old_location_);
+    tile_group->UpdateZoneMap(old_location_.offset);
+    txn_manager.PerformUpdate(txn, old_location_, target_list_);
     // we do not need to add any item pointer to statement-level write set
     // here, because we do not generate any new version
     executor_context_->num_processed++;
@@ -147,8 +148,10 @@ void Updater::Update() {
   }
 
   // Or, update with a new version
-  ContainerTuple<storage::TileGroup> new_tuple(
-    table_->GetTileGroupById(new_location_.block).get(), new_location_.offset);
+  auto new_tile_group = table_->GetTileGroupById(new_location_.block).get();
+  new_tile_group->UpdateZoneMap(new_location_.offset);
+  ContainerTuple<storage::TileGroup> new_tuple(new_tile_group,
+                                               new_location_.offset);
   ItemPointer *indirection =
       tile_group_header->GetIndirection(old_location_.offset);
   auto result = table_->InstallVersion(&new_tuple, target_list_, txn,
@@ -158,7 +161,7 @@ void Updater::Update() {
                                        old_location_.offset);
     return;
   }
-  txn_manager.PerformUpdate(txn, old_location_, new_location_);
+  txn_manager.PerformUpdate(txn, old_location_, new_location_, target_list_);
   AddToStatementWriteSet(new_location_);
   executor_context_->num_processed++;
 }
@@ -174,6 +177,7 @@ void Updater::UpdatePK() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
   // Insert a new tuple
+  tile_group->UpdateZoneMap(new_location_.offset);
   ContainerTuple<storage::TileGroup> tuple(tile_group, new_location_.offset);
   ItemPointer *index_entry_ptr = nullptr;
   bool result = table_->InsertTuple(&tuple, new_location_, txn,
@@ -21,6 +21,8 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
+#include "logging/checkpoint_manager_factory.h"
+#include "logging/log_manager_factory.h"
 #include "settings/settings_manager.h"
 #include "threadpool/mono_queue_pool.h"
 #include "tuning/index_tuner.h"
@@ -51,8 +53,17 @@ void PelotonInit::Initialize() {
   // start parallel execution pool
   threadpool::MonoQueuePool::GetExecutionInstance().Startup();
 
+  // start the pool that reads evicted tile groups back in
+  threadpool::MonoQueuePool::GetPrefetchInstance().Startup();
+
   int parallelism = (CONNECTION_THREAD_COUNT + 3) / 4;
-  storage::DataTable::SetActiveTileGroupCount(parallelism);
+  // every inserting thread starts from its own active tile group.
+  int active_tile_group_count = settings::SettingsManager::GetInt(
+      settings::SettingId::active_tile_group_count);
+  if (active_tile_group_count == 0) {
+    active_tile_group_count = CONNECTION_THREAD_COUNT;
+  }
+  storage::DataTable::SetActiveTileGroupCount(active_tile_group_count);
   storage::DataTable::SetActiveIndirectionArrayCount(parallelism);
 
   // start epoch.
@@ -62,6 +73,34 @@ void PelotonInit::Initialize() {
   gc::GCManagerFactory::Configure(settings::SettingsManager::GetInt(settings::SettingId::gc_num_threads));
   gc::GCManagerFactory::GetInstance().StartGC();
 
+  // start logging.
+  if (settings::SettingsManager::GetBool(settings::SettingId::logging)) {
+    logging::LogManagerFactory::Configure(settings::SettingsManager::GetInt(
+        settings::SettingId::logging_thread_count));
+    auto &log_manager = logging::LogManagerFactory::GetInstance();
+    log_manager.SetDirectory(
+        settings::SettingsManager::GetString(settings::SettingId::log_directory));
+    log_manager.SetLoggingMode(
+        StringToLoggingModeType(settings::SettingsManager::GetString(
+            settings::SettingId::logging_mode)));
+    log_manager.StartLogging();
+  }
+
+  // start checkpointing.
+  if (settings::SettingsManager::GetBool(settings::SettingId::checkpointing)) {
+    logging::CheckpointManagerFactory::Configure(settings::SettingsManager::GetInt(
+        settings::SettingId::checkpointing_thread_count));
+    auto &checkpoint_manager = logging::CheckpointManagerFactory::GetInstance();
+    checkpoint_manager.SetDirectory(settings::SettingsManager::GetString(
+        settings::SettingId::checkpoint_directory));
+    checkpoint_manager.SetCheckpointInterval(settings::SettingsManager::GetInt(
+        settings::SettingId::checkpoint_interval));
+    checkpoint_manager.SetCheckpointFormat(
+        StringToCheckpointFormatType(settings::SettingsManager::GetString(
+            settings::SettingId::checkpoint_format)));
+    checkpoint_manager.StartCheckpointing();
+  }
+
   // start index tuner
   if (settings::SettingsManager::GetBool(settings::SettingId::index_tuner)) {
     // Set the default visibility flag for all indexes to false
@@ -108,6 +147,16 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down checkpointing.
+  if (settings::SettingsManager::GetBool(settings::SettingId::checkpointing)) {
+    logging::CheckpointManagerFactory::GetInstance().StopCheckpointing();
+  }
+
+  // shut down logging.
+  if (settings::SettingsManager::GetBool(settings::SettingId::logging)) {
+    logging::LogManagerFactory::GetInstance().StopLogging();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
@@ -117,6 +166,9 @@ void PelotonInit::Shutdown() {
   // shutdown execution thread pool
   threadpool::MonoQueuePool::GetExecutionInstance().Shutdown();
 
+  // shutdown prefetch thread pool
+  threadpool::MonoQueuePool::GetPrefetchInstance().Shutdown();
+
   // stop worker pool
   threadpool::MonoQueuePool::GetInstance().Shutdown();
 
@@ -2259,6 +2259,9 @@ std::string ProtocolTypeToString(ProtocolType type) {
     case ProtocolType::TIMESTAMP_ORDERING: {
       return "TIMESTAMP_ORDERING";
     }
+    case ProtocolType::OPTIMISTIC: {
+      return "OPTIMISTIC";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for ProtocolType value '%d'",
@@ -2274,6 +2277,8 @@ ProtocolType StringToProtocolType(const std::string &str) {
     return ProtocolType::INVALID;
   } else if (upper_str == "TIMESTAMP_ORDERING") {
     return ProtocolType::TIMESTAMP_ORDERING;
+  } else if (upper_str == "OPTIMISTIC") {
+    return ProtocolType::OPTIMISTIC;
   } else {
     throw ConversionException(StringUtil::Format(
         "No ProtocolType conversion from string '%s'", upper_str.c_str()));
@@ -2648,6 +2653,50 @@ std::ostream &operator<<(std::ostream &os, const LoggingType &type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// LoggingModeType - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string LoggingModeTypeToString(LoggingModeType type) {
+  switch (type) {
+    case LoggingModeType::INVALID: {
+      return "INVALID";
+    }
+    case LoggingModeType::TUPLE: {
+      return "TUPLE";
+    }
+    case LoggingModeType::COMMAND: {
+      return "COMMAND";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for LoggingModeType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+LoggingModeType StringToLoggingModeType(const std::string &str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return LoggingModeType::INVALID;
+  } else if (upper_str == "TUPLE") {
+    return LoggingModeType::TUPLE;
+  } else if (upper_str == "COMMAND") {
+    return LoggingModeType::COMMAND;
+  } else {
+    throw ConversionException(StringUtil::Format(
+        "No LoggingModeType conversion from string '%s'", upper_str.c_str()));
+  }
+  return LoggingModeType::INVALID;
+}
+
+std::ostream &operator<<(std::ostream &os, const LoggingModeType &type) {
+  os << LoggingModeTypeToString(type);
+  return os;
+}
+
 std::string LogRecordTypeToString(LogRecordType type) {
   switch (type) {
     case LogRecordType::INVALID: {
@@ -2674,6 +2723,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LogRecordType::EPOCH_END: {
       return "EPOCH_END";
     }
+    case LogRecordType::COMMAND: {
+      return "COMMAND";
+    }
     default: {
       throw ConversionException(StringUtil::Format(
           "No string conversion for LogRecordType value '%d'",
@@ -2701,6 +2753,8 @@ LogRecordType StringToLogRecordType(const std::string &str) {
     return LogRecordType::EPOCH_BEGIN;
   } else if (upper_str == "EPOCH_END") {
     return LogRecordType::EPOCH_END;
+  } else if (upper_str == "COMMAND") {
+    return LogRecordType::COMMAND;
   } else {
     throw ConversionException(StringUtil::Format(
         "No LogRecordType conversion from string '%s'", upper_str.c_str()));
@@ -2757,6 +2811,47 @@ std::ostream &operator<<(std::ostream &os, const CheckpointingType &type) {
   return os;
 }
 
+std::string CheckpointFormatTypeToString(CheckpointFormatType type) {
+  switch (type) {
+    case CheckpointFormatType::INVALID: {
+      return "INVALID";
+    }
+    case CheckpointFormatType::ROW: {
+      return "ROW";
+    }
+    case CheckpointFormatType::BINARY: {
+      return "BINARY";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for CheckpointFormatType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+CheckpointFormatType StringToCheckpointFormatType(const std::string &str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return CheckpointFormatType::INVALID;
+  } else if (upper_str == "ROW") {
+    return CheckpointFormatType::ROW;
+  } else if (upper_str == "BINARY") {
+    return CheckpointFormatType::BINARY;
+  } else {
+    throw ConversionException(StringUtil::Format(
+        "No CheckpointFormatType conversion from string '%s'",
+        upper_str.c_str()));
+  }
+  return CheckpointFormatType::INVALID;
+}
+
+std::ostream &operator<<(std::ostream &os, const CheckpointFormatType &type) {
+  os << CheckpointFormatTypeToString(type);
+  return os;
+}
+
 std::string LayoutTypeToString(LayoutType type) {
   switch (type) {
     case LayoutType::INVALID: {
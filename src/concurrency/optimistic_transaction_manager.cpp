@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include <cinttypes>
+
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_context.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance(
+    const ProtocolType protocol, const IsolationLevelType isolation,
+    const ConflictAvoidanceType conflict) {
+  static OptimisticTransactionManager txn_manager;
+
+  txn_manager.Init(protocol, isolation, conflict);
+
+  return txn_manager;
+}
+
+bool OptimisticTransactionManager::AcquireOwnership(
+    TransactionContext *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  // no reader has to be waited for, the readers validate at commit.
+  if (tile_group_header->SetAtomicTransactionId(
+          tuple_id, current_txn->GetTransactionId()) == true) {
+    return true;
+  }
+
+  // another transaction has locked the tuple since it was found ownable.
+  if (conflict_avoidance_ == ConflictAvoidanceType::WAIT &&
+      WaitForWriteLock(current_txn, tile_group_header, tuple_id)) {
+    return AcquireOwnership(current_txn, tile_group_header, tuple_id);
+  }
+  return false;
+}
+
+bool OptimisticTransactionManager::PerformRead(
+    TransactionContext *const current_txn, const ItemPointer &location,
+    storage::TileGroupHeader *tile_group_header, bool acquire_ownership) {
+  // read-only, snapshot and read committed transactions do not validate
+  // their reads.
+  if (current_txn->IsReadOnly() ||
+      (current_txn->GetIsolationLevel() != IsolationLevelType::SERIALIZABLE &&
+       current_txn->GetIsolationLevel() !=
+           IsolationLevelType::REPEATABLE_READS)) {
+    return TimestampOrderingTransactionManager::PerformRead(
+        current_txn, location, tile_group_header, acquire_ownership);
+  }
+
+  oid_t tuple_id = location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+
+  // the versions owned by this transaction are already in its read/write set.
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == true) {
+    return true;
+  }
+
+  if (acquire_ownership == true) {
+    if (IsOwnable(current_txn, tile_group_header, tuple_id) == false) {
+      // Cannot own
+      return false;
+    }
+    if (AcquireOwnership(current_txn, tile_group_header, tuple_id) == false) {
+      // Cannot acquire ownership
+      return false;
+    }
+
+    // Record RWType::READ_OWN
+    current_txn->RecordReadOwn(location);
+    return true;
+  }
+
+  // the version may be locked by a concurrent writer. it is read anyway, the
+  // validation fails if the writer still holds it at commit.
+  current_txn->RecordRead(location);
+  return true;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    TransactionContext *const current_txn) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto transaction_id = current_txn->GetTransactionId();
+
+  oid_t last_tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+
+  for (const auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.second != RWType::READ) {
+      continue;
+    }
+
+    oid_t tile_group_id = tuple_entry.first.block;
+    oid_t tuple_slot = tuple_entry.first.offset;
+
+    if (tile_group_id != last_tile_group_id) {
+      tile_group_header =
+          storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
+      last_tile_group_id = tile_group_id;
+    }
+
+    // a concurrent writer has locked the version.
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+    if (tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != transaction_id) {
+      LOG_TRACE("Validation failed: (%u, %u) is locked", tile_group_id,
+                tuple_slot);
+      return false;
+    }
+
+    // a newer version has been committed.
+    if (tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+      LOG_TRACE("Validation failed: (%u, %u) is overwritten", tile_group_id,
+                tuple_slot);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    TransactionContext *const current_txn) {
+  if (current_txn->IsReadOnly()) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  LOG_TRACE("Validating peloton txn : %" PRId64,
+            current_txn->GetTransactionId());
+
+  // the writes are locked, so the transaction is serialized at the commit id
+  // it takes now. the reads must still be the latest versions at that point.
+  cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
+      current_txn->GetThreadId(), TimestampType::COMMIT);
+  current_txn->SetCommitId(commit_id);
+
+  if (ValidateReadSet(current_txn) == false) {
+    return AbortTransaction(current_txn);
+  }
+
+  return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+}
+
+}  // namespace concurrency
+}  // namespace peloton
@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
+#include <chrono>
 #include <cinttypes>
+#include <thread>
 #include "storage/storage_manager.h"
 
 #include "catalog/catalog_defaults.h"
@@ -97,12 +99,60 @@ bool TimestampOrderingTransactionManager::IsWritten(
 }
 
 bool TimestampOrderingTransactionManager::IsOwnable(
-    UNUSED_ATTRIBUTE TransactionContext *const current_txn,
+    TransactionContext *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+  if (tuple_txn_id == INITIAL_TXN_ID) {
+    return tuple_end_cid == MAX_CID;
+  }
+
+  // the tuple is locked by another transaction.
+  if (conflict_avoidance_ == ConflictAvoidanceType::WAIT) {
+    return WaitForWriteLock(current_txn, tile_group_header, tuple_id);
+  }
+  return false;
+}
+
+bool TimestampOrderingTransactionManager::WaitForWriteLock(
+    TransactionContext *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  // spins before the waiting transaction starts yielding its core.
+  static const uint32_t spin_count = 64;
+
+  auto txn_id = current_txn->GetTransactionId();
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(settings::SettingsManager::GetInt(
+                      settings::SettingId::conflict_wait_timeout));
+
+  for (uint32_t attempt = 0;; attempt++) {
+    auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id == INITIAL_TXN_ID) {
+      // the holder has either aborted, or committed a newer version.
+      return tile_group_header->GetEndCommitId(tuple_id) == MAX_CID;
+    }
+
+    // wait-die: a transaction only waits for a younger one, and dies
+    // otherwise. the waits all go from older to younger transactions, so
+    // they can not form a cycle. the migration of a tile group keeps its
+    // versions until the copy replaces it, so a writer dies right away
+    // rather than wait for the timeout.
+    if (tuple_txn_id == INVALID_TXN_ID || tuple_txn_id == MAX_TXN_ID ||
+        tuple_txn_id <= txn_id) {
+      return false;
+    }
+
+    if (attempt < spin_count) {
+      _mm_pause();
+    } else if (std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    } else {
+      LOG_TRACE("Wait for the write lock on tuple %u timed out", tuple_id);
+      return false;
+    }
+  }
 }
 
 bool TimestampOrderingTransactionManager::AcquireOwnership(
@@ -131,6 +181,12 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
     if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
       latch.Unlock();
 
+      // another transaction has locked the tuple since it was found ownable.
+      // the wait happens outside of the latch, which the readers take.
+      if (conflict_avoidance_ == ConflictAvoidanceType::WAIT &&
+          WaitForWriteLock(current_txn, tile_group_header, tuple_id)) {
+        return AcquireOwnership(current_txn, tile_group_header, tuple_id);
+      }
       return false;
     } else {
       latch.Unlock();
@@ -347,7 +403,8 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto tile_group_header = storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header =
+      storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -372,7 +429,7 @@ void TimestampOrderingTransactionManager::PerformInsert(
 
 void TimestampOrderingTransactionManager::PerformUpdate(
     TransactionContext *const current_txn, const ItemPointer &location,
-    const ItemPointer &new_location) {
+    const ItemPointer &new_location, const TargetList *target_list) {
   PELOTON_ASSERT(!current_txn->IsReadOnly());
 
   ItemPointer old_location = location;
@@ -384,9 +441,9 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   auto storage_manager = storage::StorageManager::GetInstance();
   auto tile_group_header =
-      storage_manager->GetTileGroup(old_location.block)->GetHeader();
+      storage_manager->GetTileGroupPtr(old_location.block)->GetHeader();
   auto new_tile_group_header =
-      storage_manager->GetTileGroup(new_location.block)->GetHeader();
+      storage_manager->GetTileGroupPtr(new_location.block)->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
   // if we can perform update, then we must have already locked the older
@@ -444,19 +501,20 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   // Add the old tuple into the update set
   current_txn->RecordUpdate(old_location);
+  current_txn->RecordUpdatedColumns(old_location, target_list, true);
 }
 
 void TimestampOrderingTransactionManager::PerformUpdate(
-    TransactionContext *const current_txn UNUSED_ATTRIBUTE,
-    const ItemPointer &location) {
+    TransactionContext *const current_txn, const ItemPointer &location,
+    const TargetList *target_list) {
   PELOTON_ASSERT(!current_txn->IsReadOnly());
 
   oid_t tile_group_id = location.block;
-  UNUSED_ATTRIBUTE oid_t tuple_id = location.offset;
+  oid_t tuple_id = location.offset;
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  UNUSED_ATTRIBUTE auto tile_group_header =
-      storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header =
+      storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
 
   PELOTON_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
                  current_txn->GetTransactionId());
@@ -470,6 +528,12 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   // transaction
   // is updating a version that is installed by itself.
   // in this case, nothing needs to be performed.
+
+  // the columns modified by this update are logged with the older version.
+  ItemPointer old_location = tile_group_header->GetNextItemPointer(tuple_id);
+  if (old_location.IsNull() == false) {
+    current_txn->RecordUpdatedColumns(old_location, target_list, false);
+  }
 }
 
 void TimestampOrderingTransactionManager::PerformDelete(
@@ -487,9 +551,9 @@ void TimestampOrderingTransactionManager::PerformDelete(
   auto storage_manager = storage::StorageManager::GetInstance();
 
   auto tile_group_header =
-      storage_manager->GetTileGroup(old_location.block)->GetHeader();
+      storage_manager->GetTileGroupPtr(old_location.block)->GetHeader();
   auto new_tile_group_header =
-      storage_manager->GetTileGroup(new_location.block)->GetHeader();
+      storage_manager->GetTileGroupPtr(new_location.block)->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
 
@@ -560,7 +624,8 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto tile_group_header = storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header =
+      storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
 
   PELOTON_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
                  current_txn->GetTransactionId());
@@ -597,18 +662,22 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   //////////////////////////////////////////////////////////
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto &log_manager = logging::LogManager::GetInstance();
-
-  log_manager.StartLogging();
+  auto &log_manager = logging::LogManagerFactory::GetInstance();
 
   // generate transaction id.
   cid_t end_commit_id = current_txn->GetCommitId();
 
+  log_manager.LogBegin(end_commit_id);
+
+  // a transaction that only executed prepared statements is logged as the
+  // statements and their parameters rather than the modified tuples.
+  bool is_command_logged = log_manager.LogCommands(current_txn);
+
   auto &rw_set = current_txn->GetReadWriteSet();
   auto &rw_object_set = current_txn->GetCreateDropSet();
 
-  auto gc_set = current_txn->GetGCSetPtr();
-  auto gc_object_set = current_txn->GetGCObjectSetPtr();
+  auto &gc_set = current_txn->GetGCSet();
+  auto &gc_object_set = current_txn->GetGCObjectSet();
 
   for (auto &obj : rw_object_set) {
     auto ddl_type = std::get<3>(obj);
@@ -616,7 +685,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
     oid_t database_oid = std::get<0>(obj);
     oid_t table_oid = std::get<1>(obj);
     oid_t index_oid = std::get<2>(obj);
-    gc_object_set->emplace_back(database_oid, table_oid, index_oid);
+    gc_object_set.emplace_back(database_oid, table_oid, index_oid);
   }
 
   // install everything.
@@ -635,7 +704,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
     if (tile_group_id != last_tile_group_id) {
       tile_group_header =
-          storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+          storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
       last_tile_group_id = tile_group_id;
     }
 
@@ -655,7 +724,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       auto cid = tile_group_header->GetEndCommitId(tuple_slot);
       PELOTON_ASSERT(cid > end_commit_id);
       auto new_tile_group_header =
-          storage_manager->GetTileGroup(new_version.block)->GetHeader();
+          storage_manager->GetTileGroupPtr(new_version.block)->GetHeader();
       new_tile_group_header->SetBeginCommitId(new_version.offset,
                                               end_commit_id);
       new_tile_group_header->SetEndCommitId(new_version.offset, cid);
@@ -673,10 +742,14 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
       // add old version into gc set.
       // may need to delete versions from secondary indexes.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
+      gc_set[ItemPointer(tile_group_id, tuple_slot)] =
           GCVersionType::COMMIT_UPDATE;
 
-      log_manager.LogUpdate(new_version);
+      if (is_command_logged == false) {
+        log_manager.LogUpdate(ItemPointer(tile_group_id, tuple_slot),
+                              new_version,
+                              current_txn->GetUpdatedColumns(item_ptr));
+      }
 
     } else if (tuple_entry.second == RWType::DELETE) {
       ItemPointer new_version =
@@ -685,7 +758,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       auto cid = tile_group_header->GetEndCommitId(tuple_slot);
       PELOTON_ASSERT(cid > end_commit_id);
       auto new_tile_group_header =
-          storage_manager->GetTileGroup(new_version.block)->GetHeader();
+          storage_manager->GetTileGroupPtr(new_version.block)->GetHeader();
       new_tile_group_header->SetBeginCommitId(new_version.offset,
                                               end_commit_id);
       new_tile_group_header->SetEndCommitId(new_version.offset, cid);
@@ -706,10 +779,12 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       // we require the GC to delete tuple from index only once.
       // recycle old version, delete from index
       // the gc should be responsible for recycling the newer empty version.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
+      gc_set[ItemPointer(tile_group_id, tuple_slot)] =
           GCVersionType::COMMIT_DELETE;
 
-      log_manager.LogDelete(ItemPointer(tile_group_id, tuple_slot));
+      if (is_command_logged == false) {
+        log_manager.LogDelete(ItemPointer(tile_group_id, tuple_slot));
+      }
 
     } else if (tuple_entry.second == RWType::INSERT) {
       PELOTON_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
@@ -725,7 +800,9 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
       // nothing to be added to gc set.
 
-      log_manager.LogInsert(ItemPointer(tile_group_id, tuple_slot));
+      if (is_command_logged == false) {
+        log_manager.LogInsert(ItemPointer(tile_group_id, tuple_slot));
+      }
 
     } else if (tuple_entry.second == RWType::INS_DEL) {
       PELOTON_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
@@ -741,7 +818,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
       // add to gc set.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
+      gc_set[ItemPointer(tile_group_id, tuple_slot)] =
           GCVersionType::COMMIT_INS_DEL;
 
       // no log is needed for this case
@@ -750,10 +827,17 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
   ResultType result = current_txn->GetResult();
 
-  log_manager.LogEnd();
+  eid_t log_eid = log_manager.LogEnd();
+  bool is_synchronous = current_txn->IsSynchronousCommit();
 
   EndTransaction(current_txn);
 
+  // the transaction has been installed, but the commit is only acknowledged
+  // once its epoch is durable.
+  if (is_synchronous == true && log_eid != INVALID_EID) {
+    log_manager.WaitForPersistence(log_eid);
+  }
+
   return result;
 }
 
@@ -768,8 +852,8 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   auto &rw_set = current_txn->GetReadWriteSet();
   auto &rw_object_set = current_txn->GetCreateDropSet();
 
-  auto gc_set = current_txn->GetGCSetPtr();
-  auto gc_object_set = current_txn->GetGCObjectSetPtr();
+  auto &gc_set = current_txn->GetGCSet();
+  auto &gc_object_set = current_txn->GetGCObjectSet();
 
   for (int i = rw_object_set.size() - 1; i >= 0; i--) {
     auto &obj = rw_object_set[i];
@@ -778,7 +862,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
     oid_t database_oid = std::get<0>(obj);
     oid_t table_oid = std::get<1>(obj);
     oid_t index_oid = std::get<2>(obj);
-    gc_object_set->emplace_back(database_oid, table_oid, index_oid);
+    gc_object_set.emplace_back(database_oid, table_oid, index_oid);
   }
 
   // Iterate through each item pointer in the read write set
@@ -793,7 +877,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
     if (tile_group_id != last_tile_group_id) {
       tile_group_header =
-          storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+          storage_manager->GetTileGroupPtr(tile_group_id)->GetHeader();
       last_tile_group_id = tile_group_id;
     }
 
@@ -806,7 +890,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       ItemPointer new_version =
           tile_group_header->GetPrevItemPointer(tuple_slot);
       auto new_tile_group_header =
-          storage_manager->GetTileGroup(new_version.block)->GetHeader();
+          storage_manager->GetTileGroupPtr(new_version.block)->GetHeader();
       // these two fields can be set at any time.
       new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
       new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
@@ -848,14 +932,14 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       // add the version to gc set.
       // this version has already been unlinked from the version chain.
       // however, the gc should further unlink it from indexes.
-      gc_set->operator[](new_version.block)[new_version.offset] =
+      gc_set[new_version] =
           GCVersionType::ABORT_UPDATE;
 
     } else if (tuple_entry.second == RWType::DELETE) {
       ItemPointer new_version =
           tile_group_header->GetPrevItemPointer(tuple_slot);
       auto new_tile_group_header =
-          storage_manager->GetTileGroup(new_version.block)->GetHeader();
+          storage_manager->GetTileGroupPtr(new_version.block)->GetHeader();
 
       new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
       new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
@@ -894,7 +978,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
       // add the version to gc set.
-      gc_set->operator[](new_version.block)[new_version.offset] =
+      gc_set[new_version] =
           GCVersionType::ABORT_DELETE;
 
     } else if (tuple_entry.second == RWType::INSERT) {
@@ -908,7 +992,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
       // add the version to gc set.
       // delete from index.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
+      gc_set[ItemPointer(tile_group_id, tuple_slot)] =
           GCVersionType::ABORT_INSERT;
 
     } else if (tuple_entry.second == RWType::INS_DEL) {
@@ -921,7 +1005,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
       // add to gc set.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
+      gc_set[ItemPointer(tile_group_id, tuple_slot)] =
           GCVersionType::ABORT_INS_DEL;
     }
   }
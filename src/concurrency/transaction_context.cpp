@@ -12,11 +12,14 @@
 
 #include "concurrency/transaction_context.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/platform.h"
+#include "common/synchronization/spin_latch.h"
+#include "planner/project_info.h"
 #include "trigger/trigger.h"
 
 #include <chrono>
@@ -48,6 +51,60 @@ namespace concurrency {
  *    i : insert
  */
 
+// the most ended contexts a thread keeps for its next transactions
+static const size_t kMaxSpareTransactionContexts = 16;
+
+// a set that grew larger than this gives its heap slots back when the context
+// is recycled, so a bulk transaction does not pin its sets
+static const size_t kMaxRecycledSetCapacity = 16384;
+
+/**
+ * @brief      The ended contexts of the transactions of a worker thread, that
+ *             are reused by its next transactions. Contexts are taken by the
+ *             thread only, but may be given back by any thread, e.g. by the
+ *             GC threads.
+ */
+class TransactionContextPool {
+ public:
+  TransactionContextPool() {
+    spare_contexts_.reserve(kMaxSpareTransactionContexts);
+  }
+
+  ~TransactionContextPool() {
+    for (auto txn : spare_contexts_) {
+      delete txn;
+    }
+  }
+
+  // An ended context, or nullptr if there is none
+  TransactionContext *Take() {
+    TransactionContext *txn = nullptr;
+    latch_.Lock();
+    if (spare_contexts_.empty() == false) {
+      txn = spare_contexts_.back();
+      spare_contexts_.pop_back();
+    }
+    latch_.Unlock();
+    return txn;
+  }
+
+  // Keep an ended context, returns false if the pool is full
+  bool Put(TransactionContext *txn) {
+    bool kept = false;
+    latch_.Lock();
+    if (spare_contexts_.size() < kMaxSpareTransactionContexts) {
+      spare_contexts_.push_back(txn);
+      kept = true;
+    }
+    latch_.Unlock();
+    return kept;
+  }
+
+ private:
+  std::vector<TransactionContext *> spare_contexts_;
+  common::synchronization::SpinLatch latch_;
+};
+
 TransactionContext::TransactionContext(const size_t thread_id,
                                        const IsolationLevelType isolation,
                                        const cid_t &read_id) {
@@ -78,12 +135,69 @@ void TransactionContext::Init(const size_t thread_id,
 
   is_written_ = false;
 
+  updated_columns_.clear();
+
+  commands_.clear();
+  is_command_loggable_ = true;
+
   isolation_level_ = isolation;
 
-  gc_set_ = std::make_shared<GCSet>();
-  gc_object_set_ = std::make_shared<GCObjectSet>();
+  on_commit_triggers_.reset();
+}
+
+TransactionContext *TransactionContext::Acquire(
+    const size_t thread_id, const IsolationLevelType isolation,
+    const cid_t &read_id, const cid_t &commit_id) {
+  // contexts that are still in use keep the pool of their thread alive
+  static thread_local std::shared_ptr<TransactionContextPool> local_pool =
+      std::make_shared<TransactionContextPool>();
+
+  TransactionContext *txn = local_pool->Take();
+  if (txn == nullptr) {
+    txn = new TransactionContext(thread_id, isolation, read_id, commit_id);
+  } else {
+    txn->Init(thread_id, isolation, read_id, commit_id);
+  }
+  txn->pool_ = local_pool;
+  return txn;
+}
 
+void TransactionContext::Release(TransactionContext *txn) {
+  // a pooled context does not hold on to its pool, the pool may go away
+  // with its thread. it deletes the context then.
+  std::shared_ptr<TransactionContextPool> pool = std::move(txn->pool_);
+  if (pool == nullptr) {
+    delete txn;
+    return;
+  }
+
+  txn->Recycle();
+  if (pool->Put(txn) == false) {
+    delete txn;
+  }
+}
+
+void TransactionContext::Recycle() {
+  if (rw_set_.GetCapacity() > kMaxRecycledSetCapacity) {
+    rw_set_.Reset();
+  } else {
+    rw_set_.Clear();
+  }
+  if (gc_set_.GetCapacity() > kMaxRecycledSetCapacity) {
+    gc_set_.Reset();
+  } else {
+    gc_set_.Clear();
+  }
+  gc_object_set_.clear();
+  rw_object_set_.clear();
+  updated_columns_.clear();
+  commands_.clear();
+  query_strings_.clear();
+  catalog_cache.Clear();
   on_commit_triggers_.reset();
+  result_ = ResultType::SUCCESS;
+  read_only_ = false;
+  synchronous_commit_ = false;
 }
 
 RWType TransactionContext::GetRWType(const ItemPointer &location) {
@@ -94,6 +208,13 @@ RWType TransactionContext::GetRWType(const ItemPointer &location) {
   return RWType::INVALID;
 }
 
+void TransactionContext::RecordRead(const ItemPointer &location) {
+  auto &rw_type = rw_set_[location];
+  if (rw_type == RWType::INVALID) {
+    rw_type = RWType::READ;
+  }
+}
+
 void TransactionContext::RecordReadOwn(const ItemPointer &location) {
   PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end() ||
                  (rw_set_[location] != RWType::DELETE &&
@@ -110,6 +231,51 @@ void TransactionContext::RecordUpdate(const ItemPointer &location) {
   is_written_ = true;
 }
 
+void TransactionContext::RecordUpdatedColumns(const ItemPointer &location,
+                                              const TargetList *target_list,
+                                              const bool is_first) {
+  auto updated_columns_it = updated_columns_.find(location);
+
+  if (target_list == nullptr) {
+    // all the columns are modified.
+    if (updated_columns_it != updated_columns_.end()) {
+      updated_columns_.erase(updated_columns_it);
+    }
+    return;
+  }
+
+  // a later update of a version whose columns are all modified.
+  if (is_first == false && updated_columns_it == updated_columns_.end()) {
+    return;
+  }
+
+  auto &column_ids = updated_columns_[location];
+  for (auto &target : *target_list) {
+    column_ids.push_back(target.first);
+  }
+  std::sort(column_ids.begin(), column_ids.end());
+  column_ids.erase(std::unique(column_ids.begin(), column_ids.end()),
+                   column_ids.end());
+}
+
+const std::vector<oid_t> *TransactionContext::GetUpdatedColumns(
+    const ItemPointer &location) const {
+  auto updated_columns_it = updated_columns_.find(location);
+  if (updated_columns_it == updated_columns_.end()) {
+    return nullptr;
+  }
+  return &(updated_columns_it->second);
+}
+
+void TransactionContext::RecordCommand(
+    const std::shared_ptr<Statement> &statement,
+    const std::string &database_name, const std::vector<type::Value> &params) {
+  if (is_command_loggable_ == false) {
+    return;
+  }
+  commands_.push_back(TransactionCommand{statement, database_name, params});
+}
+
 void TransactionContext::RecordInsert(const ItemPointer &location) {
   PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end());
   rw_set_[location] = RWType::INSERT;
@@ -35,19 +35,23 @@ TransactionContext *TransactionManager::BeginTransaction(
     const size_t thread_id, const IsolationLevelType type, bool read_only) {
   TransactionContext *txn = nullptr;
 
-  if (type == IsolationLevelType::SNAPSHOT) {
+  // A read-only transaction reads a snapshot whatever its isolation level.
+  // Writers can not commit into the snapshot anymore, so its reads take no
+  // latches and leave no last reader commit id behind.
+  if (type == IsolationLevelType::SNAPSHOT || read_only) {
     // transaction processing with decentralized epoch manager
     // the DBMS must acquire
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::SNAPSHOT_READ);
 
-    if (protocol_ == ProtocolType::TIMESTAMP_ORDERING) {
+    if (protocol_ == ProtocolType::TIMESTAMP_ORDERING ||
+        protocol_ == ProtocolType::OPTIMISTIC) {
       cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
           thread_id, TimestampType::COMMIT);
 
-      txn = new TransactionContext(thread_id, type, read_id, commit_id);
+      txn = TransactionContext::Acquire(thread_id, type, read_id, commit_id);
     } else {
-      txn = new TransactionContext(thread_id, type, read_id);
+      txn = TransactionContext::Acquire(thread_id, type, read_id);
     }
 
   } else {
@@ -58,7 +62,7 @@ TransactionContext *TransactionManager::BeginTransaction(
     // transaction processing with decentralized epoch manager
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::READ);
-    txn = new TransactionContext(thread_id, type, read_id);
+    txn = TransactionContext::Acquire(thread_id, type, read_id);
   }
 
   if (read_only) {
@@ -89,7 +93,7 @@ void TransactionManager::EndTransaction(TransactionContext *current_txn) {
   if (gc::GCManagerFactory::GetGCType() == GarbageCollectionType::ON) {
     gc::GCManagerFactory::GetInstance().RecycleTransaction(current_txn);
   } else {
-    delete current_txn;
+    TransactionContext::Release(current_txn);
   }
 
   current_txn = nullptr;
@@ -102,8 +106,9 @@ bool TransactionManager::IsOccupied(TransactionContext *const current_txn,
                                     const void *position_ptr) {
   ItemPointer &position = *((ItemPointer *)position_ptr);
 
-  auto tile_group_header =
-      storage::StorageManager::GetInstance()->GetTileGroup(position.block)->GetHeader();
+  auto tile_group_header = storage::StorageManager::GetInstance()
+                               ->GetTileGroupPtr(position.block)
+                               ->GetHeader();
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
@@ -291,7 +296,7 @@ void TransactionManager::RecordTransactionStats(
     // and initilaize the iterator
     const auto &tile_group_id = tuple_entry.first.block;
     database_id = storage::StorageManager::GetInstance()
-                      ->GetTileGroup(tile_group_id)
+                      ->GetTileGroupPtr(tile_group_id)
                       ->GetDatabaseId();
     if (database_id != CATALOG_DATABASE_OID) {
       break;
@@ -216,8 +216,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   // for every tuple that is found in the index.
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
-    auto tile_group = storage_manager->GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     size_t chain_length = 0;
 
 #ifdef LOG_TRACE_ENABLED
@@ -247,7 +247,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
           LOG_TRACE("perform predicate evaluate");
-          ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+          ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                    tuple_location.offset);
           eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
@@ -293,8 +293,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
           auto storage_manager = storage::StorageManager::GetInstance();
-          tile_group = storage_manager->GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -319,8 +319,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
         // search for next version.
         auto storage_manager = storage::StorageManager::GetInstance();
-        tile_group = storage_manager->GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
         continue;
       }
     }
@@ -452,7 +452,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // we got for each tuple and check whether its the same to avoid having
   // to go back to the catalog each time.
   oid_t last_block = INVALID_OID;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  storage::TileGroup *tile_group = nullptr;
   storage::TileGroupHeader *tile_group_header = nullptr;
 
 #ifdef LOG_TRACE_ENABLED
@@ -463,8 +463,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
-      tile_group = storage_manager->GetTileGroup(tuple_location.block);
-      tile_group_header = tile_group.get()->GetHeader();
+      tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
     else
@@ -498,7 +498,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
         // Further check if the version has the secondary key
         ContainerTuple<storage::TileGroup> candidate_tuple(
-            tile_group.get(), tuple_location.offset);
+            tile_group, tuple_location.offset);
 
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
@@ -564,8 +564,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = storage_manager->GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -593,8 +593,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = storage_manager->GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
@@ -690,8 +690,8 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
   LOG_TRACE("Examining key conditions for the returned tuple.");
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto tile_group = storage_manager->GetTileGroup(tuple_location.block);
-  ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+  auto tile_group = storage_manager->GetTileGroupPtr(tuple_location.block);
+  ContainerTuple<storage::TileGroup> tuple(tile_group,
                                            tuple_location.offset);
 
   // This is the end of loop
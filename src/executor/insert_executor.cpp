@@ -12,6 +12,8 @@
 
 #include "executor/insert_executor.h"
 
+#include <algorithm>
+
 #include "catalog/manager.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -20,6 +22,7 @@
 #include "common/container_tuple.h"
 #include "planner/insert_plan.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "storage/tuple_iterator.h"
 #include "trigger/trigger.h"
 #include "storage/tuple.h"
@@ -46,6 +49,8 @@ bool InsertExecutor::DInit() {
   PELOTON_ASSERT(executor_context_);
 
   done_ = false;
+  bulk_tile_group_ = nullptr;
+  bulk_tuple_start_ = 0;
   return true;
 }
 
@@ -106,6 +111,27 @@ bool InsertExecutor::DExecute() {
     std::unique_ptr<storage::Tuple> tuple(
         new storage::Tuple(target_table_schema, true));
 
+    // The tuples are bulk loaded into tile groups of their own, which are
+    // filled across the logical tiles of the child, and are inserted into
+    // the indexes a logical tile at a time.
+    auto flush_tile_group = [&]() {
+      if (bulk_tile_group_ == nullptr) return true;
+      oid_t bulk_tuple_end =
+          std::min(bulk_tile_group_->GetNextTupleSlot(),
+                   bulk_tile_group_->GetAllocatedTupleCount());
+      // it is possible that some concurrent transactions have inserted the
+      // same tuple. in this case, abort the transaction.
+      if (!target_table->BulkInsertTuples(bulk_tile_group_, bulk_tuple_start_,
+                                          bulk_tuple_end, current_txn)) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 peloton::ResultType::FAILURE);
+        return false;
+      }
+      executor_context_->num_processed += bulk_tuple_end - bulk_tuple_start_;
+      bulk_tuple_start_ = bulk_tuple_end;
+      return true;
+    };
+
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
       ContainerTuple<LogicalTile> cur_tuple(logical_tile.get(), tuple_id);
@@ -116,25 +142,21 @@ bool InsertExecutor::DExecute() {
         tuple->SetValue(column_itr, val, executor_pool);
       }
 
-      // insert tuple into the table.
-      ItemPointer *index_entry_ptr = nullptr;
-      peloton::ItemPointer location =
-          target_table->InsertTuple(tuple.get(), current_txn, &index_entry_ptr);
-
-      // it is possible that some concurrent transactions have inserted the same
-      // tuple.
-      // in this case, abort the transaction.
-      if (location.block == INVALID_OID) {
-        transaction_manager.SetTransactionResult(current_txn,
-                                                 peloton::ResultType::FAILURE);
-        return false;
+      // copy tuple into the tile group, and start a new one when it is full
+      oid_t bulk_tuple_id = INVALID_OID;
+      if (bulk_tile_group_ != nullptr) {
+        bulk_tuple_id = bulk_tile_group_->InsertTuple(tuple.get());
+      }
+      if (bulk_tuple_id == INVALID_OID) {
+        if (!flush_tile_group()) return false;
+        bulk_tile_group_ = target_table->AddBulkLoadTileGroup();
+        bulk_tuple_start_ = 0;
+        bulk_tile_group_->InsertTuple(tuple.get());
       }
-
-      transaction_manager.PerformInsert(current_txn, location, index_entry_ptr);
-
-      executor_context_->num_processed += 1;  // insert one
     }
 
+    if (!flush_tile_group()) return false;
+
     // execute after-insert-statement triggers and
     // record on-commit-insert-statement triggers into current transaction
     if (trigger_list != nullptr) {
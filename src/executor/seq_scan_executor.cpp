@@ -154,18 +154,33 @@ bool SeqScanExecutor::DExecute() {
     while (current_tile_group_offset_ < table_tile_group_count_) {
       auto tile_group =
           target_table_->GetTileGroup(current_tile_group_offset_++);
+      for (oid_t prefetch_itr = 0;
+           prefetch_itr < EVICTED_TILE_GROUP_PREFETCH_COUNT; prefetch_itr++) {
+        target_table_->PrefetchTileGroup(current_tile_group_offset_ +
+                                         prefetch_itr);
+      }
+      // the tile group has been dropped after compaction
+      if (tile_group == nullptr) {
+        continue;
+      }
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      // Every tuple of an all-visible tile group is visible
+      bool all_visible =
+          tile_group_header->IsAllVisible(current_txn->GetReadId());
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
-        auto visibility = transaction_manager.IsVisible(
-            current_txn, tile_group_header, tuple_id);
+        auto visibility =
+            all_visible ? VisibilityType::OK
+                        : transaction_manager.IsVisible(
+                              current_txn, tile_group_header, tuple_id);
 
         // check transaction visibility
         if (visibility == VisibilityType::OK) {
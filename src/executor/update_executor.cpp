@@ -171,6 +171,11 @@ bool UpdateExecutor::DExecute() {
   auto target_table_schema = target_table_->GetSchema();
   auto column_count = target_table_schema->GetColumnCount();
 
+  // the new versions of a table with delta versions only hold the updated
+  // columns, and read the others from the versions they replace
+  bool delta_versions = target_table_->UsesDeltaVersions() &&
+                        project_info_->IsIdentityDirectMap();
+
   trigger::TriggerList *trigger_list = target_table_->GetTriggerList();
   if (trigger_list != nullptr) {
     LOG_TRACE("size of trigger list in target table: %d",
@@ -266,10 +271,38 @@ bool UpdateExecutor::DExecute() {
         ContainerTuple<storage::TileGroup> old_tuple(tile_group,
                                                      physical_tuple_id);
         // Execute the projections
-        project_info_->Evaluate(&old_tuple, &old_tuple, nullptr,
-                                executor_context_);
+        auto delta_record =
+            tile_group_header->HasDeltaRecords()
+                ? tile_group_header->GetDeltaRecord(physical_tuple_id)
+                : nullptr;
+        if (delta_record != nullptr && delta_versions == true) {
+          // the targets may read the columns that the version still inherits
+          // (SET a = a + 1), so they are all evaluated before any column is
+          // stored into the slot
+          auto &target_list = project_info_->GetTargetList();
+          std::vector<type::Value> values;
+          values.reserve(target_list.size());
+          for (auto &target : target_list) {
+            values.push_back(target.second.expr->Evaluate(
+                &old_tuple, &old_tuple, executor_context_));
+          }
+          for (size_t target_itr = 0; target_itr < target_list.size();
+               target_itr++) {
+            delta_record->SetStored(target_list[target_itr].first);
+            old_tuple.SetValue(target_list[target_itr].first,
+                               values[target_itr]);
+          }
+        } else {
+          project_info_->Evaluate(&old_tuple, &old_tuple, nullptr,
+                                  executor_context_);
+          // every column is written to the slot
+          if (delta_record != nullptr) {
+            tile_group_header->FoldDeltaRecord(physical_tuple_id);
+          }
+        }
 
-        transaction_manager.PerformUpdate(current_txn, old_location);
+        transaction_manager.PerformUpdate(current_txn, old_location,
+                                          &project_info_->GetTargetList());
         // we do not need to add any item pointer to statement-level write set
         // here, because we do not generate any new version
       }
@@ -332,8 +365,20 @@ bool UpdateExecutor::DExecute() {
           // perform projection from old version to new version.
           // this triggers in-place update, and we do not need to allocate
           // another version.
-          project_info_->Evaluate(&new_tuple, &old_tuple, nullptr,
-                                  executor_context_);
+          if (delta_versions == true) {
+            std::unique_ptr<storage::DeltaRecord> delta_record(
+                new storage::DeltaRecord(old_location, column_count));
+            for (auto &target : project_info_->GetTargetList()) {
+              delta_record->SetStored(target.first);
+            }
+            new_tile_group->GetHeader()->SetDeltaRecord(
+                new_location.offset, delta_record.release());
+            project_info_->EvaluateTargets(&new_tuple, &old_tuple, nullptr,
+                                           executor_context_);
+          } else {
+            project_info_->Evaluate(&new_tuple, &old_tuple, nullptr,
+                                    executor_context_);
+          }
 
           // get indirection.
           ItemPointer *indirection =
@@ -352,6 +397,8 @@ bool UpdateExecutor::DExecute() {
           // lock.
           if (ret == false) {
             LOG_TRACE("Fail to insert new tuple. Set txn failure.");
+            new_tile_group->GetHeader()->ReleaseDeltaRecord(
+                new_location.offset);
             if (is_owner == false) {
               // If the ownership is acquire inside this update executor, we
               // release it here
@@ -368,9 +415,15 @@ bool UpdateExecutor::DExecute() {
           LOG_TRACE("perform update new location: %u, %u", new_location.block,
                     new_location.offset);
           transaction_manager.PerformUpdate(current_txn, old_location,
-                                            new_location);
+                                            new_location,
+                                            &project_info_->GetTargetList());
           statement_write_set_.insert(new_location);
 
+          // the zone map must also cover the columns that are inherited
+          if (delta_versions == true) {
+            new_tile_group->UpdateZoneMap(new_location.offset);
+          }
+
           // TODO: Why don't we also do this in the if branch above?
           executor_context_->num_processed += 1;  // updated one
 
@@ -47,6 +47,14 @@ void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tile_group,
         // Not of varlen type, or is inlined, skip
         continue;
       }
+      if (schema->GetDictionary(tile_col_itr) != nullptr) {
+        // The strings of a dictionary-encoded column are never freed
+        continue;
+      }
+      if (tile->IsInherited(tuple_id, tile_col_itr) == true) {
+        // The slot of an aborted delta version does not own the column
+        continue;
+      }
       // Get the raw varlen pointer
       tuple_location = tile->GetTupleLocation(tuple_id);
       field_location = tuple_location + schema->GetOffset(tile_col_itr);
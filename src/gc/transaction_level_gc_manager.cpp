@@ -19,6 +19,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "index/index.h"
 #include "settings/settings_manager.h"
+#include "storage/data_table.h"
 #include "storage/database.h"
 #include "storage/storage_manager.h"
 #include "storage/tile_group.h"
@@ -45,6 +46,7 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
 
   // Reclaim the varlen pool
   CheckAndReclaimVarlenColumns(tile_group, location.offset);
+  tile_group_header->ReleaseDeltaRecord(location.offset);
 
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
@@ -67,6 +69,12 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
     int reclaimed_count = Reclaim(thread_id, expired_eid);
     int unlinked_count = Unlink(thread_id, expired_eid);
 
+    // A single thread marks the tile groups all-visible and compacts them
+    if (thread_id == 0) {
+      SetAllVisible(expired_eid);
+      CompactTileGroups(expired_eid);
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -93,6 +101,10 @@ void TransactionLevelGCManager::RecycleTransaction(
   if (!txn->IsReadOnly() && \
       txn->GetResult() != ResultType::SUCCESS && txn->IsGCSetEmpty() != true) {
     txn->SetEpochId(epoch_manager.GetNextEpochId());
+  } else if (!txn->IsReadOnly() && (txn->GetCommitId() >> 32) > txn->GetEpochId()) {
+    // the transaction took its commit id after it began, so the versions it
+    // replaced can still be read until the epoch of its commit expires.
+    txn->SetEpochId(txn->GetCommitId() >> 32);
   }
 
   // Add the transaction context to the lock-free queue
@@ -147,7 +159,7 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
     // any garbage collection
     if (txn_ctx->IsReadOnly() || \
         txn_ctx->IsGCSetEmpty()) {
-      delete txn_ctx;
+      concurrency::TransactionContext::Release(txn_ctx);
       continue;
     }
 
@@ -210,17 +222,121 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
   return gc_counter;
 }
 
+// Mark the tile groups whose versions all committed before the expired epoch
+// as all-visible
+int TransactionLevelGCManager::SetAllVisible(const eid_t &expired_eid) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+  oid_t current_tile_group_id = storage_manager->GetCurrentTileGroupId();
+
+  // The epoch of a commit id is in its upper half
+  cid_t settled_cid = static_cast<cid_t>(expired_eid) << 32;
+
+  int all_visible_count = 0;
+  for (int sweep_itr = 0; sweep_itr < MAX_ALL_VISIBLE_SWEEP_LENGTH;
+       sweep_itr++) {
+    if (all_visible_cursor_ > current_tile_group_id) {
+      all_visible_cursor_ = START_OID;
+      break;
+    }
+
+    auto tile_group = storage_manager->GetTileGroup(all_visible_cursor_++);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    all_visible_count += tile_group->GetHeader()->SetAllVisible(settled_cid);
+  }
+  return all_visible_count;
+}
+
+// Only the thread that sets the tile groups all-visible compacts them
+int TransactionLevelGCManager::CompactTileGroups(const eid_t &expired_eid) {
+  double live_tuple_ratio = settings::SettingsManager::GetDouble(
+      settings::SettingId::tile_group_compaction_threshold);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  int compacted_count = 0;
+
+  // Drop the compacted tile groups. A transaction that got one of their slots
+  // before they were made immutable may still insert into them until their
+  // epoch expires.
+  auto compacted_itr = compacted_tile_groups_.begin();
+  while (compacted_itr != compacted_tile_groups_.end()) {
+    auto tile_group = storage_manager->GetTileGroup(compacted_itr->first);
+    if (tile_group == nullptr) {
+      compacted_itr = compacted_tile_groups_.erase(compacted_itr);
+      continue;
+    }
+    if (compacted_itr->second > expired_eid) {
+      ++compacted_itr;
+      continue;
+    }
+
+    storage::DataTable *table =
+        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+    PELOTON_ASSERT(table != nullptr);
+    if (table->DropCompactedTileGroup(compacted_itr->first)) {
+      compacted_itr = compacted_tile_groups_.erase(compacted_itr);
+      compacted_count++;
+      continue;
+    }
+
+    // Move the tuples that could not be moved before
+    table->CompactTileGroup(compacted_itr->first, live_tuple_ratio);
+    ++compacted_itr;
+  }
+
+  if (live_tuple_ratio <= 0) {
+    return compacted_count;
+  }
+
+  oid_t current_tile_group_id = storage_manager->GetCurrentTileGroupId();
+  for (int sweep_itr = 0; sweep_itr < MAX_COMPACTION_SWEEP_LENGTH;
+       sweep_itr++) {
+    if (compaction_cursor_ > current_tile_group_id) {
+      compaction_cursor_ = START_OID;
+      break;
+    }
+
+    oid_t tile_group_id = compaction_cursor_++;
+    auto tile_group = storage_manager->GetTileGroup(tile_group_id);
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->GetImmutability()) {
+      continue;
+    }
+
+    // Only the tables whose slots are recycled are compacted
+    storage::DataTable *table =
+        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+    if (table == nullptr ||
+        recycle_queue_map_.find(table->GetOid()) == recycle_queue_map_.end()) {
+      continue;
+    }
+
+    table->CompactTileGroup(tile_group_id, live_tuple_ratio);
+    if (tile_group->GetHeader()->GetImmutability()) {
+      compacted_tile_groups_[tile_group_id] =
+          epoch_manager.GetCurrentEpochId();
+    }
+  }
+  return compacted_count;
+}
+
 // Multiple GC thread share the same recycle map
 void TransactionLevelGCManager::AddToRecycleMap(
     concurrency::TransactionContext *txn_ctx) {
-  for (auto &entry : *(txn_ctx->GetGCSetPtr().get())) {
+  for (auto &entry : txn_ctx->GetGCSet()) {
+    // as this transaction has been committed, we should reclaim older
+    // versions.
+    ItemPointer location = entry.first;
     auto storage_manager = storage::StorageManager::GetInstance();
-    auto tile_group = storage_manager->GetTileGroup(entry.first);
+    auto tile_group = storage_manager->GetTileGroup(location.block);
 
     // During the resetting, a table may be deconstructed because of the DROP
     // TABLE request
     if (tile_group == nullptr) {
-      delete txn_ctx;
+      concurrency::TransactionContext::Release(txn_ctx);
       return;
     }
 
@@ -235,25 +351,19 @@ void TransactionLevelGCManager::AddToRecycleMap(
     PELOTON_ASSERT(tile_group_header != nullptr);
     bool immutable = tile_group_header->GetImmutability();
 
-    for (auto &element : entry.second) {
-      // as this transaction has been committed, we should reclaim older
-      // versions.
-      ItemPointer location(entry.first, element.first);
-
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
-        continue;
-      }
-      // if immutable is false and the entry for table_id exists.
-      if ((!immutable) &&
-          recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
-      }
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
+    }
+    // if immutable is false and the entry for table_id exists.
+    if ((!immutable) &&
+        recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+      recycle_queue_map_[table_id]->Enqueue(location);
     }
   }
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  for (auto &entry : *(txn_ctx->GetGCObjectSetPtr().get())) {
+  for (auto &entry : txn_ctx->GetGCObjectSet()) {
     oid_t database_oid = std::get<0>(entry);
     oid_t table_oid = std::get<1>(entry);
     oid_t index_oid = std::get<2>(entry);
@@ -277,7 +387,7 @@ void TransactionLevelGCManager::AddToRecycleMap(
     LOG_DEBUG("GCing index %u", index_oid);
   }
 
-  delete txn_ctx;
+  concurrency::TransactionContext::Release(txn_ctx);
 }
 
 // this function returns a free tuple slot, if one exists
@@ -323,10 +433,8 @@ void TransactionLevelGCManager::StopGC() {
 
 void TransactionLevelGCManager::UnlinkVersions(
     concurrency::TransactionContext *txn_ctx) {
-  for (auto entry : *(txn_ctx->GetGCSetPtr().get())) {
-    for (auto &element : entry.second) {
-      UnlinkVersion(ItemPointer(entry.first, element.first), element.second);
-    }
+  for (auto &entry : txn_ctx->GetGCSet()) {
+    UnlinkVersion(entry.first, entry.second);
   }
 }
 
@@ -346,6 +454,22 @@ void TransactionLevelGCManager::UnlinkVersion(const ItemPointer location,
   auto tile_group_header =
       storage::StorageManager::GetInstance()->GetTileGroup(location.block)->GetHeader();
 
+  // a newer delta version may still read columns from the old version, they
+  // are copied into it before the old version is reclaimed.
+  if (type == GCVersionType::COMMIT_UPDATE) {
+    ItemPointer newer_location =
+        tile_group_header->GetPrevItemPointer(location.offset);
+    auto newer_tile_group =
+        newer_location.IsNull()
+            ? nullptr
+            : storage::StorageManager::GetInstance()->GetTileGroupPtr(
+                  newer_location.block);
+    if (newer_tile_group != nullptr &&
+        newer_tile_group->GetHeader()->HasDeltaRecords() == true) {
+      newer_tile_group->FoldDeltaVersion(newer_location.offset, location);
+    }
+  }
+
   ItemPointer *indirection = tile_group_header->GetIndirection(location.offset);
 
   // do nothing if indirection is null
@@ -43,6 +43,12 @@ class CatalogCache {
   CatalogCache() {}
   DISALLOW_COPY(CatalogCache)
 
+  // Drop all the cached objects, when the transaction context is reused
+  void Clear() {
+    database_objects_cache_.clear();
+    database_name_cache_.clear();
+  }
+
  private:
   std::shared_ptr<DatabaseCatalogEntry> GetDatabaseObject(oid_t database_oid);
   std::shared_ptr<DatabaseCatalogEntry> GetDatabaseObject(
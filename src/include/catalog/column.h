@@ -19,6 +19,11 @@
 #include "util/hash_util.h"
 
 namespace peloton {
+
+namespace storage {
+class StringDictionary;
+}  // namespace storage
+
 namespace catalog {
 
 //===--------------------------------------------------------------------===//
@@ -108,6 +113,17 @@ class Column : public Printable {
     has_default_ = false;
   }
 
+  // Manage dictionary encoding. The strings of a dictionary-encoded varchar
+  // column are interned in a dictionary that is shared by every copy of the
+  // column, so it must be set before the column is copied into a table.
+  void SetDictionaryEncoded();
+
+  inline bool IsDictionaryEncoded() const { return dictionary_ != nullptr; }
+
+  inline storage::StringDictionary *GetDictionary() const {
+    return dictionary_.get();
+  }
+
   hash_t Hash() const {
     hash_t hash = HashUtil::Hash(&column_type_);
     return HashUtil::CombineHashes(hash, HashUtil::Hash(&is_inlined_));
@@ -160,6 +176,9 @@ class Column : public Printable {
 
   // offset of column in tuple
   oid_t column_offset_ = INVALID_OID;
+
+  // dictionary of the strings of a dictionary-encoded column
+  std::shared_ptr<storage::StringDictionary> dictionary_;
 };
 
 }  // namespace catalog
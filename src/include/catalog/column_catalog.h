@@ -52,6 +52,7 @@ class ColumnCatalogEntry {
   inline bool IsNotNull() { return is_not_null_; }
   inline bool HasDefault() { return has_default_; }
   inline const type::Value &GetDefaultValue() { return default_value_; }
+  inline bool IsDictionaryEncoded() { return is_dictionary_encoded_; }
 
  private:
   // member variables
@@ -65,6 +66,7 @@ class ColumnCatalogEntry {
   bool is_not_null_;
   bool has_default_;
   type::Value default_value_;
+  bool is_dictionary_encoded_;
 };
 
 class ColumnCatalog : public AbstractCatalog {
@@ -98,6 +100,7 @@ class ColumnCatalog : public AbstractCatalog {
                     bool is_not_null,
                     bool is_default,
                     const std::shared_ptr<type::Value> default_value,
+                    bool is_dictionary_encoded,
                     type::AbstractPool *pool);
 
   bool DeleteColumn(concurrency::TransactionContext *txn,
@@ -139,9 +142,10 @@ class ColumnCatalog : public AbstractCatalog {
     HAS_DEFAULT = 8,
     DEFAULT_VALUE_SRC = 9,
     DEFAULT_VALUE_BIN = 10,
+    IS_DICTIONARY_ENCODED = 11,
     // Add new columns here in creation order
   };
-  std::vector<oid_t> all_column_ids_ = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<oid_t> all_column_ids_ = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
 
   enum IndexId {
     PRIMARY_KEY = 0,
@@ -126,6 +126,11 @@ class Schema : public Printable {
     return columns_[column_id].IsInlined();
   }
 
+  // The dictionary of a dictionary-encoded column, or nullptr
+  inline storage::StringDictionary *GetDictionary(const oid_t column_id) const {
+    return columns_[column_id].GetDictionary();
+  }
+
   inline const Column &GetColumn(const oid_t column_id) const {
     return columns_[column_id];
   }
@@ -18,9 +18,14 @@
 namespace peloton {
 
 namespace expression {
+class AbstractExpression;
 class ComparisonExpression;
 }  // namespace expression
 
+namespace storage {
+class StringDictionary;
+}  // namespace storage
+
 namespace codegen {
 
 //===----------------------------------------------------------------------===//
@@ -35,6 +40,34 @@ class ComparisonTranslator : public ExpressionTranslator {
   // Produce the result of performing the comparison of left and right values
   codegen::Value DeriveValue(CodeGen &codegen,
                              RowBatch::Row &row) const override;
+
+ private:
+  // The dictionary of the column if the expression is read straight from a
+  // dictionary-encoded column, and nullptr otherwise
+  static const storage::StringDictionary *GetDictionary(
+      const expression::AbstractExpression &expression);
+
+  // Whether the value of the expression is the same for every row
+  static bool IsConstantString(const expression::AbstractExpression &expression);
+
+  // Compare the codes of the strings instead of the strings
+  codegen::Value DeriveCodeComparison(CodeGen &codegen,
+                                      const codegen::Value &left,
+                                      const codegen::Value &right) const;
+
+ private:
+  // The dictionary whose codes an (in)equality is evaluated on, if the strings
+  // of one side are read from a dictionary-encoded column, and the other side
+  // is either a constant or read from the same column
+  const storage::StringDictionary *dictionary_;
+
+  // Whether the code of the left or the right side is looked up in the
+  // dictionary, because the side is a constant
+  bool lookup_left_;
+  bool lookup_right_;
+
+  // The slot in the query state that the code of the constant is kept in
+  QueryState::Id code_cache_id_;
 };
 
 }  // namespace codegen
@@ -29,6 +29,7 @@ class ExecutorContext;
 namespace storage {
 class DataTable;
 class Tile;
+class TileGroup;
 class Tuple;
 }  // namespace storage
 
@@ -43,9 +44,10 @@ namespace codegen {
 // through its Init() outside the main loop
 class Inserter {
  public:
-  // Initializes the instance
+  // Initializes the instance. A bulk load inserts the tuples into tile groups
+  // of its own, and inserts them into the indexes a tile group at a time.
   void Init(storage::DataTable *table,
-            executor::ExecutorContext *executor_context);
+            executor::ExecutorContext *executor_context, bool bulk_load);
 
   // Allocate the storage area that is to be reserved
   char *AllocateTupleStorage();
@@ -56,22 +58,37 @@ class Inserter {
   // Insert a tuple
   void Insert();
 
+  // Insert the tuples of a bulk load that are not inserted yet
+  void Flush();
+
   // Finalize the instance
   void TearDown();
 
  private:
   // No external constructor
-  Inserter(): table_(nullptr), executor_context_(nullptr), tile_(nullptr) {}
+  Inserter()
+      : table_(nullptr),
+        executor_context_(nullptr),
+        bulk_load_(false),
+        tile_(nullptr),
+        bulk_tile_group_(nullptr),
+        bulk_tuple_start_(0) {}
 
  private:
   // Provided by its insert translator
   storage::DataTable *table_;
   executor::ExecutorContext *executor_context_;
+  bool bulk_load_;
 
   // Set once a tuple storage is reserved
   std::shared_ptr<storage::Tile> tile_;
   ItemPointer location_;
 
+  // The tile group that a bulk load fills, and its first tuple that is not
+  // inserted yet
+  storage::TileGroup *bulk_tile_group_;
+  oid_t bulk_tuple_start_;
+
  private:
   DISALLOW_COPY_AND_MOVE(Inserter);
 };
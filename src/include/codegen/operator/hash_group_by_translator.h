@@ -21,6 +21,7 @@ namespace peloton {
 
 namespace planner {
 class AggregatePlan;
+struct AttributeInfo;
 }  // namespace planner
 
 namespace codegen {
@@ -133,8 +134,10 @@ class HashGroupByTranslator : public OperatorTranslator {
   //===--------------------------------------------------------------------===//
   class AggregateFinalizer {
    public:
-    AggregateFinalizer(const Aggregation &aggregation,
-                       HashTable::HashTableAccess &hash_table_access);
+    AggregateFinalizer(
+        const Aggregation &aggregation,
+        const std::vector<const planner::AttributeInfo *> &grouping_ais,
+        HashTable::HashTableAccess &hash_table_access);
     // Get the finalized aggregates at the given position in the results
     const std::vector<codegen::Value> &GetAggregates(CodeGen &codegen,
                                                      llvm::Value *index);
@@ -142,6 +145,8 @@ class HashGroupByTranslator : public OperatorTranslator {
    private:
     // The aggregator
     Aggregation aggregation_;
+    // The grouping keys, whose values are the first values of the aggregates
+    const std::vector<const planner::AttributeInfo *> &grouping_ais_;
     // The hash-table accessor
     HashTable::HashTableAccess &hash_table_access_;
     // Whether the aggregate has been finalized and the results
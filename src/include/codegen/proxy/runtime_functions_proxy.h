@@ -25,6 +25,9 @@ PROXY(ColumnLayoutInfo) {
   DECLARE_MEMBER(0, char *, col_start_ptr);
   DECLARE_MEMBER(1, uint32_t, stride);
   DECLARE_MEMBER(2, bool, columnar);
+  DECLARE_MEMBER(3, uint32_t, encoding);
+  DECLARE_MEMBER(4, int64_t, reference);
+  DECLARE_MEMBER(5, uint32_t, bit_width);
   DECLARE_TYPE;
 };
 
@@ -43,6 +46,10 @@ PROXY(RuntimeFunctions) {
   DECLARE_METHOD(HashCrc64);
   DECLARE_METHOD(GetTileGroup);
   DECLARE_METHOD(GetTileGroupLayout);
+  DECLARE_METHOD(GetCompressedValue);
+  DECLARE_METHOD(InternString);
+  DECLARE_METHOD(GetDictionaryCode);
+  DECLARE_METHOD(GetDictionaryVarlen);
   DECLARE_METHOD(FillPredicateArray);
   DECLARE_METHOD(ExecuteTableScan);
   DECLARE_METHOD(ExecutePerState);
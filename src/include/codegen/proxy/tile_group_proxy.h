@@ -24,6 +24,7 @@ PROXY(TileGroup) {
 
   DECLARE_METHOD(GetNextTupleSlot);
   DECLARE_METHOD(GetTileGroupId);
+  DECLARE_METHOD(ShouldScan);
 };
 
 TYPE_BUILDER(TileGroup, storage::TileGroup);
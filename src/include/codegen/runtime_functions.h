@@ -60,10 +60,19 @@ class RuntimeFunctions {
   // doing strided accesses to mimic columnar storage.  In a pure row-store,
   // the stride is equivalent to the size of the tuple. In a pure column-store
   // (without compression), the stride is equivalent to the size of data type.
+  //
+  // A column that is compressed in a frozen tile group has an encoding other
+  // than storage::ColumnEncoding::NONE. For a frame-of-reference encoded
+  // column, the column points to the packed data. For other encodings, it
+  // points to the storage::CompressedColumn, and the values are decoded with
+  // GetCompressedValue().
   struct ColumnLayoutInfo {
     char *column;
     uint32_t stride;
     bool is_columnar;
+    uint32_t encoding;
+    int64_t reference;
+    uint32_t bit_width;
   };
 
   /**
@@ -77,6 +86,46 @@ class RuntimeFunctions {
    */
   static void GetTileGroupLayout(const storage::TileGroup *tile_group,
                                  ColumnLayoutInfo *infos, uint32_t num_cols);
+
+  /**
+   * Decode the value of a tuple in a compressed column of a frozen tile
+   * group.
+   *
+   * @param column The storage::CompressedColumn set in the ColumnLayoutInfo
+   * @param tuple_id The tuple whose value is decoded
+   *
+   * @return The integer that the value is stored as in a tile
+   */
+  static int64_t GetCompressedValue(const char *column, uint32_t tuple_id);
+
+  /**
+   * Intern a string in the dictionary of a dictionary-encoded column, and
+   * store the pointer to its varlen in the given buffer.
+   *
+   * @param dictionary The storage::StringDictionary of the column
+   * @param data The bytes of the string
+   * @param len The length of the string
+   * @param buf The storage of the column in a tuple
+   */
+  static void InternString(const char *dictionary, const char *data,
+                           uint32_t len, char *buf);
+
+  /**
+   * Get the code of a string in the dictionary of a dictionary-encoded column.
+   *
+   * @return The code, or storage::StringDictionary::invalid_code_ if no value
+   * of the column is equal to the string
+   */
+  static int32_t GetDictionaryCode(const char *dictionary, const char *data,
+                                   uint32_t len);
+
+  /**
+   * Get the varlen of a code in the dictionary of a dictionary-encoded column.
+   *
+   * @return The varlen, or nullptr if the code is not a valid code
+   */
+  static const char *GetDictionaryVarlen(const char *dictionary,
+                                         int32_t code);
   
   /**
    * Execute a parallel scan over the given table in the given database.
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.h
+//
+// Identification: src/include/codegen/string_dictionary.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+#include "codegen/value.h"
+
+namespace peloton {
+
+namespace storage {
+class StringDictionary;
+}  // namespace storage
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// This class generates the code that works on the integer codes of the
+// strings of a dictionary-encoded varchar column, rather than on the strings.
+// The codes of two strings of the same column are equal iff the strings are.
+//===----------------------------------------------------------------------===//
+class StringDictionary {
+ public:
+  /// Constructor
+  explicit StringDictionary(const storage::StringDictionary &dictionary);
+
+  /// Store a string into the column of a tuple, by interning it in the
+  /// dictionary
+  void StoreString(CodeGen &codegen, const codegen::Value &str,
+                   llvm::Value *buf) const;
+
+  /// The code of a string that is read from the column, as an integer. The
+  /// code is loaded from the entry of the string in the dictionary.
+  codegen::Value GetCode(CodeGen &codegen, const codegen::Value &str) const;
+
+  /// The code of any string, as an integer. The code is looked up in the
+  /// dictionary at run time the first time, and kept in the given i32 slot of
+  /// the query state, which must be zeroed before the query runs. A string
+  /// that is not in the dictionary gets a code that no string of the column
+  /// has.
+  codegen::Value LookupCode(CodeGen &codegen, const codegen::Value &str,
+                            llvm::Value *code_cache_ptr) const;
+
+  /// The string of a code that is returned by GetCode()
+  codegen::Value GetString(CodeGen &codegen, const codegen::Value &code) const;
+
+ private:
+  llvm::Value *GetDictionaryPtr(CodeGen &codegen) const;
+
+ private:
+  // The dictionary of the column
+  const storage::StringDictionary &dictionary_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -57,8 +57,6 @@ class Table {
   llvm::Value *GetTileGroup(CodeGen &codegen, llvm::Value *table_ptr,
                             llvm::Value *tile_group_id) const;
 
-  llvm::Value *GetZoneMapManager(CodeGen &codegen) const;
-
  private:
   // The table associated with this generator
   storage::DataTable &table_;
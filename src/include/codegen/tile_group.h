@@ -56,8 +56,20 @@ class TileGroup {
     llvm::Value *col_start_ptr;
     llvm::Value *col_stride;
     llvm::Value *is_columnar;
+    // the storage::ColumnEncoding of the column, and the frame of reference
+    // of a frame-of-reference encoded column
+    llvm::Value *encoding;
+    llvm::Value *reference;
+    llvm::Value *bit_width;
   };
 
+  // Load the integer of a column that may be compressed in a frozen tile
+  // group, as the type the column is materialized as
+  llvm::Value *LoadCompressibleColumn(CodeGen &codegen, llvm::Value *tid,
+                                      llvm::Value *col_address,
+                                      llvm::Type *col_type,
+                                      const ColumnLayout &layout) const;
+
   /*
   //===--------------------------------------------------------------------===//
   // A convenience class to access to a column
@@ -0,0 +1,225 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// flat_hash_map.h
+//
+// Identification: src/include/common/container/flat_hash_map.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+/**
+ * @brief An open addressing hash map with linear probing, for the small
+ * per-transaction sets of the concurrency control.
+ *
+ * The first InlineCapacity slots live in the map itself, so a map that never
+ * holds more than half of them does not touch the heap. A map that outgrows
+ * them moves to a heap table, which Clear() keeps for the next use of the map.
+ * Entries can not be erased, and the map is not thread-safe.
+ */
+template <typename KeyType, typename ValueType, typename HashType,
+          typename KeyEqual, size_t InlineCapacity>
+class FlatHashMap {
+  static_assert(InlineCapacity > 0 &&
+                    (InlineCapacity & (InlineCapacity - 1)) == 0,
+                "the inline capacity must be a power of two");
+
+  struct Slot {
+    std::pair<KeyType, ValueType> entry;
+    bool occupied = false;
+  };
+
+  template <bool IsConst>
+  class Iterator {
+    friend class FlatHashMap;
+    typedef typename std::conditional<IsConst, const Slot, Slot>::type SlotType;
+
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::pair<KeyType, ValueType> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<IsConst, const value_type,
+                                      value_type>::type &reference;
+    typedef typename std::conditional<IsConst, const value_type,
+                                      value_type>::type *pointer;
+
+    reference operator*() const { return slot_->entry; }
+    pointer operator->() const { return &(slot_->entry); }
+
+    Iterator &operator++() {
+      slot_++;
+      SkipEmptySlots();
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return slot_ == other.slot_;
+    }
+    bool operator!=(const Iterator &other) const {
+      return slot_ != other.slot_;
+    }
+
+   private:
+    Iterator(SlotType *slot, SlotType *end_slot)
+        : slot_(slot), end_slot_(end_slot) {}
+
+    void SkipEmptySlots() {
+      while (slot_ != end_slot_ && slot_->occupied == false) {
+        slot_++;
+      }
+    }
+
+    SlotType *slot_;
+    SlotType *end_slot_;
+  };
+
+ public:
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+
+  FlatHashMap() : slots_(inline_slots_), capacity_(InlineCapacity), size_(0) {}
+
+  ~FlatHashMap() { ReleaseHeapSlots(); }
+
+  DISALLOW_COPY_AND_MOVE(FlatHashMap);
+
+  // Find the entry of a key, or end() if there is none
+  iterator find(const KeyType &key) {
+    Slot *slot = FindSlot(key);
+    return slot->occupied ? iterator(slot, slots_ + capacity_) : end();
+  }
+
+  const_iterator find(const KeyType &key) const {
+    const Slot *slot = FindSlot(key);
+    return slot->occupied ? const_iterator(slot, slots_ + capacity_) : end();
+  }
+
+  // The value of a key, which is value-initialized if the key is new
+  ValueType &operator[](const KeyType &key) {
+    Slot *slot = FindSlot(key);
+    if (slot->occupied == false) {
+      if ((size_ + 1) * 2 > capacity_) {
+        Grow();
+        slot = FindSlot(key);
+      }
+      slot->entry.first = key;
+      slot->entry.second = ValueType();
+      slot->occupied = true;
+      size_++;
+    }
+    return slot->entry.second;
+  }
+
+  // Returns the number of entries
+  size_t GetSize() const { return size_; }
+
+  // Checks if the map is empty
+  bool IsEmpty() const { return size_ == 0; }
+
+  // Returns the number of slots, inline or on the heap
+  size_t GetCapacity() const { return capacity_; }
+
+  // Remove all the entries, keeping the slots
+  void Clear() {
+    if (size_ == 0) {
+      return;
+    }
+    for (size_t slot_itr = 0; slot_itr < capacity_; slot_itr++) {
+      slots_[slot_itr].occupied = false;
+    }
+    size_ = 0;
+  }
+
+  // Remove all the entries, and give the heap slots back
+  void Reset() {
+    ReleaseHeapSlots();
+    slots_ = inline_slots_;
+    capacity_ = InlineCapacity;
+    for (size_t slot_itr = 0; slot_itr < capacity_; slot_itr++) {
+      slots_[slot_itr].occupied = false;
+    }
+    size_ = 0;
+  }
+
+  iterator begin() {
+    iterator itr(slots_, slots_ + capacity_);
+    itr.SkipEmptySlots();
+    return itr;
+  }
+
+  iterator end() { return iterator(slots_ + capacity_, slots_ + capacity_); }
+
+  const_iterator begin() const {
+    const_iterator itr(slots_, slots_ + capacity_);
+    itr.SkipEmptySlots();
+    return itr;
+  }
+
+  const_iterator end() const {
+    return const_iterator(slots_ + capacity_, slots_ + capacity_);
+  }
+
+ private:
+  // The slot of a key, or the empty slot where it would go. There is always
+  // an empty slot, as the map is at most half full.
+  Slot *FindSlot(const KeyType &key) const {
+    size_t mask = capacity_ - 1;
+    size_t slot_itr = HashType()(key) & mask;
+    while (slots_[slot_itr].occupied &&
+           KeyEqual()(slots_[slot_itr].entry.first, key) == false) {
+      slot_itr = (slot_itr + 1) & mask;
+    }
+    return &slots_[slot_itr];
+  }
+
+  void Grow() {
+    Slot *old_slots = slots_;
+    size_t old_capacity = capacity_;
+
+    capacity_ = old_capacity * 2;
+    slots_ = new Slot[capacity_];
+    for (size_t slot_itr = 0; slot_itr < old_capacity; slot_itr++) {
+      if (old_slots[slot_itr].occupied) {
+        Slot *slot = FindSlot(old_slots[slot_itr].entry.first);
+        slot->entry = std::move(old_slots[slot_itr].entry);
+        slot->occupied = true;
+      }
+    }
+
+    if (old_slots != inline_slots_) {
+      delete[] old_slots;
+    } else {
+      for (size_t slot_itr = 0; slot_itr < old_capacity; slot_itr++) {
+        inline_slots_[slot_itr].occupied = false;
+      }
+    }
+  }
+
+  void ReleaseHeapSlots() {
+    if (slots_ != inline_slots_) {
+      delete[] slots_;
+    }
+  }
+
+  // the slots in use, which are either the inline ones or on the heap
+  Slot *slots_;
+  size_t capacity_;
+  size_t size_;
+
+  Slot inline_slots_[InlineCapacity];
+};
+
+}  // namespace peloton
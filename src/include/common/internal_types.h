@@ -28,6 +28,7 @@
 #include "tbb/concurrent_unordered_set.h"
 #include "tbb/concurrent_vector.h"
 
+#include "common/container/flat_hash_map.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "parser/pg_trigger.h"
@@ -361,7 +362,8 @@ enum class SqlStateErrorCode {
 
 enum class ProtocolType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2           // silo-style optimistic concurrency control
 };
 std::string ProtocolTypeToString(ProtocolType type);
 ProtocolType StringToProtocolType(const std::string &str);
@@ -944,6 +946,15 @@ std::string LoggingTypeToString(LoggingType type);
 LoggingType StringToLoggingType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const LoggingType &type);
 
+enum class LoggingModeType {
+  INVALID = INVALID_TYPE_ID,
+  TUPLE = 1,   // log the modified tuples
+  COMMAND = 2  // log the executed prepared statements and their parameters
+};
+std::string LoggingModeTypeToString(LoggingModeType type);
+LoggingModeType StringToLoggingModeType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const LoggingModeType &type);
+
 enum class LogRecordType {
   INVALID = INVALID_TYPE_ID,
 
@@ -959,6 +970,9 @@ enum class LogRecordType {
   // Epoch related records
   EPOCH_BEGIN = 21,
   EPOCH_END = 22,
+
+  // Command logging records
+  COMMAND = 31,
 };
 std::string LogRecordTypeToString(LogRecordType type);
 LogRecordType StringToLogRecordType(const std::string &str);
@@ -973,6 +987,15 @@ std::string CheckpointingTypeToString(CheckpointingType type);
 CheckpointingType StringToCheckpointingType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const CheckpointingType &type);
 
+enum class CheckpointFormatType {
+  INVALID = INVALID_TYPE_ID,
+  ROW = 1,    // tuple values are serialized one by one
+  BINARY = 2  // tuples are stored in the in-memory tile layout
+};
+std::string CheckpointFormatTypeToString(CheckpointFormatType type);
+CheckpointFormatType StringToCheckpointFormatType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const CheckpointFormatType &type);
+
 /* Possible values for peloton_tilegroup_layout GUC */
 enum class LayoutType {
   INVALID = INVALID_TYPE_ID,
@@ -1221,8 +1244,9 @@ RWType StringToRWType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const RWType &type);
 
 // ItemPointer -> type
-typedef tbb::concurrent_unordered_map<ItemPointer, RWType, ItemPointerHasher,
-                                      ItemPointerComparator>
+// only the worker thread of a transaction records into its set.
+typedef FlatHashMap<ItemPointer, RWType, ItemPointerHasher,
+                    ItemPointerComparator, 64>
     ReadWriteSet;
 
 typedef tbb::concurrent_unordered_set<ItemPointer, ItemPointerHasher,
@@ -1244,8 +1268,9 @@ std::string GCVersionTypeToString(GCVersionType type);
 GCVersionType StringToGCVersionType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const GCVersionType &type);
 
-// block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, GCVersionType>>
+// ItemPointer -> type
+typedef FlatHashMap<ItemPointer, GCVersionType, ItemPointerHasher,
+                    ItemPointerComparator, 32>
     GCSet;
 
 enum class DDLType {
@@ -91,6 +91,13 @@ class Statement : public Printable {
 
   inline void SetNeedsReplan(bool replan) { needs_replan_ = replan; }
 
+  // id of the statement in the command log, INVALID_OID until it is logged
+  inline oid_t GetLogStatementId() const { return log_statement_id_; }
+
+  inline void SetLogStatementId(oid_t statement_id) {
+    log_statement_id_ = statement_id;
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const override;
 
@@ -127,6 +134,9 @@ class Statement : public Printable {
 
   // If this flag is true, then somebody wants us to replan this query
   bool needs_replan_ = false;
+
+  // id of the statement in the command log
+  oid_t log_statement_id_ = INVALID_OID;
 };
 
 }  // namespace peloton
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief      Class for the Silo-style optimistic transaction manager.
+ *
+ * Serializable and repeatable read transactions do not write to the tile
+ * group header when they read. They record the versions they read in their
+ * read/write set instead, and validate at commit that none of them has been
+ * overwritten or locked by another transaction since. The commit id is taken
+ * from the current epoch once the writes are locked, so transactions are
+ * installed in epoch order.
+ *
+ * Writes still lock the versions they modify when they are performed, as the
+ * executors install the new versions in place. Versions, inserts, deletes,
+ * aborts and the other isolation levels are handled as in timestamp ordering.
+ */
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  /**
+   * @brief      Destroys the object.
+   */
+  virtual ~OptimisticTransactionManager() {}
+
+  /**
+   * @brief      Gets the instance.
+   *
+   * @param[in]  protocol   The protocol
+   * @param[in]  isolation  The isolation
+   * @param[in]  conflict   The conflict
+   *
+   * @return     The instance.
+   */
+  static OptimisticTransactionManager &GetInstance(
+      const ProtocolType protocol, const IsolationLevelType isolation,
+      const ConflictAvoidanceType conflict);
+
+  /**
+   * This method is used to acquire the ownership of a tuple for a transaction.
+   * Readers leave no trace in the tuple, so only concurrent writers can
+   * prevent it.
+   *
+   * @param      current_txn        The current transaction
+   * @param[in]  tile_group_header  The tile group header
+   * @param[in]  tuple_id           The tuple identifier
+   *
+   * @return     True if success, False otherwise.
+   */
+  virtual bool AcquireOwnership(
+      TransactionContext *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  /**
+   * @brief      Perform a read operation. The version is recorded in the
+   *             read/write set of the transaction, to be validated at commit.
+   *
+   * @param      current_txn        The current transaction
+   * @param[in]  location           The location of the tuple to be read
+   * @param[in]  tile_group_header  Pointer to the tile group header
+   * @param[in]  acquire_ownership  The acquire ownership
+   */
+  virtual bool PerformRead(TransactionContext *const current_txn,
+                           const ItemPointer &location,
+                           storage::TileGroupHeader *tile_group_header,
+                           bool acquire_ownership);
+
+  /**
+   * @brief      Commits a transaction if the versions it read are still the
+   *             latest ones, and aborts it otherwise.
+   *
+   * @param      current_txn  The current transaction
+   *
+   * @return     The result type
+   */
+  virtual ResultType CommitTransaction(TransactionContext *const current_txn);
+
+ private:
+  /**
+   * @brief      Checks that no version read by a transaction has been
+   *             overwritten, or is locked by another transaction.
+   *
+   * @param      current_txn  The current transaction
+   *
+   * @return     True if the reads are still valid, False otherwise.
+   */
+  bool ValidateReadSet(TransactionContext *const current_txn);
+};
+}  // namespace concurrency
+}  // namespace peloton
@@ -107,6 +107,8 @@ class TimestampOrderingTransactionManager : public TransactionManager {
    * Test if this transaction can get ownership.
    * If the tuple is not owned by any transaction and is visible to current
    * transaction. the version must be the latest version in the version chain.
+   * With the WAIT conflict avoidance policy, a tuple owned by a younger
+   * transaction is waited for.
    *
    * @param[in]  TransactionContext  The transaction context
    * @param[in]  tile_group_header  The tile group header
@@ -184,10 +186,13 @@ class TimestampOrderingTransactionManager : public TransactionManager {
    * @param      current_txn   The current transaction
    * @param[in]  old_location  The location of the old tuple to be updated
    * @param[in]  new_location  The location of the new tuple
+   * @param[in]  target_list   The columns modified by the update, or nullptr
+   *                           if all the columns are modified
    */
   virtual void PerformUpdate(TransactionContext *const current_txn,
                              const ItemPointer &old_location,
-                             const ItemPointer &new_location);
+                             const ItemPointer &new_location,
+                             const TargetList *target_list = nullptr);
 
   /**
    * @brief      Perform a delete operation. Used when the transaction is the
@@ -206,9 +211,12 @@ class TimestampOrderingTransactionManager : public TransactionManager {
    *
    * @param      current_txn  The current transaction
    * @param[in]  location     The location
+   * @param[in]  target_list  The columns modified by the update, or nullptr
+   *                          if all the columns are modified
    */
   virtual void PerformUpdate(TransactionContext *const current_txn,
-                             const ItemPointer &location);
+                             const ItemPointer &location,
+                             const TargetList *target_list = nullptr);
 
   /**
    * @brief      Perform a delete operation. Used when the transaction is not 
@@ -238,6 +246,24 @@ class TimestampOrderingTransactionManager : public TransactionManager {
    */
   virtual ResultType AbortTransaction(TransactionContext *const current_txn);
 
+ protected:
+  /**
+   * @brief      Waits for the write lock on a tuple to be released, following
+   *             the wait-die policy. Only a transaction older than the holder
+   *             of the lock waits, spinning then yielding, for at most
+   *             conflict_wait_timeout microseconds.
+   *
+   * @param      current_txn        The current transaction
+   * @param[in]  tile_group_header  The tile group header
+   * @param[in]  tuple_id           The tuple identifier
+   *
+   * @return     True if the lock was released and the version is still the
+   *             latest one, False if the transaction must abort.
+   */
+  bool WaitForWriteLock(TransactionContext *const current_txn,
+                        const storage::TileGroupHeader *const tile_group_header,
+                        const oid_t &tuple_id);
+
  private:
   /**
    * @brief      Sets the last reader commit identifier.
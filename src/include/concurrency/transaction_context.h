@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -23,9 +24,12 @@
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "common/internal_types.h"
+#include "type/value.h"
 
 namespace peloton {
 
+class Statement;
+
 namespace trigger {
 class TriggerSet;
 class TriggerData;
@@ -33,10 +37,22 @@ class TriggerData;
 
 namespace concurrency {
 
+class TransactionContextPool;
+
 //===--------------------------------------------------------------------===//
 // TransactionContext
 //===--------------------------------------------------------------------===//
 
+/**
+ * @brief      A prepared statement executed by a transaction, with its bound
+ *             parameters. Command logging replays them in commit order.
+ */
+struct TransactionCommand {
+  std::shared_ptr<Statement> statement;
+  std::string database_name;
+  std::vector<type::Value> params;
+};
+
 /**
  * @brief      Class for transaction context.
  */
@@ -55,6 +71,39 @@ class TransactionContext : public Printable {
    */
   ~TransactionContext() = default;
 
+  /**
+   * @brief      Gets a context for a new transaction of the calling thread.
+   *             The context of an ended transaction of the thread is reused
+   *             with the slots of its read/write set and gc set, so short
+   *             transactions do not allocate them.
+   *
+   * @param[in]  thread_id  The thread identifier
+   * @param[in]  isolation  The isolation level
+   * @param[in]  read_id    The read identifier
+   * @param[in]  commit_id  The commit identifier
+   *
+   * @return     The transaction context.
+   */
+  static TransactionContext *Acquire(const size_t thread_id,
+                                     const IsolationLevelType isolation,
+                                     const cid_t &read_id,
+                                     const cid_t &commit_id);
+
+  static TransactionContext *Acquire(const size_t thread_id,
+                                     const IsolationLevelType isolation,
+                                     const cid_t &read_id) {
+    return Acquire(thread_id, isolation, read_id, read_id);
+  }
+
+  /**
+   * @brief      Gives the context of an ended transaction back to the thread
+   *             that acquired it, or deletes it. It may be released on any
+   *             thread, e.g. by the GC.
+   *
+   * @param      txn   The transaction context
+   */
+  static void Release(TransactionContext *txn);
+
  private:
   void Init(const size_t thread_id, const IsolationLevelType isolation,
             const cid_t &read_id) {
@@ -64,6 +113,9 @@ class TransactionContext : public Printable {
   void Init(const size_t thread_id, const IsolationLevelType isolation,
             const cid_t &read_id, const cid_t &commit_id);
 
+  // Drop the state of the ended transaction before the context is reused
+  void Recycle();
+
  public:
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
@@ -159,10 +211,71 @@ class TransactionContext : public Printable {
                                 index_oid, DDLType::DROP));
   }
 
+  /**
+   * @brief      Record a version read by the transaction, for the protocols
+   *             that validate their reads at commit. A version that is
+   *             already in the read/write set keeps its type.
+   *
+   * @param[in]  location  The location of the version
+   */
+  void RecordRead(const ItemPointer &location);
+
   void RecordReadOwn(const ItemPointer &);
 
   void RecordUpdate(const ItemPointer &);
 
+  /**
+   * @brief      Record the columns modified by the update of a version.
+   *             An update without a target list modifies all the columns.
+   *
+   * @param[in]  location     The location of the updated version
+   * @param[in]  target_list  The target list of the update, or nullptr
+   * @param[in]  is_first     True if this is the first update of the version
+   */
+  void RecordUpdatedColumns(const ItemPointer &location,
+                            const TargetList *target_list,
+                            const bool is_first);
+
+  /**
+   * @brief      Gets the columns modified by the update of a version.
+   *
+   * @param[in]  location  The location of the updated version
+   *
+   * @return     The sorted ids of the modified columns, or nullptr if all
+   *             the columns are modified.
+   */
+  const std::vector<oid_t> *GetUpdatedColumns(const ItemPointer &location) const;
+
+  /**
+   * @brief      Record a prepared statement executed by this transaction.
+   *
+   * @param[in]  statement      The statement
+   * @param[in]  database_name  The database the statement is bound to
+   * @param[in]  params         The bound parameters
+   */
+  void RecordCommand(const std::shared_ptr<Statement> &statement,
+                     const std::string &database_name,
+                     const std::vector<type::Value> &params);
+
+  /**
+   * @brief      Mark that the writes of this transaction cannot be replayed
+   *             from its commands.
+   */
+  void InvalidateCommands() {
+    is_command_loggable_ = false;
+    commands_.clear();
+  }
+
+  /**
+   * @brief      Gets the commands executed by this transaction.
+   *
+   * @return     The commands in execution order, or nullptr if the writes of
+   *             this transaction cannot be replayed from them.
+   */
+  const std::vector<TransactionCommand> *GetCommands() const {
+    return is_command_loggable_ ? &commands_ : nullptr;
+  }
+
   void RecordInsert(const ItemPointer &);
 
   /**
@@ -204,34 +317,32 @@ class TransactionContext : public Printable {
   inline const CreateDropSet &GetCreateDropSet() { return rw_object_set_; }
 
   /**
-   * @brief      Gets the gc set pointer.
+   * @brief      Gets the gc set.
    *
-   * @return     The gc set pointer.
+   * @return     The gc set.
    */
-  inline std::shared_ptr<GCSet> GetGCSetPtr() { return gc_set_; }
+  inline GCSet &GetGCSet() { return gc_set_; }
 
   /**
-   * @brief      Gets the gc object set pointer.
+   * @brief      Gets the gc object set.
    *
-   * @return     The gc object set pointer.
+   * @return     The gc object set.
    */
-  inline std::shared_ptr<GCObjectSet> GetGCObjectSetPtr() {
-    return gc_object_set_;
-  }
+  inline GCObjectSet &GetGCObjectSet() { return gc_object_set_; }
 
   /**
    * @brief      Determines if gc set empty.
    *
    * @return     True if gc set empty, False otherwise.
    */
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() { return gc_set_.IsEmpty(); }
 
   /**
    * @brief      Determines if gc object set empty.
    *
    * @return     True if gc object set empty, False otherwise.
    */
-  inline bool IsGCObjectSetEmpty() { return gc_object_set_->size() == 0; }
+  inline bool IsGCObjectSetEmpty() { return gc_object_set_.empty(); }
 
   /**
    * @brief      Get a string representation for debugging.
@@ -271,6 +382,27 @@ class TransactionContext : public Printable {
     read_only_ = true;
   }
 
+  /**
+   * @brief      Determines if the commit waits for the log records to be
+   *             durable.
+   *
+   * @return     True if synchronous commit, False otherwise.
+   */
+  bool IsSynchronousCommit() const {
+    return synchronous_commit_;
+  }
+
+  /**
+   * @brief      Sets whether the commit waits for the log records to be
+   *             durable.
+   *
+   * @param[in]  synchronous_commit  True to wait, False to return as soon
+   *                                 as the records are buffered.
+   */
+  void SetSynchronousCommit(const bool synchronous_commit) {
+    synchronous_commit_ = synchronous_commit;
+  }
+
   /**
    * @brief      Gets the isolation level.
    *
@@ -325,11 +457,22 @@ class TransactionContext : public Printable {
   ReadWriteSet rw_set_;
   CreateDropSet rw_object_set_;
 
+  /**
+   * columns modified by the updates of this transaction, indexed by the
+   * location of the updated version. used to log column deltas.
+   */
+  std::unordered_map<ItemPointer, std::vector<oid_t>, ItemPointerHasher,
+                     ItemPointerComparator> updated_columns_;
+
+  /** prepared statements executed by the transaction, for command logging */
+  std::vector<TransactionCommand> commands_;
+  bool is_command_loggable_;
+
   /** 
    * this set contains data location that needs to be gc'd in the transaction. 
    */
-  std::shared_ptr<GCSet> gc_set_;
-  std::shared_ptr<GCObjectSet> gc_object_set_;
+  GCSet gc_set_;
+  GCObjectSet gc_object_set_;
 
   /** result of the transaction */
   ResultType result_ = ResultType::SUCCESS;
@@ -342,6 +485,12 @@ class TransactionContext : public Printable {
 
   /** one default transaction is NOT 'read only' unless it is marked 'read only' explicitly*/
   bool read_only_ = false;
+
+  /** a commit only returns once the log records are durable if it is set */
+  bool synchronous_commit_ = false;
+
+  /** the pool of the thread that acquired this context, if any */
+  std::shared_ptr<TransactionContextPool> pool_;
 };
 
 }  // namespace concurrency
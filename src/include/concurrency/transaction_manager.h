@@ -197,14 +197,16 @@ class TransactionManager {
 
   virtual void PerformUpdate(TransactionContext *const current_txn,
                              const ItemPointer &old_location,
-                             const ItemPointer &new_location) = 0;
+                             const ItemPointer &new_location,
+                             const TargetList *target_list = nullptr) = 0;
 
   virtual void PerformDelete(TransactionContext *const current_txn,
                              const ItemPointer &old_location,
                              const ItemPointer &new_location) = 0;
 
   virtual void PerformUpdate(TransactionContext *const current_txn,
-                             const ItemPointer &location) = 0;
+                             const ItemPointer &location,
+                             const TargetList *target_list = nullptr) = 0;
 
   virtual void PerformDelete(TransactionContext *const current_txn,
                              const ItemPointer &location) = 0;
@@ -15,6 +15,11 @@
 #include "executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
 namespace executor {
 
 /**
@@ -39,6 +44,11 @@ class InsertExecutor : public AbstractExecutor {
 
  private:
   bool done_ = false;
+
+  // tile group that the tuples of the child are bulk loaded into, and the
+  // first of its tuples that is not inserted into the indexes yet
+  storage::TileGroup *bulk_tile_group_ = nullptr;
+  oid_t bulk_tuple_start_ = 0;
 };
 
 }  // namespace executor
@@ -718,10 +718,13 @@ class ExpressionUtil {
                expr_type == ExpressionType::COMPARE_LESSTHANOREQUALTO ||
                expr_type == ExpressionType::COMPARE_GREATERTHAN ||
                expr_type == ExpressionType::COMPARE_GREATERTHANOREQUALTO) {
-      // The right child should be a constant.
+      // The left child should be a column, and the right child should be a
+      // constant.
+      auto left_child = expr->GetModifiableChild(0);
       auto right_child = expr->GetModifiableChild(1);
 
-      if (right_child->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+      if (left_child->GetExpressionType() == ExpressionType::VALUE_TUPLE &&
+          right_child->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
         auto right_exp = (const expression::ConstantValueExpression
                               *)(expr->GetModifiableChild(1));
         auto predicate_val = right_exp->GetValue();
@@ -32,6 +32,8 @@ namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
+#define MAX_ALL_VISIBLE_SWEEP_LENGTH 100
+#define MAX_COMPACTION_SWEEP_LENGTH 100
 
 class TransactionLevelGCManager : public GCManager {
  public:
@@ -66,6 +68,9 @@ class TransactionLevelGCManager : public GCManager {
     reclaim_maps_.clear();
     reclaim_maps_.resize(gc_thread_count_);
     recycle_queue_map_.clear();
+    all_visible_cursor_ = START_OID;
+    compaction_cursor_ = START_OID;
+    compacted_tile_groups_.clear();
 
     is_running_ = false;
   }
@@ -129,6 +134,17 @@ class TransactionLevelGCManager : public GCManager {
 
   int Reclaim(const int &thread_id, const eid_t &expired_eid);
 
+  // Mark the tile groups whose versions were all committed before the
+  // expired epoch as all-visible, so that scans skip their visibility checks.
+  // Every call continues where the previous one stopped.
+  int SetAllVisible(const eid_t &expired_eid);
+
+  // Compact the full tile groups in which the share of live tuples is below
+  // the tile_group_compaction_threshold setting, and drop the compacted tile
+  // groups whose versions are all reclaimed. Every call continues where the
+  // previous one stopped.
+  int CompactTileGroups(const eid_t &expired_eid);
+
  private:
   inline unsigned int HashToThread(const size_t &thread_id) {
     return (unsigned int)thread_id % gc_thread_count_;
@@ -186,6 +202,16 @@ class TransactionLevelGCManager : public GCManager {
   std::unordered_map<oid_t,
                      std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>>
       recycle_queue_map_;
+
+  // the id of the next tile group to mark all-visible
+  oid_t all_visible_cursor_ = START_OID;
+
+  // the id of the next tile group to check for compaction
+  oid_t compaction_cursor_ = START_OID;
+
+  // the compacted tile groups that are not dropped yet, and the epoch in
+  // which they were made immutable
+  std::unordered_map<oid_t, eid_t> compacted_tile_groups_;
 };
 }
 }  // namespace peloton
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <thread>
 
@@ -55,6 +56,25 @@ class CheckpointManager {
 
   virtual void StopCheckpointing() {}
 
+  virtual void SetDirectory(const std::string &checkpoint_dir UNUSED_ATTRIBUTE) {}
+
+  // Set the interval between two checkpoints in seconds
+  virtual void SetCheckpointInterval(const int interval UNUSED_ATTRIBUTE) {}
+
+  // Set the format of the checkpoint files
+  virtual void SetCheckpointFormat(
+      const CheckpointFormatType format UNUSED_ATTRIBUTE) {}
+
+  // Take a checkpoint synchronously. Returns the epoch id of the checkpoint
+  virtual eid_t DoCheckpoint() { return INVALID_EID; }
+
+  // Load the latest checkpoint. The log must be replayed from the returned
+  // epoch id
+  virtual eid_t DoCheckpointRecovery() { return INVALID_EID; }
+
+  // Get the epoch id of the latest durable checkpoint
+  virtual eid_t GetCheckpointEpochId() { return INVALID_EID; }
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
@@ -48,6 +48,12 @@ public:
 
   inline size_t GetEpochId() { return eid_; }
 
+  // re-tag an empty buffer with the epoch of the transaction being logged.
+  inline void SetEpochId(const size_t eid) {
+    PELOTON_ASSERT(size_ == 0);
+    eid_ = eid;
+  }
+
   inline size_t GetThreadId() { return thread_id_; }
 
   inline bool Empty() { return size_ == 0; }
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <thread>
 
@@ -22,6 +23,11 @@
 #include "common/internal_types.h"
 
 namespace peloton {
+
+namespace concurrency {
+class TransactionContext;
+}  // namespace concurrency
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
@@ -61,14 +67,54 @@ class LogManager {
 
   virtual size_t GetTableCount() { return 0; }
 
-  virtual void LogBegin() {}
+  virtual void SetDirectory(const std::string &logging_dir UNUSED_ATTRIBUTE) {}
+
+  // Set what the transactions are logged as. Must be called before logging
+  // starts
+  virtual void SetLoggingMode(const LoggingModeType mode UNUSED_ATTRIBUTE) {}
+
+  virtual LoggingModeType GetLoggingMode() { return LoggingModeType::TUPLE; }
+
+  // Get the largest epoch id whose log records are all durable
+  virtual eid_t GetPersistEpochId() { return INVALID_EID; }
+
+  // Replay the durable log records from begin_eid with the given number of
+  // threads. Returns the largest recovered epoch id
+  virtual eid_t DoRecovery(const size_t thread_count UNUSED_ATTRIBUTE,
+                           const eid_t begin_eid UNUSED_ATTRIBUTE = INVALID_EID) {
+    return INVALID_EID;
+  }
+
+  // Remove the log files of the epochs before eid, which are covered by a
+  // checkpoint
+  virtual void TruncateLogs(const eid_t eid UNUSED_ATTRIBUTE) {}
+
+  virtual void LogBegin(const cid_t &commit_id UNUSED_ATTRIBUTE) {}
 
-  virtual void LogEnd() {}
+  // Returns the epoch the transaction has been logged in, or INVALID_EID if
+  // nothing has been logged
+  virtual eid_t LogEnd() { return INVALID_EID; }
+
+  // Block until the log records of the given epoch are durable
+  virtual void WaitForPersistence(const eid_t eid UNUSED_ATTRIBUTE) {}
+
+  // Log the prepared statements executed by the committing transaction
+  // instead of its tuples. Returns false if the transaction has to be logged
+  // tuple by tuple
+  virtual bool LogCommands(
+      const concurrency::TransactionContext *txn UNUSED_ATTRIBUTE) {
+    return false;
+  }
 
   virtual void LogInsert(const ItemPointer & UNUSED_ATTRIBUTE) {}
-  
-  virtual void LogUpdate(const ItemPointer & UNUSED_ATTRIBUTE) {}
-  
+
+  // Log an update. updated_columns holds the sorted ids of the modified
+  // columns, or is nullptr if all the columns are modified
+  virtual void LogUpdate(
+      const ItemPointer &old_version UNUSED_ATTRIBUTE,
+      const ItemPointer &new_version UNUSED_ATTRIBUTE,
+      const std::vector<oid_t> *updated_columns UNUSED_ATTRIBUTE = nullptr) {}
+
   virtual void LogDelete(const ItemPointer & UNUSED_ATTRIBUTE) {}
 
  protected:
@@ -12,11 +12,18 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/internal_types.h"
 #include "common/item_pointer.h"
 #include "common/macros.h"
 
 namespace peloton {
+
+namespace type {
+class Value;
+}  // namespace type
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
@@ -30,6 +37,10 @@ private:
             const eid_t epoch_id, const cid_t commit_id)
     : log_record_type_(log_type), 
       tuple_pos_(pos), 
+      old_tuple_pos_(INVALID_ITEMPOINTER),
+      updated_columns_(nullptr),
+      statement_id_(INVALID_OID),
+      params_(nullptr),
       eid_(epoch_id), 
       cid_(commit_id) {}
 
@@ -44,8 +55,33 @@ public:
 
   inline void SetCommitId(const cid_t commit_id) { cid_ = commit_id; }
 
+  inline void SetOldItemPointer(const ItemPointer &pos) { old_tuple_pos_ = pos; }
+
+  inline void SetUpdatedColumns(const std::vector<oid_t> *column_ids) {
+    updated_columns_ = column_ids;
+  }
+
+  inline void SetCommand(const oid_t statement_id,
+                         const std::vector<type::Value> *params) {
+    statement_id_ = statement_id;
+    params_ = params;
+  }
+
   inline const ItemPointer &GetItemPointer() { return tuple_pos_; }
 
+  // location of the version that is replaced by an update
+  inline const ItemPointer &GetOldItemPointer() { return old_tuple_pos_; }
+
+  // sorted ids of the columns modified by an update,
+  // or nullptr if all the columns are modified
+  inline const std::vector<oid_t> *GetUpdatedColumns() { return updated_columns_; }
+
+  // id of the logged prepared statement in the statement file
+  inline oid_t GetStatementId() { return statement_id_; }
+
+  // parameters the prepared statement has been executed with
+  inline const std::vector<type::Value> *GetParams() { return params_; }
+
   inline eid_t GetEpochId() { return eid_; }
 
   inline cid_t GetCommitId() { return cid_; }
@@ -55,6 +91,14 @@ private:
 
   ItemPointer tuple_pos_;
 
+  ItemPointer old_tuple_pos_;
+
+  const std::vector<oid_t> *updated_columns_;
+
+  oid_t statement_id_;
+
+  const std::vector<type::Value> *params_;
+
   eid_t eid_;
 
   cid_t cid_;
@@ -70,12 +114,31 @@ public:
     return LogRecord(log_type, pos, INVALID_EID, INVALID_CID);
   }
 
+  static LogRecord CreateTupleRecord(const LogRecordType log_type,
+                                     const ItemPointer &old_pos,
+                                     const ItemPointer &new_pos,
+                                     const std::vector<oid_t> *updated_columns = nullptr) {
+    PELOTON_ASSERT(log_type == LogRecordType::TUPLE_UPDATE);
+    LogRecord record(log_type, new_pos, INVALID_EID, INVALID_CID);
+    record.SetOldItemPointer(old_pos);
+    record.SetUpdatedColumns(updated_columns);
+    return record;
+  }
+
   static LogRecord CreateTxnRecord(const LogRecordType log_type, const cid_t commit_id) {
     PELOTON_ASSERT(log_type == LogRecordType::TRANSACTION_BEGIN || 
               log_type == LogRecordType::TRANSACTION_COMMIT);
     return LogRecord(log_type, INVALID_ITEMPOINTER, INVALID_EID, commit_id);
   }
 
+  static LogRecord CreateCommandRecord(const oid_t statement_id,
+                                       const std::vector<type::Value> *params) {
+    LogRecord record(LogRecordType::COMMAND, INVALID_ITEMPOINTER, INVALID_EID,
+                     INVALID_CID);
+    record.SetCommand(statement_id, params);
+    return record;
+  }
+
   static LogRecord CreateEpochRecord(const LogRecordType log_type, const eid_t epoch_id) {
     PELOTON_ASSERT(log_type == LogRecordType::EPOCH_BEGIN || 
               log_type == LogRecordType::EPOCH_END);
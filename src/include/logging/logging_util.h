@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_util.h
+//
+// Identification: src/include/logging/logging_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// LoggingUtil
+//===--------------------------------------------------------------------===//
+
+class LoggingUtil {
+ public:
+  //===--------------------------------------------------------------------===//
+  // DIRECTORY
+  //===--------------------------------------------------------------------===//
+
+  static bool CreateDirectory(const char *dir_name, int mode);
+
+  static bool CheckDirectoryExistence(const char *dir_name);
+
+  static bool RemoveDirectory(const char *dir_name, bool only_remove_file);
+
+  // get the names of all the files under the directory.
+  static bool GetDirectoryList(const char *dir_name,
+                               std::vector<std::string> &file_names);
+
+  //===--------------------------------------------------------------------===//
+  // FILE
+  //===--------------------------------------------------------------------===//
+
+  static bool OpenFile(const char *name, const char *mode,
+                       FileHandle &file_handle);
+
+  static bool CloseFile(FileHandle &file_handle);
+
+  static bool IsFileTruncated(FileHandle &file_handle, size_t size_to_read);
+
+  static size_t GetFileSize(FileHandle &file_handle);
+
+  static bool ReadNBytesFromFile(FileHandle &file_handle, void *bytes_read,
+                                 size_t n);
+
+  // flush the stdio buffer and force the content to the disk.
+  static void FFlushFsync(FileHandle &file_handle);
+
+  static bool RemoveFile(const char *name);
+
+  // get the epoch id of a file whose name is laid out as
+  // prefix + "_" + id + "_" + epoch_id.
+  // returns INVALID_EID if the name does not follow this layout.
+  static eid_t GetEpochIdFromFileName(const std::string &file_name,
+                                      const std::string &prefix);
+};
+
+}  // namespace logging
+}  // namespace peloton
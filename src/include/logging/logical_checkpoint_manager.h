@@ -12,15 +12,80 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "logging/checkpoint_manager.h"
+#include "type/serializeio.h"
 
 namespace peloton {
+
+namespace concurrency {
+class TransactionContext;
+}  // namespace concurrency
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
+namespace type {
+class AbstractPool;
+}  // namespace type
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
 // logical checkpoint Manager
 //===--------------------------------------------------------------------===//
 
+/**
+ * checkpoint file name layout :
+ *
+ * dir_name + "/" + prefix + "_" + checkpointer_id + "_" + epoch_id
+ *
+ * checkpoint epoch file name layout :
+ *
+ * dir_name + "/" + "cepoch"
+ *
+ *
+ * checkpoint file layout :
+ *
+ *  ---------------------------------------------------------------------
+ *  | format | tile group | tile group | ... | tile group |
+ *  ---------------------------------------------------------------------
+ *
+ * in the ROW format, each tile group is serialized as :
+ *
+ *  | database_id | table_id | tile_group_id | tuple_count | tuple ... |
+ *
+ * and each tuple as :
+ *
+ *  | tuple_offset | begin_commit_id | data |
+ *
+ * in the BINARY format, the tuples are stored in the in-memory row layout
+ * of the table, so that they are loaded with a copy per run of consecutive
+ * tuple slots. each tile group is serialized as :
+ *
+ *  | database_id | table_id | tile_group_id | tuple_count | run_count |
+ *  | (begin_tuple_offset, tuple_count) ... | tuple_length |
+ *  | begin_commit_id ... | tuple data ... | uninlined data ... |
+ *
+ * the uninlined data holds the length and the bytes of every uninlined
+ * column of every tuple, in tuple order.
+ *
+ * NOTE: a checkpoint is a fuzzy snapshot. it holds every transaction that
+ * has been logged in an epoch before the checkpoint epoch, and possibly
+ * some later ones. the log must be replayed from the checkpoint epoch.
+ *
+ * NOTE: a checkpoint is only valid once its epoch has been appended to the
+ * checkpoint epoch file.
+ *
+ */
+
 class LogicalCheckpointManager : public CheckpointManager {
  public:
   LogicalCheckpointManager(const LogicalCheckpointManager &) = delete;
@@ -28,7 +93,13 @@ class LogicalCheckpointManager : public CheckpointManager {
   LogicalCheckpointManager(LogicalCheckpointManager &&) = delete;
   LogicalCheckpointManager &operator=(LogicalCheckpointManager &&) = delete;
 
-  LogicalCheckpointManager(const int thread_count) : checkpointer_thread_count_(thread_count) {}
+  LogicalCheckpointManager(const int thread_count)
+      : checkpointer_thread_count_(thread_count),
+        checkpoint_dir_("./checkpoint"),
+        checkpoint_interval_(30),
+        checkpoint_format_(CheckpointFormatType::BINARY),
+        checkpoint_thread_(nullptr),
+        checkpoint_epoch_id_(INVALID_EID) {}
 
   virtual ~LogicalCheckpointManager() {}
 
@@ -37,23 +108,121 @@ class LogicalCheckpointManager : public CheckpointManager {
     return checkpoint_manager;
   }
 
-  virtual void Reset() { is_running_ = false; }
+  virtual void Reset() override { is_running_ = false; }
+
+  // set the directory of the checkpoint files.
+  // must be called before checkpointing starts.
+  virtual void SetDirectory(const std::string &checkpoint_dir) override;
+
+  const std::string &GetDirectory() const { return checkpoint_dir_; }
+
+  virtual void SetCheckpointInterval(const int interval) override {
+    checkpoint_interval_ = interval;
+  }
+
+  // set the format of the checkpoints taken from now on.
+  // the recovery reads the format of every checkpoint file.
+  virtual void SetCheckpointFormat(const CheckpointFormatType format) override {
+    checkpoint_format_ = format;
+  }
+
+  CheckpointFormatType GetCheckpointFormat() const {
+    return checkpoint_format_;
+  }
+
+  std::string GetCheckpointFileFullPath(const size_t checkpointer_id,
+                                        const eid_t epoch_id) const {
+    return checkpoint_dir_ + "/" + checkpoint_filename_prefix_ + "_" +
+           std::to_string(checkpointer_id) + "_" + std::to_string(epoch_id);
+  }
+
+  std::string GetCheckpointEpochFileFullPath() const {
+    return checkpoint_dir_ + "/" + cepoch_filename_;
+  }
+
+  virtual void StartCheckpointing(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) override {
+    StartCheckpointing();
+  }
+
+  virtual void StartCheckpointing() override;
+
+  virtual void StopCheckpointing() override;
+
+  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
+
+  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
+
+  virtual size_t GetTableCount() override { return 0; }
+
+  virtual eid_t DoCheckpoint() override;
+
+  virtual eid_t DoCheckpointRecovery() override;
+
+  virtual eid_t GetCheckpointEpochId() override {
+    return checkpoint_epoch_id_.load();
+  }
+
+ private:
+  void Run();
+
+  // write the visible tuples of every checkpointer_count-th tile group,
+  // starting from the checkpointer_id-th one.
+  bool CheckpointTileGroups(
+      const std::vector<std::shared_ptr<storage::TileGroup>> &tile_groups,
+      concurrency::TransactionContext *txn, const size_t checkpointer_id,
+      const eid_t epoch_id);
+
+  void SerializeRowTileGroup(storage::TileGroup *tile_group,
+                             const std::vector<oid_t> &tuple_slots,
+                             CopySerializeOutput &output);
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) {}
+  void SerializeBinaryTileGroup(storage::TileGroup *tile_group,
+                                const std::vector<oid_t> &tuple_slots,
+                                CopySerializeOutput &output);
 
-  virtual void StartLogging() {}
+  // load the tuples in a checkpoint file back to their tile groups.
+  void RecoverCheckpointFile(const std::string &file_name,
+                             size_t &tuple_count, oid_t &max_tile_group_id);
 
-  virtual void StopLogging() {}
+  // get the tile group to recover. the tile group is added to the table if
+  // it does not exist yet. returns nullptr if it cannot be resolved.
+  storage::TileGroup *ResolveTileGroup(const oid_t database_id,
+                                       const oid_t table_id,
+                                       const oid_t tile_group_id);
 
-  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  void RecoverRowTuples(ReferenceSerializeInput &input,
+                        storage::TileGroup *tile_group,
+                        const oid_t tuple_count, type::AbstractPool *pool);
 
-  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  bool RecoverBinaryTuples(ReferenceSerializeInput &input,
+                           storage::TileGroup *tile_group,
+                           const oid_t tuple_count);
 
-  virtual size_t GetTableCount() { return 0; }
+  // get the last epoch recorded in the checkpoint epoch file.
+  eid_t ReadCheckpointEpochId();
+
+  // remove the checkpoint files of the epochs before epoch_id.
+  void RemoveCheckpoints(const eid_t epoch_id);
 
  private:
   int checkpointer_thread_count_;
 
+  std::string checkpoint_dir_;
+
+  // interval between two checkpoints in seconds
+  int checkpoint_interval_;
+
+  CheckpointFormatType checkpoint_format_;
+
+  std::unique_ptr<std::thread> checkpoint_thread_;
+
+  // serializes the background checkpoints and the ones taken on demand.
+  std::mutex checkpoint_mutex_;
+
+  std::atomic<eid_t> checkpoint_epoch_id_;
+
+  const std::string checkpoint_filename_prefix_ = "checkpoint";
+  const std::string cepoch_filename_ = "cepoch";
 };
 
 }  // namespace logging
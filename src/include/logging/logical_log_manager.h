@@ -12,7 +12,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "logging/log_manager.h"
+#include "logging/log_record.h"
+#include "logging/logical_log_recovery.h"
+#include "logging/logical_logger.h"
+#include "logging/worker_context.h"
 
 namespace peloton {
 namespace logging {
@@ -24,8 +38,12 @@ namespace logging {
 
 /**
  * logging file name layout :
- * 
- * dir_name + "/" + prefix + "_" + epoch_id
+ *
+ * dir_name + "/" + prefix + "_" + logger_id + "_" + epoch_id
+ *
+ * persistent epoch file name layout :
+ *
+ * dir_name + "/" + "pepoch"
  *
  *
  * logging file layout :
@@ -34,10 +52,44 @@ namespace logging {
  *  | txn_id | database_id | table_id | operation_type | data | ... | txn_end_flag
  *  -----------------------------------------------------------------------------
  *
+ * each record is serialized as :
+ *
+ *  | record_length (4B) | record_type (1B) | commit_id (8B) | payload |
+ *
+ * where the payload of a tuple record is :
+ *
+ *  | database_id | table_id | tile_group_id | tuple_offset | data |
+ *
+ * an update record additionally carries the location of the old version,
+ * and only holds the columns that have been modified :
+ *
+ *  | ... | old_tile_group_id | old_tuple_offset | column_count |
+ *  | column_id ... | data |
+ *
+ * a delete record carries no data.
+ *
+ * in the COMMAND logging mode, a transaction that only executed prepared
+ * statements with parameters is logged as a command record per statement
+ * rather than its tuple records. the payload of a command record is :
+ *
+ *  | statement_id | param_count | (param_type (1B), param_value) ... |
+ *
+ * the statements are recorded once in the statement file :
+ *
+ * dir_name + "/" + "statements"
+ *
+ * where each entry is serialized as :
+ *
+ *  | entry_length (4B) | statement_id | database_name | query |
+ *
  * NOTE: this layout is designed for logical logging.
  *
  * NOTE: tuple length can be obtained from the table schema.
  *
+ * NOTE: the records of a transaction are only valid if its commit record
+ * has been persisted, and the transaction's epoch is no larger than the
+ * last epoch recorded in the pepoch file.
+ *
  */
 
 class LogicalLogManager : public LogManager {
@@ -47,7 +99,15 @@ class LogicalLogManager : public LogManager {
   LogicalLogManager(LogicalLogManager &&) = delete;
   LogicalLogManager &operator=(LogicalLogManager &&) = delete;
 
-  LogicalLogManager(const int thread_count) : logger_thread_count_(thread_count) {}
+  LogicalLogManager(const int thread_count)
+      : logger_thread_count_(thread_count),
+        worker_count_(0),
+        logging_dir_("./logging"),
+        logging_mode_(LoggingModeType::TUPLE),
+        pepoch_thread_(nullptr),
+        is_pepoch_running_(false),
+        persist_epoch_id_(INVALID_EID),
+        is_pepoch_stopped_(true) {}
 
   virtual ~LogicalLogManager() {}
 
@@ -56,40 +116,35 @@ class LogicalLogManager : public LogManager {
     return log_manager;
   }
 
-  // virtual void SetDirectories(const std::vector<std::string> &logging_dirs) override {
-  //   logger_dirs_ = logging_dirs;
+  // set the directory of the log files. must be called before logging starts.
+  virtual void SetDirectory(const std::string &logging_dir) override;
 
-  //   if (logging_dirs.size() > 0) {
-  //     pepoch_dir_ = logging_dirs.at(0);
-  //   }
-  //   // check the existence of logging directories.
-  //   // if not exists, then create the directory.
-  //   for (auto logging_dir : logging_dirs) {
-  //     if (LoggingUtil::CheckDirectoryExistence(logging_dir.c_str()) == false) {
-  //       LOG_INFO("Logging directory %s is not accessible or does not exist", logging_dir.c_str());
-  //       bool res = LoggingUtil::CreateDirectory(logging_dir.c_str(), 0700);
-  //       if (res == false) {
-  //         LOG_ERROR("Cannot create directory: %s", logging_dir.c_str());
-  //       }
-  //     }
-  //   }
+  const std::string &GetDirectory() const { return logging_dir_; }
 
-  //   logger_count_ = logging_dirs.size();
-  //   for (size_t i = 0; i < logger_count_; ++i) {
-  //     loggers_.emplace_back(new PhyLogLogger(i, logging_dirs.at(i)));
-  //   }
-  // }
+  std::string GetPepochFileFullPath() const {
+    return logging_dir_ + "/" + pepoch_filename_;
+  }
+
+  std::string GetStatementFileFullPath() const {
+    return logging_dir_ + "/" + statement_filename_;
+  }
 
-  // virtual const std::vector<std::string> &GetDirectories() override {
-  //   return logger_dirs_;
-  // }
+  // set what the transactions are logged as. must be called before logging
+  // starts.
+  virtual void SetLoggingMode(const LoggingModeType mode) override {
+    PELOTON_ASSERT(is_running_ == false);
+    logging_mode_ = mode;
+  }
 
+  virtual LoggingModeType GetLoggingMode() override { return logging_mode_; }
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) override {}
+  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) override {
+    StartLogging();
+  }
 
-  virtual void StartLogging() override {}
+  virtual void StartLogging() override;
 
-  virtual void StopLogging() override {}
+  virtual void StopLogging() override;
 
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
@@ -97,32 +152,90 @@ class LogicalLogManager : public LogManager {
 
   virtual size_t GetTableCount() override { return 0; }
 
-  virtual void LogBegin() override {}
+  virtual eid_t GetPersistEpochId() override { return persist_epoch_id_.load(); }
+
+  // recover the database from the log files in the logging directory,
+  // starting from begin_eid. must be called before logging starts.
+  virtual eid_t DoRecovery(const size_t thread_count,
+                           const eid_t begin_eid = INVALID_EID) override;
+
+  virtual void TruncateLogs(const eid_t eid) override;
+
+  const RecoveryStats &GetRecoveryStats() const { return recovery_stats_; }
+
+  // register the calling thread as a logging worker.
+  void RegisterWorker();
+
+  // deregister the calling thread. its pending records are discarded.
+  void DeregisterWorker();
+
+  virtual void LogBegin(const cid_t &commit_id) override;
+
+  virtual bool LogCommands(
+      const concurrency::TransactionContext *txn) override;
+
+  virtual eid_t LogEnd() override;
+
+  // block until the pepoch file covers eid, or logging is stopped.
+  virtual void WaitForPersistence(const eid_t eid) override;
 
-  virtual void LogEnd() override {}
+  virtual void LogInsert(const ItemPointer &tuple_pos) override;
 
-  virtual void LogInsert(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
-  virtual void LogUpdate(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
-  virtual void LogDelete(const ItemPointer & UNUSED_ATTRIBUTE) override { }
+  virtual void LogUpdate(
+      const ItemPointer &old_version, const ItemPointer &new_version,
+      const std::vector<oid_t> *updated_columns = nullptr) override;
+
+  virtual void LogDelete(const ItemPointer &tuple_pos) override;
+
+ private:
+  // serialize the record and append it to the worker's log buffer.
+  void WriteRecordToBuffer(WorkerContext *worker_ctx, LogRecord &record);
+
+  // get an empty log buffer for the worker without waiting for the logger.
+  std::unique_ptr<LogBuffer> AcquireLogBuffer(WorkerContext *worker_ctx);
+
+  // get the id of a prepared statement in the statement file.
+  // the statement is appended to the file if it is not recorded yet.
+  // returns INVALID_OID if the statement cannot be recorded.
+  oid_t GetStatementId(const std::string &database_name,
+                       const std::string &query);
+
+  // publish the largest epoch that has been persisted by all the loggers.
+  void RunPepochLogger();
+
+  void UpdatePersistEpoch(FileHandle &file_handle);
 
  private:
   int logger_thread_count_;
 
-  // std::atomic<oid_t> worker_count_;
+  std::atomic<oid_t> worker_count_;
+
+  std::string logging_dir_;
+
+  std::vector<std::shared_ptr<LogicalLogger>> loggers_;
+
+  LoggingModeType logging_mode_;
 
-  // std::vector<std::string> logger_dirs_;
+  // ids of the statements in the statement file, indexed by database name
+  // and query string.
+  std::mutex statement_mutex_;
+  std::map<std::pair<std::string, std::string>, oid_t> statement_ids_;
+  FileHandle statement_file_handle_;
 
-  // std::vector<std::shared_ptr<PhyLogLogger>> loggers_;
+  std::unique_ptr<std::thread> pepoch_thread_;
+  volatile bool is_pepoch_running_;
 
-  // std::unique_ptr<std::thread> pepoch_thread_;
-  // volatile bool is_running_;
+  std::atomic<eid_t> persist_epoch_id_;
 
-  // std::string pepoch_dir_;
+  // wakes up the transactions waiting for their epoch to be persisted.
+  std::mutex persist_mutex_;
+  std::condition_variable persist_cv_;
+  bool is_pepoch_stopped_;
 
-  // const std::string pepoch_filename_ = "pepoch";
+  RecoveryStats recovery_stats_;
 
+  const std::string pepoch_filename_ = "pepoch";
+  const std::string statement_filename_ = "statements";
 };
 
 }  // namespace logging
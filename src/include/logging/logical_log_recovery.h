@@ -0,0 +1,290 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_recovery.h
+//
+// Identification: src/include/logging/logical_log_recovery.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+
+namespace peloton {
+
+class Statement;
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
+namespace type {
+class AbstractPool;
+}  // namespace type
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Recovery Stats
+//===--------------------------------------------------------------------===//
+
+struct RecoveryStats {
+  // number of log files and bytes that have been read
+  size_t file_count = 0;
+  size_t byte_count = 0;
+
+  // number of committed transactions and tuple records that are replayed
+  size_t txn_count = 0;
+  size_t record_count = 0;
+
+  // updates that only hold the modified columns
+  size_t delta_record_count = 0;
+
+  // records whose table or tile group cannot be resolved
+  size_t skipped_record_count = 0;
+
+  // prepared statements that are re-executed, and the ones that fail
+  size_t command_count = 0;
+  size_t failed_command_count = 0;
+
+  // elapsed time of every phase in milliseconds
+  double read_time_ms = 0;
+  double replay_time_ms = 0;
+  double index_time_ms = 0;
+
+  double GetTotalTimeMs() const {
+    return read_time_ms + replay_time_ms + index_time_ms;
+  }
+
+  // number of tuple records recovered per second, end to end.
+  double GetThroughput() const {
+    auto total_time_ms = GetTotalTimeMs();
+    if (total_time_ms == 0) {
+      return 0;
+    }
+    return record_count * 1000.0 / total_time_ms;
+  }
+};
+
+//===--------------------------------------------------------------------===//
+// Logged Statement
+//===--------------------------------------------------------------------===//
+
+// a prepared statement recorded in the statement file of the command log.
+struct LoggedStatement {
+  oid_t statement_id;
+  std::string database_name;
+  std::string query;
+};
+
+//===--------------------------------------------------------------------===//
+// Logical Log Recovery
+//===--------------------------------------------------------------------===//
+
+/**
+ * Replays the log files written by the LogicalLogManager.
+ *
+ * The log files are processed in batches. Each batch is read with large
+ * sequential reads and parsed by all the recovery threads in parallel;
+ * only the records of transactions that have a commit record and whose
+ * epoch is no larger than the persistent epoch are kept. The records are
+ * partitioned by tile group, so that every tile group is replayed by a
+ * single thread without any synchronization. The TileGroup recovery
+ * functions compare commit ids, so the records of a slot can be applied
+ * in any order.
+ *
+ * An update record only holds the columns it modifies, so its new version is
+ * built from the old version. These records are replayed once all the other
+ * records of the batch have been replayed. The updates that share a slot,
+ * which may be reused once its version is reclaimed, are replayed by a
+ * single thread in commit order. The old versions of the updates are
+ * invalidated last.
+ *
+ * Indexes are not maintained while replaying. Once all the batches have
+ * been replayed, the latest version of every recovered tuple, including
+ * the tuples loaded from a checkpoint, is inserted into the indexes of its
+ * table, with the tile groups spread across the recovery threads.
+ *
+ * The transactions logged as commands are replayed in commit order with the
+ * tuple records: they split the tuple records of a batch into segments, and
+ * each of them is re-executed once the records that precede it have been
+ * replayed and indexed, by running its prepared statements with the logged
+ * parameters in a new transaction. This is only correct as long as the
+ * statements are deterministic.
+ */
+class LogicalLogRecovery {
+ public:
+  LogicalLogRecovery(const std::string &log_dir, const size_t thread_count)
+      : log_dir_(log_dir),
+        thread_count_(thread_count == 0 ? 1 : thread_count),
+        recovered_tile_groups_(thread_count_) {}
+
+  ~LogicalLogRecovery() {}
+
+  // recover the database from the log files whose epoch is no smaller than
+  // begin_eid, and rebuild the indexes of all the tables.
+  // returns the largest epoch that has been recovered.
+  eid_t Recover(const eid_t begin_eid = INVALID_EID);
+
+  const RecoveryStats &GetStats() const { return stats_; }
+
+  // read the prepared statements recorded in a statement file.
+  // a partially written entry at the tail of the file is ignored.
+  static std::vector<LoggedStatement> ReadStatementFile(
+      const std::string &file_name);
+
+ private:
+  // a tuple operation of a committed transaction.
+  // the update of a tuple is split into the insertion of the new version
+  // and the invalidation of the old version, which may belong to different
+  // tile groups.
+  struct ReplayRecord {
+    cid_t commit_id;
+    LogRecordType type;
+    oid_t database_id;
+    oid_t table_id;
+    ItemPointer location;
+    // location of the new version, for the old version of an update
+    ItemPointer new_location;
+    // location of the old version, for the new version of an update
+    ItemPointer old_location;
+    // serialized column values, for inserted tuples and new versions.
+    // the values of a new version are preceded by the modified column ids.
+    const char *data;
+    size_t data_size;
+  };
+
+  // a prepared statement executed by a committed transaction.
+  // the parameters are copied out of the file data, which is released
+  // after every batch.
+  struct CommandRecord {
+    cid_t commit_id;
+    // position of the statement in its transaction
+    size_t sequence;
+    oid_t statement_id;
+    std::string params;
+  };
+
+  struct LogFile {
+    std::string file_name;
+    eid_t epoch_id;
+    size_t file_size;
+  };
+
+  // records of a batch, indexed by parse thread and replay partition.
+  typedef std::vector<std::vector<std::vector<ReplayRecord>>> PartitionedRecords;
+
+  // get the last epoch recorded in the pepoch file.
+  eid_t ReadPersistEpochId();
+
+  // list the log files whose epoch is in [begin_eid, persist_eid].
+  std::vector<LogFile> ListLogFiles(const eid_t begin_eid,
+                                    const eid_t persist_eid);
+
+  void ReadBatch(const std::vector<LogFile> &files, const size_t begin,
+                 const size_t end,
+                 std::vector<std::unique_ptr<char[]>> &file_data,
+                 PartitionedRecords &partitions);
+
+  void ParseLogFile(const char *data, const size_t size,
+                    std::vector<std::vector<ReplayRecord>> &partitions,
+                    std::vector<CommandRecord> &commands, size_t &txn_count);
+
+  // replay the records of a partition. the new versions and the old
+  // versions of the updates are deferred.
+  void ReplayPartition(const size_t partition_id,
+                       PartitionedRecords &partitions, size_t &record_count,
+                       size_t &skipped_count,
+                       std::vector<ReplayRecord> &new_versions,
+                       std::vector<ReplayRecord> &old_versions);
+
+  // build the new versions of the updates from their old versions.
+  void ReplayNewVersions(std::vector<std::vector<ReplayRecord>> &new_versions,
+                         size_t &record_count, size_t &delta_count,
+                         size_t &skipped_count);
+
+  void ReplayNewVersion(const ReplayRecord &record, type::AbstractPool *pool,
+                        size_t &record_count, size_t &delta_count,
+                        size_t &skipped_count);
+
+  // invalidate the old versions of the updates.
+  void ReplayOldVersions(const size_t partition_id,
+                         const std::vector<ReplayRecord> &old_versions,
+                         size_t &skipped_count);
+
+  // get the tile group of a record. the tile group is added to its table if
+  // it does not exist yet. returns nullptr if the table cannot be found.
+  storage::TileGroup *ResolveTileGroup(const size_t partition_id,
+                                       const ReplayRecord &record);
+
+  // take the records of the partitions whose commit id is smaller than
+  // end_cid.
+  PartitionedRecords SplitRecords(PartitionedRecords &partitions,
+                                  const cid_t end_cid);
+
+  // replay the records of the partitions with all the recovery threads.
+  // returns false if there is no record to replay.
+  bool ReplayRecords(PartitionedRecords &&partitions);
+
+  // re-execute the prepared statements of the transaction logged as commands
+  // that starts at command_itr, and move command_itr past them.
+  void ReplayCommands(size_t &command_itr);
+
+  // make the new transactions and tile groups follow the recovered ones.
+  void PrepareNewTransactions(const eid_t max_eid);
+
+  // index the latest versions of every table, or only the ones of the
+  // recovered tile groups.
+  void RebuildIndexes(const bool all_tables);
+
+  void RebuildTileGroupIndexes(
+      const std::vector<std::shared_ptr<storage::TileGroup>> &tile_groups,
+      const size_t thread_id);
+
+  inline size_t GetPartitionId(const oid_t tile_group_id) const {
+    return tile_group_id % thread_count_;
+  }
+
+ private:
+  std::string log_dir_;
+
+  size_t thread_count_;
+
+  RecoveryStats stats_;
+
+  // prepared statements of the transactions of the batch that are logged
+  // as commands.
+  std::vector<CommandRecord> commands_;
+
+  // the statement file is read before replaying the first command.
+  bool statement_file_read_ = false;
+  std::unordered_map<oid_t, LoggedStatement> logged_statements_;
+
+  // every statement is planned once.
+  std::unordered_map<oid_t, std::shared_ptr<Statement>> statements_;
+
+  // tile groups touched by every replay partition.
+  // the value is nullptr if the tile group cannot be resolved.
+  std::vector<std::unordered_map<oid_t, std::shared_ptr<storage::TileGroup>>>
+      recovered_tile_groups_;
+
+  // a batch is flushed once it holds this many bytes of log data.
+  static const size_t batch_size_ = 256 * 1024 * 1024;
+
+  const std::string pepoch_filename_ = "pepoch";
+  const std::string statement_filename_ = "statements";
+};
+
+}  // namespace logging
+}  // namespace peloton
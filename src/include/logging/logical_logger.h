@@ -12,137 +12,108 @@
 
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
 #include <thread>
-#include <list>
-#include <stack>
 #include <unordered_map>
+#include <vector>
 
-#include "concurrency/transaction_context.h"
-#include "concurrency/epoch_manager.h"
+#include "common/internal_types.h"
+#include "common/logger.h"
+#include "common/synchronization/spin_latch.h"
 #include "logging/log_buffer.h"
-#include "logging/log_record.h"
-#include "logging/log_buffer_pool.h"
-#include "logging/log_manager.h"
 #include "logging/worker_context.h"
-#include "type/types.h"
-#include "common/serializer.h"
-#include "common/lockfree_queue.h"
-#include "common/logger.h"
-#include "common/pool.h"
-#include "common/synchronization/spin_lock.h"
 
 namespace peloton {
-  
-namespace storage {
-  class TileGroupHeader;
-}
-
 namespace logging {
 
-  class PhyLogLogger {
-
-  public:
-    PhyLogLogger(const size_t &logger_id, const std::string &log_dir) :
-      logger_id_(logger_id),
-      log_dir_(log_dir),
-      logger_thread_(nullptr),
-      is_running_(false),
-      logger_output_buffer_(), 
-      persist_epoch_id_(INVALID_EID),
-      worker_map_lock_(), 
-      worker_map_() {}
-
-    ~PhyLogLogger() {}
-
-    void StartRecovery(const size_t checkpoint_eid, const size_t persist_eid, const size_t recovery_thread_count);
-    void StartIndexRebulding(const size_t logger_count);
-
-    void WaitForRecovery();
-    void WaitForIndexRebuilding();
-
-    void StartLogging() {
-      is_running_ = true;
-      logger_thread_.reset(new std::thread(&PhyLogLogger::Run, this));
-    }
+//===--------------------------------------------------------------------===//
+// Logical Logger
+//===--------------------------------------------------------------------===//
+
+/**
+ * A logger persists the log buffers of the workers registered to it.
+ *
+ * The logger wakes up once per epoch, collects the buffers of every epoch
+ * that has been closed since its last round, appends them to the per-epoch
+ * log files and forces the files to disk with a single fsync per file.
+ * The cost of the fsync is thus amortized over all the transactions that
+ * committed in the epoch (group commit).
+ */
+class LogicalLogger {
+ public:
+  LogicalLogger(const size_t logger_id, const std::string &log_dir)
+      : logger_id_(logger_id),
+        log_dir_(log_dir),
+        logger_thread_(nullptr),
+        is_running_(false),
+        persist_epoch_id_(INVALID_EID) {}
+
+  ~LogicalLogger() {}
+
+  void StartLogging() {
+    is_running_ = true;
+    logger_thread_.reset(new std::thread(&LogicalLogger::Run, this));
+  }
 
-    void StopLogging() {
-      is_running_ = false;
-      logger_thread_->join();
-    }
+  // stop the logger thread. all the buffered records are persisted before
+  // this function returns.
+  void StopLogging() {
+    is_running_ = false;
+    logger_thread_->join();
+    logger_thread_.reset();
+  }
 
-    void RegisterWorker(WorkerContext *phylog_worker_ctx);
-    void DeregisterWorker(WorkerContext *phylog_worker_ctx);
+  void RegisterWorker(std::shared_ptr<WorkerContext> worker_ctx);
 
-    size_t GetPersistEpochId() const {
-      return persist_epoch_id_;
-    }
+  void DeregisterWorker(WorkerContext *worker_ctx);
 
+  inline eid_t GetPersistEpochId() const { return persist_epoch_id_.load(); }
 
-private:
-  void Run();
+  inline size_t GetLoggerId() const { return logger_id_; }
 
-  void PersistEpochBegin(FileHandle &file_handle, const size_t epoch_id);
-  void PersistEpochEnd(FileHandle &file_handle, const size_t epoch_id);
-  void PersistLogBuffer(FileHandle &file_handle, std::unique_ptr<LogBuffer> log_buffer);
+  inline void SetDirectory(const std::string &log_dir) { log_dir_ = log_dir; }
 
-  std::string GetLogFileFullPath(size_t epoch_id) {
-    return log_dir_ + "/" + logging_filename_prefix_ + "_" + std::to_string(logger_id_) + "_" + std::to_string(epoch_id);
+  std::string GetLogFileFullPath(const eid_t epoch_id) const {
+    return log_dir_ + "/" + GetLogFilePrefix() + "_" +
+           std::to_string(logger_id_) + "_" + std::to_string(epoch_id);
   }
 
-  void GetSortedLogFileIdList(const size_t checkpoint_eid, const size_t persist_eid);
-  
-  void RunRecoveryThread(const size_t thread_id, const size_t checkpoint_eid, const size_t persist_eid);
-
-  void RunSecIndexRebuildThread(const size_t logger_count);
-
-  void RebuildSecIndexForTable(const size_t logger_count, storage::DataTable *table);
-
-  bool ReplayLogFile(const size_t thread_id, FileHandle &file_handle, size_t checkpoint_eid, size_t pepoch_eid);
-  bool InstallTupleRecord(LogRecordType type, storage::Tuple *tuple, storage::DataTable *table, cid_t cur_cid);
-
-  // Return value is the swapped txn id, either INVALID_TXNID or INITIAL_TXNID
-  txn_id_t LockTuple(storage::TileGroupHeader *tg_header, oid_t tuple_offset);
-  void UnlockTuple(storage::TileGroupHeader *tg_header, oid_t tuple_offset, txn_id_t new_txn_id);
-
-  private:
-    size_t logger_id_;
-    std::string log_dir_;
+  static const std::string &GetLogFilePrefix() {
+    static const std::string logging_filename_prefix = "log";
+    return logging_filename_prefix;
+  }
 
-    // recovery threads
-    std::vector<std::unique_ptr<std::thread>> recovery_threads_;
-    std::vector<size_t> file_eids_;
-    std::atomic<int> max_replay_file_id_;
+ private:
+  void Run();
 
-    /* Recovery */
-    // TODO: Check if we can discard the recovery pool after the recovery is done.
-    // Since every thing is copied to the tile group and tile group related pool
-    std::vector<std::unique_ptr<VarlenPool>> recovery_pools_;
-    
-    // logger thread
-    std::unique_ptr<std::thread> logger_thread_;
-    volatile bool is_running_;
+  // persist all the log buffers whose epoch is no larger than upper_eid.
+  void PersistEpochs(const eid_t upper_eid);
 
-    /* File system related */
-    CopySerializeOutput logger_output_buffer_;
+  // hand a persisted buffer back to the pool of the worker that owns it.
+  void ReturnLogBuffer(std::unique_ptr<LogBuffer> log_buffer);
 
-    /* Log buffers */
-    size_t persist_epoch_id_;
+ private:
+  size_t logger_id_;
 
-    // The spin lock to protect the worker map.
-    // We only update this map when creating/terminating a new worker
-    common::synchronization::SpinLatch worker_map_lock_;
+  std::string log_dir_;
 
-    // map from worker id to the worker's context.
-    std::unordered_map<oid_t, std::shared_ptr<WorkerContext>> worker_map_;
-  
-    const std::string logging_filename_prefix_ = "log";
+  // logger thread
+  std::unique_ptr<std::thread> logger_thread_;
+  volatile bool is_running_;
 
-    const size_t sleep_period_us_ = 40000;
+  // every record in an epoch no larger than this epoch is durable.
+  std::atomic<eid_t> persist_epoch_id_;
 
-    const int new_file_interval_ = 500; // 500 milliseconds.
-  };
+  // The spin latch to protect the worker map.
+  // We only update this map when creating/terminating a new worker
+  common::synchronization::SpinLatch worker_map_lock_;
 
+  // map from worker id to the worker's context.
+  std::unordered_map<oid_t, std::shared_ptr<WorkerContext>> worker_map_;
+};
 
-}
-}
\ No newline at end of file
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// worker_context.h
+//
+// Identification: src/include/logging/worker_context.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+#include "logging/log_buffer.h"
+#include "logging/log_buffer_pool.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Worker Context
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-worker logging state. Each worker thread that commits transactions
+ * owns exactly one context. The worker appends serialized records into
+ * its current log buffer, and hands full buffers over to its logger
+ * through per_epoch_buffers. The logger only touches this structure
+ * while holding the latch, and the worker holds the latch for the
+ * whole duration of logging a single transaction, so a logger never
+ * observes a partially logged transaction.
+ */
+struct WorkerContext {
+  WorkerContext(const oid_t worker_id, const size_t logger_id)
+      : worker_id(worker_id),
+        logger_id(logger_id),
+        buffer_pool(worker_id),
+        current_buffer(nullptr),
+        current_eid(INVALID_EID),
+        current_cid(INVALID_CID),
+        current_record_count(0),
+        output_buffer() {}
+
+  ~WorkerContext() {}
+
+  // id of the worker that owns this context.
+  oid_t worker_id;
+
+  // id of the logger that persists the log buffers of this worker.
+  size_t logger_id;
+
+  // protects current_buffer and per_epoch_buffers.
+  common::synchronization::SpinLatch latch;
+
+  // buffers that are recycled by the logger after persisting them.
+  LogBufferPool buffer_pool;
+
+  // buffer the worker is currently appending records to.
+  std::unique_ptr<LogBuffer> current_buffer;
+
+  // full buffers that are waiting to be persisted, indexed by epoch.
+  std::map<eid_t, std::vector<std::unique_ptr<LogBuffer>>> per_epoch_buffers;
+
+  // epoch and commit id of the transaction that is being logged.
+  // current_cid is INVALID_CID when no transaction is being logged.
+  eid_t current_eid;
+  cid_t current_cid;
+
+  // number of records logged for the current transaction.
+  size_t current_record_count;
+
+  // scratch space for serializing a single record.
+  CopySerializeOutput output_buffer;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(WorkerContext);
+};
+
+}  // namespace logging
+}  // namespace peloton
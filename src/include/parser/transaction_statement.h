@@ -20,7 +20,8 @@ namespace parser {
 
 /**
  * @class TransactionStatement
- * @brief Represents "BEGIN or COMMIT or ROLLBACK [TRANSACTION]"
+ * @brief Represents "BEGIN [READ ONLY | READ WRITE] or COMMIT or ROLLBACK
+ * [TRANSACTION]"
  */
 class TransactionStatement : public SQLStatement {
  public:
@@ -30,6 +31,14 @@ class TransactionStatement : public SQLStatement {
     kRollback,
   };
 
+  // Access mode of a BEGIN. A BEGIN without one takes the default of the
+  // session.
+  enum AccessMode {
+    kDefaultAccess,
+    kReadOnly,
+    kReadWrite,
+  };
+
   TransactionStatement(CommandType type)
       : SQLStatement(StatementType::TRANSACTION), type(type) {}
 
@@ -40,6 +49,8 @@ class TransactionStatement : public SQLStatement {
   const std::string GetInfo() const override;
 
   CommandType type;
+
+  AccessMode access_mode = kDefaultAccess;
 };
 
 }  // namespace parser
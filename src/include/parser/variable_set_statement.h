@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "common/logger.h"
@@ -21,14 +22,13 @@
 
 namespace peloton {
 namespace parser {
-/* TODO(Yuchen): Do not support VariableSetStatement yet
+/* TODO(Yuchen): Most of the variables are not supported yet.
  * When JDBC starts connection, it will send SET statement and need server's
  * response to build the connection.
  * Add VariableSetStatement here so it can be handled by the parser to avoid
  * connection error.
- * Actually after parsing stage, the statement will not be processed by the
- * server.
- * It will be skipped. See HardcodedExecuteFilter()
+ * Only the session variables known to the TrafficCop (synchronous_commit)
+ * take effect, the others are skipped. See HardcodedExecuteFilter()
  */
 class VariableSetStatement : public SQLStatement {
  public:
@@ -36,6 +36,12 @@ class VariableSetStatement : public SQLStatement {
   virtual ~VariableSetStatement() {}
 
   virtual void Accept(UNUSED_ATTRIBUTE SqlNodeVisitor *v) override {}
+
+  // name of the variable, empty for RESET ALL
+  std::string name;
+
+  // value of the variable, empty for SET ... TO DEFAULT or RESET
+  std::string value;
 };
 }  // namespace parser
 }  // namespace peloton
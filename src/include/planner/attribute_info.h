@@ -18,6 +18,11 @@
 #include "common/internal_types.h"
 
 namespace peloton {
+
+namespace storage {
+class StringDictionary;
+}  // namespace storage
+
 namespace planner {
 
 // Describes an attribute that is passed around in the query plan
@@ -29,6 +34,9 @@ struct AttributeInfo {
   // The name of this attribute. This isn't always available, so no one should
   // rely on its existence.
   std::string name;
+  // The dictionary of the codes of the strings, if the attribute is read
+  // straight from a dictionary-encoded varchar column
+  const storage::StringDictionary *dictionary = nullptr;
 };
 
 }  // namespace planner
@@ -82,6 +82,16 @@ class ProjectInfo {
                 const AbstractTuple *tuple2,
                 executor::ExecutorContext *econtext) const;
 
+  // Evaluate only the target list. The columns of the direct map are left
+  // as they are in dest.
+  bool EvaluateTargets(AbstractTuple *dest, const AbstractTuple *tuple1,
+                       const AbstractTuple *tuple2,
+                       executor::ExecutorContext *econtext) const;
+
+  // True if the direct map copies columns of the first input into the same
+  // columns, as in the projection of an update
+  bool IsIdentityDirectMap() const;
+
   std::string Debug() const;
 
   std::unique_ptr<const ProjectInfo> Copy() const {
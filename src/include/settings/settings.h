@@ -110,12 +110,45 @@ SETTING_int(connection_thread_count,
             1, 64,
             false, false)
 
+// Number of tile groups that concurrent inserters spread over per table
+SETTING_int(active_tile_group_count,
+            "Number of active tile groups per table, 0 for one per connection thread (default: 0)",
+            0,
+            0, 256,
+            false, false)
+
+// Huge pages are used for the tiles whose data takes at least 2 MB
+SETTING_bool(huge_page_tile_data,
+             "Back the data of tiles of 2 MB or more with huge pages (default: false)",
+             false,
+             true, true)
+
+SETTING_bool(numa_aware_allocation,
+             "Allocate the data of tiles on the NUMA node of the inserting thread (default: false)",
+             false,
+             true, true)
+
 SETTING_int(gc_num_threads,
             "The number of Garbage collection threads to run",
             1,
             1, 128,
             true, true)
 
+// Share of live tuples below which a full tile group is compacted by the GC
+SETTING_double(tile_group_compaction_threshold,
+               "Share of live tuples below which a tile group is compacted, 0 disables compaction (default: 0)",
+               0.0,
+               0.0, 1.0,
+               true, true)
+
+// Updates of the tables created with it on only write the updated columns to
+// the new versions, and read the other columns from the older versions until
+// the GC copies them over
+SETTING_bool(delta_versions,
+             "Store only the updated columns in the new versions of tuples (default: false)",
+             false,
+             true, true)
+
 SETTING_bool(parallel_execution,
              "Enable parallel execution of queries (default: true)",
              true,
@@ -127,10 +160,93 @@ SETTING_int(min_parallel_table_scan_size,
             1, std::numeric_limits<int32_t>::max(),
             true, true)
 
+// Transactions are read-only unless they are begun with BEGIN READ WRITE.
+// Can be overridden per session with SET default_transaction_read_only
+SETTING_bool(default_transaction_read_only,
+             "Begin transactions as read-only snapshot transactions (default: false)",
+             false,
+             true, false)
+
+// Bound on the wait for a write lock held by a younger transaction, when the
+// transaction manager is configured with the WAIT conflict avoidance policy
+SETTING_int(conflict_wait_timeout,
+            "Microseconds an older transaction waits for a locked tuple before it aborts (default: 1000)",
+            1000,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+// Enable or disable write ahead logging
+SETTING_bool(logging,
+             "Enable write ahead logging (default: false)",
+             false,
+             false, false)
+
+// Number of logger threads
+SETTING_int(logging_thread_count,
+            "Number of logger threads (default: 1)",
+            1,
+            1, 64,
+            false, false)
+
+// Directory of the log files
+SETTING_string(log_directory,
+               "The directory of the log files (default: ./logging)",
+               "./logging",
+               false, false)
+
+// What the transactions are logged as
+SETTING_string(logging_mode,
+               "Log the modified tuples or the executed prepared statements, tuple or command (default: tuple)",
+               "tuple",
+               false, false)
+
+// Wait for the log records of a transaction to be durable before its commit
+// returns. Can be overridden per session with SET synchronous_commit
+SETTING_bool(synchronous_commit,
+             "Wait for the commit records to be flushed to disk (default: true)",
+             true,
+             true, false)
+
+//===----------------------------------------------------------------------===//
+// CHECKPOINT
+//===----------------------------------------------------------------------===//
+
+// Enable or disable checkpointing
+SETTING_bool(checkpointing,
+             "Enable checkpointing (default: false)",
+             false,
+             false, false)
+
+// Number of checkpointer threads
+SETTING_int(checkpointing_thread_count,
+            "Number of checkpointer threads (default: 1)",
+            1,
+            1, 64,
+            false, false)
+
+// Interval between two checkpoints
+SETTING_int(checkpoint_interval,
+            "Interval between two checkpoints in seconds (default: 30)",
+            30,
+            1, std::numeric_limits<int32_t>::max(),
+            false, false)
+
+// Directory of the checkpoint files
+SETTING_string(checkpoint_directory,
+               "The directory of the checkpoint files (default: ./checkpoint)",
+               "./checkpoint",
+               false, false)
+
+// Format of the checkpoint files
+SETTING_string(checkpoint_format,
+               "The format of the checkpoint files, row or binary (default: binary)",
+               "binary",
+               false, false)
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
@@ -156,12 +272,35 @@ SETTING_bool(index_tuner,
             false,
             true, true)
 
-// Enable or disable layout tuner
+// Enable or disable layout tuner. The tables created while it is enabled
+// are tuned, frozen and evicted by it.
 SETTING_bool(layout_tuner,
-            "Enable layout tuner (default: false)",
+            "Enable layout tuner for the tables created while it is enabled (default: false)",
             false,
             true, true)
 
+// Time that the tuples of a tile group must not be modified before the
+// layout tuner freezes it
+SETTING_int(tile_group_freeze_interval,
+            "Seconds without modification before a tile group is frozen and compressed, 0 disables freezing (default: 300)",
+            300,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
+// Memory of tile data above which the layout tuner evicts frozen tile groups
+SETTING_int(tile_group_memory_budget,
+            "MB of tile data above which frozen tile groups are evicted to the local SSD, 0 disables eviction (default: 0)",
+            0,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
+// Number of threads that read evicted tile groups back in ahead of scans
+SETTING_int(prefetch_worker_pool_size,
+            "Prefetch Worker Pool Size (default: 2)",
+            2,
+            1, 16,
+            false, false)
+
 //===----------------------------------------------------------------------===//
 // BRAIN
 //===----------------------------------------------------------------------===//
@@ -12,7 +12,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <mutex>
+#include <unordered_map>
 
 #include "common/synchronization/spin_latch.h"
 #include "common/internal_types.h"
@@ -54,9 +57,46 @@ class BackendManager {
 
   size_t GetClflushCount() const { return clflush_count; }
 
-  size_t GetAllocationCount() const { return allocation_count; }
+  size_t GetAllocationCount() const { return allocation_count.load(); }
+
+  size_t GetMappedAllocationCount();
+
+  // Write data that is evicted from memory to a file on the given backend,
+  // SSD or HDD, and return the offset of the data in the file
+  size_t WriteEvicted(BackendType type, const char *data, size_t size);
+
+  // Read evicted data back from the file
+  void ReadEvicted(BackendType type, size_t offset, char *data, size_t size);
+
+  // Free the space of evicted data in the file
+  void ReleaseEvicted(BackendType type, size_t offset, size_t size);
 
  private:
+  // A file that holds the data evicted to an SSD or HDD. The file is
+  // unlinked once it is created, so it goes away with the process.
+  struct EvictionFile {
+    int fd = -1;
+
+    // end of the used part of the file
+    size_t end_offset = 0;
+
+    // offsets of the free blocks of the file, by size
+    std::multimap<size_t, size_t> free_blocks;
+  };
+
+  // The eviction file of a backend, created on first use. Must be called
+  // with the eviction file lock held.
+  EvictionFile &GetEvictionFile(BackendType type);
+
+  // Map the memory of an allocation on its own, backed by huge pages and/or
+  // placed on the NUMA node of the calling thread. Huge pages are only asked
+  // for allocations of at least one huge page. Returns nullptr if the memory
+  // can not be mapped.
+  void *AllocateMapped(size_t size, bool huge_pages, bool numa_aware);
+
+  // Unmap the memory if it was mapped by AllocateMapped()
+  bool ReleaseMapped(void *address);
+
   // data file address
   void *data_file_address;
 
@@ -74,7 +114,17 @@ class BackendManager {
 
   size_t clflush_count = 0;
 
-  size_t allocation_count = 0;
+  std::atomic<size_t> allocation_count{0};
+
+  // the size of each allocation that has its own mapping
+  std::unordered_map<void *, size_t> mapped_allocations;
+
+  common::synchronization::SpinLatch mapped_allocation_lock;
+
+  // eviction files of the SSD and HDD backends
+  EvictionFile eviction_files[2];
+
+  std::mutex eviction_file_lock;
 };
 
 }  // namespace storage
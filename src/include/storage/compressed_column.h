@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.h
+//
+// Identification: src/include/storage/compressed_column.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+enum class ColumnEncoding : uint32_t {
+  // the values are stored as they are in a tile
+  NONE = 0,
+  // the offsets of the values from the minimum value, packed into as few
+  // bits as the largest offset needs
+  FRAME_OF_REFERENCE = 1,
+  // the values of runs of equal values, and the end of each run
+  RUN_LENGTH = 2,
+};
+
+/**
+ * @brief The values of a column of a frozen tile group, compressed with a
+ * lightweight encoding.
+ *
+ * Only the columns of fixed-length integer, timestamp and date types are
+ * compressed. The values are encoded as the integers that are stored in the
+ * tile, including the values that represent NULL, so that the column can be
+ * decompressed into the exact bytes that were compressed.
+ *
+ * A frame-of-reference column is decoded by reading the eight bytes that
+ * hold the bits of a value, so the packed data is padded with a word at the
+ * end, and the bit width is at most max_bit_width_.
+ */
+class CompressedColumn {
+ public:
+  // Compress the column of a tile. Returns nullptr if the type of the
+  // column is not compressed, or the compressed column would not be smaller
+  // than the tile column.
+  static std::unique_ptr<CompressedColumn> Compress(type::TypeId type_id,
+                                                    const char *column,
+                                                    uint32_t stride,
+                                                    uint32_t tuple_count);
+
+  static bool IsCompressedType(type::TypeId type_id);
+
+  ColumnEncoding GetEncoding() const { return encoding_; }
+
+  type::TypeId GetTypeId() const { return type_id_; }
+
+  // The integer that is stored in the tile for a tuple
+  int64_t GetRawValue(oid_t tuple_id) const {
+    PELOTON_ASSERT(tuple_id < tuple_count_);
+    if (encoding_ == ColumnEncoding::FRAME_OF_REFERENCE) {
+      uint64_t bit_offset = static_cast<uint64_t>(tuple_id) * bit_width_;
+      uint64_t word;
+      PELOTON_MEMCPY(&word, packed_data_.get() + bit_offset / 8, sizeof(word));
+      return reference_ +
+             static_cast<int64_t>((word >> (bit_offset % 8)) & GetMask());
+    }
+    return GetRunValue(tuple_id);
+  }
+
+  type::Value GetValue(oid_t tuple_id) const;
+
+  // Write the bytes that are stored in the tile for a tuple
+  void CopyValue(oid_t tuple_id, char *location) const;
+
+  // Write the bytes of all tuples into the column of a tile
+  void Decompress(char *column, uint32_t stride) const;
+
+  //===--------------------------------------------------------------------===//
+  // Frame-of-reference decoding, for the scans of generated code
+  //===--------------------------------------------------------------------===//
+
+  const char *GetPackedData() const { return packed_data_.get(); }
+
+  int64_t GetReference() const { return reference_; }
+
+  uint32_t GetBitWidth() const { return bit_width_; }
+
+  // Size of the compressed values in bytes
+  size_t GetSize() const;
+
+  static const uint32_t max_bit_width_ = 56;
+
+ private:
+  CompressedColumn(type::TypeId type_id, uint32_t tuple_count);
+
+  uint64_t GetMask() const { return (uint64_t(1) << bit_width_) - 1; }
+
+  int64_t GetRunValue(oid_t tuple_id) const;
+
+  static int64_t ReadRawValue(const char *location, uint32_t value_size);
+
+  static void WriteRawValue(char *location, uint32_t value_size,
+                            int64_t value);
+
+  type::TypeId type_id_;
+
+  // size of a value in the tile
+  uint32_t value_size_;
+
+  uint32_t tuple_count_;
+
+  ColumnEncoding encoding_;
+
+  // frame of reference
+  int64_t reference_ = 0;
+
+  uint32_t bit_width_ = 0;
+
+  size_t packed_size_ = 0;
+
+  std::unique_ptr<char[]> packed_data_;
+
+  // run length. a run ends before the tuple id in run_ends_.
+  std::vector<oid_t> run_ends_;
+
+  std::vector<int64_t> run_values_;
+};
+
+}  // namespace storage
+}  // namespace peloton
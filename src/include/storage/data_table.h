@@ -34,6 +34,9 @@
 
 extern std::vector<peloton::oid_t> sdbench_column_ids;
 
+// Number of evicted tile groups that a scan reads back in ahead of itself
+#define EVICTED_TILE_GROUP_PREFETCH_COUNT 4
+
 namespace peloton {
 
 namespace tuning {
@@ -137,6 +140,20 @@ class DataTable : public AbstractTable {
                    concurrency::TransactionContext *transaction,
                    ItemPointer **index_entry_ptr, bool check_fk = true);
 
+  // bulk load. the tuples are written into tile groups that only the load
+  // inserts into, and are then inserted into the indexes and recorded as
+  // inserts of the transaction a whole tile group at a time.
+
+  // add a tile group that only the calling bulk load inserts into.
+  TileGroup *AddBulkLoadTileGroup();
+
+  // insert the tuples in the slots [tuple_start, tuple_end) of a bulk load
+  // tile group. the keys of each index are sorted before they are inserted.
+  // returns false if a constraint is violated.
+  bool BulkInsertTuples(TileGroup *tile_group, const oid_t &tuple_start,
+                        const oid_t &tuple_end,
+                        concurrency::TransactionContext *transaction);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -146,7 +163,8 @@ class DataTable : public AbstractTable {
 
   void AddTileGroup(const std::shared_ptr<TileGroup> &tile_group);
 
-  // Offset is a 0-based number local to the table
+  // Offset is a 0-based number local to the table. The tile group is nullptr
+  // if it has been dropped after compaction.
   std::shared_ptr<storage::TileGroup> GetTileGroup(
       const std::size_t &tile_group_offset) const;
 
@@ -211,9 +229,49 @@ class DataTable : public AbstractTable {
   // TRANSFORMERS
   //===--------------------------------------------------------------------===//
 
+  // Rewrite a cold tile group into the default layout of the table, and
+  // swap it in the storage manager while the table is live. Returns nullptr
+  // if the layout differs by less than theta, or the tile group is still
+  // being inserted into or has versions that are not committed and live.
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  // Rewrite a cold tile group whose versions were all committed before
+  // cold_epoch_id into the column layout, and compress its columns. Returns
+  // nullptr if the tile group is already frozen, or is not cold.
+  storage::TileGroup *FreezeTileGroup(const oid_t &tile_group_offset,
+                                      const eid_t &cold_epoch_id);
+
+  // Rewrite a frozen tile group, and write the data of its tiles to the
+  // eviction file on the local SSD. Only the header, zone map and uninlined
+  // data of the copy stay in memory, and its tiles are read back in when
+  // they are accessed. Returns nullptr if the tile group is not frozen, or is
+  // not cold anymore.
+  storage::TileGroup *EvictTileGroup(const oid_t &tile_group_offset);
+
+  // Read the tiles of an evicted tile group back in the background, ahead
+  // of a scan that reaches it
+  void PrefetchTileGroup(const oid_t &tile_group_offset);
+
+  // Move the live tuples of a full tile group, in which at most
+  // live_tuple_ratio of the slots hold live tuples, into other tile groups as
+  // updates of a transaction. The tile group is made immutable first, so that
+  // its slots are not reused. An immutable tile group is compacted again
+  // without checking its tuple count. Returns false if the tile group is not
+  // sparse, or a tuple could not be moved.
+  bool CompactTileGroup(const oid_t &tile_group_id,
+                        const double &live_tuple_ratio);
+
+  // Drop a compacted tile group once the GC has reclaimed all of its
+  // versions. Its offset in the table is not reused. Returns false if some
+  // of its versions are not reclaimed yet.
+  bool DropCompactedTileGroup(const oid_t &tile_group_id);
+
+  // Updates of a table with delta versions only write the updated columns to
+  // the new versions. Set from the delta_versions setting when the table is
+  // created.
+  bool UsesDeltaVersions() const { return delta_versions_; }
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -282,6 +340,12 @@ class DataTable : public AbstractTable {
                        concurrency::TransactionContext *transaction,
                        ItemPointer **index_entry_ptr);
 
+  // insert a recovered tuple into all indexes without checking the
+  // uniqueness constraints, which are guaranteed by the log.
+  // returns the indirection pointer that holds the location.
+  ItemPointer *InsertInIndexesFromRecovery(const AbstractTuple *tuple,
+                                           ItemPointer location);
+
   inline static size_t GetActiveTileGroupCount() {
     return default_active_tilegroup_count_;
   }
@@ -331,8 +395,27 @@ class DataTable : public AbstractTable {
   // tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // get the active tile group the calling thread inserts into first.
+  size_t GetActiveTileGroupId() const;
+
+  // allocate the successor of the active_tile_group_id-th active tile group
+  // ahead of time, so that it is installed without allocating memory.
+  void PreallocateTileGroup(const size_t &active_tile_group_id);
+
+  // add a tile group to the table, and install it as the
+  // active_tile_group_id-th active tile group in place of full_tile_group.
+  oid_t InstallTileGroup(const size_t &active_tile_group_id,
+                         TileGroup *full_tile_group);
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  // copy a cold tile group into the given layout, and swap the copy in the
+  // storage manager. the copy is frozen if freeze is true, and evicted if
+  // evict is true.
+  storage::TileGroup *MigrateTileGroup(
+      const std::shared_ptr<TileGroup> &tile_group,
+      const std::shared_ptr<const Layout> &layout, bool freeze, bool evict);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
@@ -345,6 +428,9 @@ class DataTable : public AbstractTable {
                                 concurrency::TransactionContext *transaction,
                                 ItemPointer *index_entry_ptr);
 
+  // allocate the indirection that the index entries of a new tuple point to
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const AbstractTuple *tuple,
                                   concurrency::TransactionContext *transaction);
@@ -387,7 +473,14 @@ class DataTable : public AbstractTable {
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
-  std::vector<std::shared_ptr<storage::TileGroup>> active_tile_groups_;
+  // the tile groups that tuples are inserted into. a full tile group is
+  // replaced with a CAS, so that inserters never wait on a latch. the tile
+  // groups are owned by the storage manager.
+  std::unique_ptr<std::atomic<storage::TileGroup *>[]> active_tile_groups_;
+
+  // successors of the active tile groups that are allocated ahead of time.
+  // they are owned by the table until they are installed.
+  std::unique_ptr<std::atomic<storage::TileGroup *>[]> preallocated_tile_groups_;
 
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
@@ -422,6 +515,9 @@ class DataTable : public AbstractTable {
   // adapt table
   bool adapt_table_ = true;
 
+  // new versions only hold the updated columns
+  bool delta_versions_ = false;
+
   // samples for layout tuning
   std::vector<tuning::Sample> layout_samples_;
 
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// delta_record.h
+//
+// Identification: src/include/storage/delta_record.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace storage {
+
+/**
+ * @brief The columns written to a version by an update of a table with
+ * delta versions.
+ *
+ * The update only writes the columns it changes to the slot of the new
+ * version. The other columns are inherited from the older version that it
+ * replaces, and are read from there, until the GC copies them into the slot
+ * of the new version before it reclaims the older version. The record is
+ * folded from then on, and the slot holds every column.
+ */
+class DeltaRecord {
+ public:
+  DeltaRecord(const ItemPointer &older_location, oid_t column_count)
+      : older_location_(older_location),
+        stored_columns_(column_count, false),
+        folded_(false) {}
+
+  // The version the columns that are not stored are read from
+  inline const ItemPointer &GetOlderLocation() const {
+    return older_location_;
+  }
+
+  // Only the transaction that owns the version stores columns into it
+  inline void SetStored(oid_t column_id) {
+    PELOTON_ASSERT(column_id < stored_columns_.size());
+    stored_columns_[column_id] = true;
+  }
+
+  inline bool IsInherited(oid_t column_id) const {
+    PELOTON_ASSERT(column_id < stored_columns_.size());
+    return stored_columns_[column_id] == false && IsFolded() == false;
+  }
+
+  inline bool IsFolded() const {
+    return folded_.load(std::memory_order_acquire);
+  }
+
+  // Returns false if the record was already folded
+  inline bool SetFolded() {
+    return folded_.exchange(true, std::memory_order_acq_rel) == false;
+  }
+
+ private:
+  ItemPointer older_location_;
+
+  std::vector<bool> stored_columns_;
+
+  std::atomic<bool> folded_;
+};
+
+}  // namespace storage
+}  // namespace peloton
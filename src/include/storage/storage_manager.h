@@ -16,6 +16,7 @@
 #include <atomic>
 #include "common/container/cuckoo_map.h"
 #include "common/internal_types.h"
+#include "common/synchronization/spin_latch.h"
 #include "storage/tile_group.h"
 
 namespace peloton {
@@ -113,6 +114,18 @@ class StorageManager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Get the tile group without taking a reference to it. A dropped tile
+  // group is only freed once the epoch it is dropped in has expired, so the
+  // pointer remains valid until the calling transaction ends. Returns
+  // nullptr if the tile group does not exist.
+  inline storage::TileGroup *GetTileGroupPtr(const oid_t oid) const {
+    auto block = tile_group_blocks_[oid >> tile_group_block_bits_].load();
+    if (block == nullptr) {
+      return nullptr;
+    }
+    return block[oid & (tile_group_block_size_ - 1)].load();
+  }
+
   void ClearTileGroup(void);
 
  private:
@@ -134,6 +147,31 @@ class StorageManager {
 
   CuckooMap<oid_t, std::shared_ptr<storage::TileGroup>> tile_group_locator_;
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
+
+  //===--------------------------------------------------------------------===//
+  // Data members for raw tile group lookups
+  //===--------------------------------------------------------------------===//
+
+  // set the raw pointer of a tile group, allocating its block if needed.
+  void SetTileGroupPtr(const oid_t oid, storage::TileGroup *tile_group);
+
+  // keep a dropped tile group alive until its epoch has expired, and free
+  // the tile groups whose epoch has expired.
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group);
+
+  // a dense array of the tile groups, indexed by tile group id. it is split
+  // into blocks that are allocated on demand, and freed with the manager.
+  static const size_t tile_group_block_bits_ = 16;
+  static const size_t tile_group_block_size_ = 1UL << tile_group_block_bits_;
+  static const size_t tile_group_block_count_ =
+      (1UL << (sizeof(oid_t) * 8)) >> tile_group_block_bits_;
+  std::atomic<std::atomic<storage::TileGroup *> *>
+      tile_group_blocks_[tile_group_block_count_];
+
+  // dropped tile groups and the epoch they are dropped in.
+  common::synchronization::SpinLatch retired_tile_group_latch_;
+  std::vector<std::pair<eid_t, std::shared_ptr<storage::TileGroup>>>
+      retired_tile_groups_;
 };
 
 }  // namespace
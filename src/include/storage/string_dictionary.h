@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.h
+//
+// Identification: src/include/storage/string_dictionary.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "common/synchronization/readwrite_latch.h"
+#include "type/arena_pool.h"
+#include "type/value.h"
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace storage {
+
+/**
+ * @brief The distinct strings of a dictionary-encoded varchar column, and
+ * the integer code of each of them.
+ *
+ * Every string that is written to a dictionary-encoded column is interned,
+ * so the tiles of the column only hold pointers to the entries of the
+ * dictionary. An entry is laid out as
+ *
+ *   [int32_t code][uint32_t length][bytes]
+ *
+ * and the tiles point to the length, so an entry is read like any other
+ * varlen, and the code of a string in a tile is found right in front of it.
+ * Two strings of the column are equal iff their codes are equal.
+ *
+ * Entries are only ever added, and live as long as the dictionary, so the
+ * GC does not free the strings of a dictionary-encoded column. The
+ * dictionary is meant for columns with few distinct values.
+ */
+class StringDictionary {
+ public:
+  StringDictionary() = default;
+
+  DISALLOW_COPY_AND_MOVE(StringDictionary);
+
+  // The varlen of the string in the dictionary. The string is added if it is
+  // not in the dictionary yet.
+  const char *Intern(const char *data, uint32_t length);
+
+  // Write a value into the storage of a tuple, like Value::SerializeTo()
+  void SerializeTo(const type::Value &value, char *storage);
+
+  // The code of a string, or invalid_code_ if it is not in the dictionary
+  int32_t GetCode(const char *data, uint32_t length) const;
+
+  // The varlen of a code, or nullptr if no string has the code
+  const char *GetVarlen(int32_t code) const;
+
+  // The code of the string of a varlen in the dictionary
+  static int32_t GetCode(const char *varlen) {
+    return *reinterpret_cast<const int32_t *>(varlen - sizeof(int32_t));
+  }
+
+  // Number of distinct strings in the dictionary
+  size_t GetStringCount() const;
+
+  // Codes are assigned from 1, so that a zeroed code is never a valid one
+  static const int32_t invalid_code_ = -1;
+
+ private:
+  struct StringKey {
+    const char *data;
+    uint32_t length;
+
+    bool operator==(const StringKey &other) const {
+      return length == other.length &&
+             (length == 0 || std::memcmp(data, other.data, length) == 0);
+    }
+  };
+
+  struct StringKeyHasher {
+    size_t operator()(const StringKey &key) const {
+      return HashUtil::HashBytes(key.data, key.length);
+    }
+  };
+
+  // the entries of the strings, indexed by the code minus one
+  std::vector<const char *> entries_;
+
+  // the varlen of each string. the keys point into the entries.
+  std::unordered_map<StringKey, const char *, StringKeyHasher> varlens_;
+
+  // memory of the entries, which are never freed
+  type::ArenaPool pool_;
+
+  mutable common::synchronization::ReadWriteLatch latch_;
+};
+
+}  // namespace storage
+}  // namespace peloton
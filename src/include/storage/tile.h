@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "catalog/manager.h"
@@ -117,6 +119,15 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  // Release the inlined data of a tile whose values are kept compressed by
+  // a frozen tile group, and allocate it again when the tile is thawed.
+  void ReleaseData();
+
+  void AllocateData();
+
+  // Bytes of inlined data allocated by all tiles
+  static size_t GetResidentDataSize() { return resident_data_size; }
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -141,6 +152,15 @@ class Tile : public Printable {
 
   inline oid_t GetColumnCount() const { return column_count; };
 
+  // The columns of the table that the columns of the tile hold
+  void SetTableColumnIds(const std::vector<oid_t> &column_ids) {
+    table_column_ids = column_ids;
+  }
+
+  // True if the column is not stored in the tuple slot, as it holds a
+  // version that inherits the column from an older version
+  bool IsInherited(const oid_t tuple_offset, const oid_t column_id) const;
+
   inline TileGroupHeader *GetHeader() const { return tile_group_header; }
 
   inline TileGroup *GetTileGroup() const { return tile_group; }
@@ -170,7 +190,7 @@ class Tile : public Printable {
   void DeserializeTuplesFromWithoutHeader(SerializeInput &input,
                                           type::AbstractPool *pool = nullptr);
 
-  type::AbstractPool *GetPool() { return (pool); }
+  type::AbstractPool *GetPool() { return (pool.get()); }
 
   char *GetTupleLocation(const oid_t tuple_offset) const;
 
@@ -200,8 +220,8 @@ class Tile : public Printable {
   // relevant tile group
   TileGroup *tile_group;
 
-  // storage pool for uninlined data
-  type::AbstractPool *pool;
+  // storage pool for uninlined data, shared by the tiles of a tile group
+  std::shared_ptr<type::AbstractPool> pool;
 
   // number of tuple slots allocated
   oid_t num_tuple_slots;
@@ -209,6 +229,9 @@ class Tile : public Printable {
   // number of columns
   oid_t column_count;
 
+  // the column of the table held by each column of the tile
+  std::vector<oid_t> table_column_ids;
+
   // length of tile tuple
   size_t tuple_length;
 
@@ -218,6 +241,9 @@ class Tile : public Printable {
   // space occupied by uninlined data
   size_t uninlined_data_size;
 
+  // space occupied by the inlined data of all tiles
+  static std::atomic<size_t> resident_data_size;
+
   // Used for serialization/deserialization
   char *column_header;
 
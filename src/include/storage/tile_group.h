@@ -22,7 +22,9 @@
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "planner/project_info.h"
+#include "storage/compressed_column.h"
 #include "storage/layout.h"
+#include "storage/zone_map.h"
 #include "type/abstract_pool.h"
 #include "type/value.h"
 
@@ -54,6 +56,20 @@ class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
 
+// The data of the tiles of an evicted tile group in the eviction file. It is
+// shared by the copies of the tile group, and its space in the file is freed
+// once the last of them is.
+struct EvictedCopy {
+  ~EvictedCopy();
+
+  // backend of the eviction file
+  BackendType backend = BackendType::INVALID;
+
+  // offset and size of the data of each tile in the file, by tile offset
+  std::vector<size_t> offsets;
+  std::vector<size_t> sizes;
+};
+
 /**
  * Represents a group of tiles logically horizontally contiguous.
  *
@@ -106,6 +122,15 @@ class TileGroup : public Printable {
   oid_t InsertTupleFromCheckpoint(oid_t tuple_slot_id, const Tuple *tuple,
                                   cid_t commit_id);
 
+  // copy tuple_count consecutive tuples in the row layout of this tile group
+  // to the slots starting from tuple_slot_id with a single copy.
+  // the uninlined columns still point to the memory of the source, and must
+  // be set by the caller before the tile group is accessed.
+  // used by recovery mode
+  oid_t InsertTuplesFromCheckpoint(oid_t tuple_slot_id, oid_t tuple_count,
+                                   const char *tuple_data,
+                                   const cid_t *commit_ids);
+
   //===--------------------------------------------------------------------===//
   // Utilities
   //===--------------------------------------------------------------------===//
@@ -128,9 +153,16 @@ class TileGroup : public Printable {
 
   unsigned int NumTiles() const { return tiles.size(); }
 
-  // Get the tile at given offset in the tile group
+  // Get the tile at given offset in the tile group. A tile whose column is
+  // compressed is thawed first, and an evicted tile is read back in.
   inline Tile *GetTile(const oid_t tile_offset) const {
     PELOTON_ASSERT(tile_offset < tile_count_);
+    if (frozen_tile_count_.load(std::memory_order_acquire) != 0) {
+      ThawTile(tile_offset);
+    }
+    if (evicted_tile_count_.load(std::memory_order_acquire) != 0) {
+      FaultInTile(tile_offset);
+    }
     Tile *tile = tiles[tile_offset].get();
     return tile;
   }
@@ -164,6 +196,96 @@ class TileGroup : public Printable {
   // Get the layout of the TileGroup. Used to locate columns.
   const storage::Layout &GetLayout() const { return *tile_group_layout_; }
 
+  ZoneMap *GetZoneMap() const { return zone_map_.get(); }
+
+  // Widen the zone map with the values of a tuple slot that were written
+  // without going through the tile group
+  void UpdateZoneMap(oid_t tuple_slot_id);
+
+  //===--------------------------------------------------------------------===//
+  // Delta versions
+  //===--------------------------------------------------------------------===//
+
+  // The tile group that holds the value of a column of a version, following
+  // the older versions that a delta version inherits the column from. The
+  // tuple id is set to the slot of the value in that tile group.
+  TileGroup *LocateValue(oid_t &tuple_id, oid_t column_id);
+
+  // Copy the columns that a delta version inherits from the older version
+  // at older_location into its own slot. Called by the GC before the older
+  // version is reclaimed.
+  void FoldDeltaVersion(oid_t tuple_id, const ItemPointer &older_location);
+
+  // Returns false if the zone map shows that no tuple can satisfy all of
+  // the predicates
+  bool ShouldScan(const PredicateInfo *predicates,
+                  int32_t num_predicates) const {
+    return zone_map_->ShouldScan(predicates, num_predicates);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Frozen tile groups
+  //===--------------------------------------------------------------------===//
+
+  // Compress the columns of a tile group in the column layout, and release
+  // the tiles of the compressed columns. Must be called before the tile
+  // group is visible to other threads.
+  void Freeze();
+
+  // A tile group is no longer frozen once one of its tiles is thawed, so
+  // that it is frozen again, rather than keeping the thawed tile along with
+  // its compressed column.
+  bool IsFrozen() const {
+    return compressed_columns_.empty() == false &&
+           thawed_tile_count_.load(std::memory_order_acquire) == 0;
+  }
+
+  // The compressed values of a column, or nullptr if the column is not
+  // compressed or its tile has been thawed
+  const CompressedColumn *GetCompressedColumn(oid_t column_id) const;
+
+  // Bytes used by the compressed columns whose tiles are released
+  size_t GetCompressedSize() const;
+
+  //===--------------------------------------------------------------------===//
+  // Evicted tile groups
+  //===--------------------------------------------------------------------===//
+
+  // Write the data of the tiles to the eviction file of the given backend,
+  // and release it. The header, zone map and uninlined data stay in memory.
+  // Must be called before the tile group is visible to other threads.
+  void Evict(BackendType eviction_backend);
+
+  // Whether some tiles are still in the eviction file
+  bool IsEvicted() const {
+    return evicted_tile_count_.load(std::memory_order_acquire) != 0;
+  }
+
+  // Whether the data of the tiles has a copy in the eviction file, whether
+  // or not they have been read back in
+  bool HasEvictedCopy() const { return evicted_copy_ != nullptr; }
+
+  // Whether some tiles have been read back in from the eviction file
+  bool IsFaultedIn() const {
+    return HasEvictedCopy() &&
+           evicted_tile_count_.load(std::memory_order_acquire) < tile_count_;
+  }
+
+  // Evict the tiles again by sharing the copy of their data in the eviction
+  // file with an evicted tile group in the same layout, without writing it.
+  // Must be called before the tile group is visible to other threads.
+  void ShareEvictedCopy(const TileGroup &evicted_tile_group);
+
+  // Read all evicted tiles back in
+  void FaultIn();
+
+  // Bytes of inlined data of the tiles that are neither frozen nor evicted
+  size_t GetResidentSize() const;
+
+  // Returns true only for the first call, so that a tile group is prefetched
+  // once
+  bool StartPrefetch() { return prefetch_started_.exchange(true) == false; }
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -196,6 +318,47 @@ class TileGroup : public Printable {
 
   // Refernce to the layout of the TileGroup
   std::shared_ptr<const Layout> tile_group_layout_;
+
+  // pool for the uninlined data of all tiles, shared with the tiles so that
+  // it outlives any tile reference
+  std::shared_ptr<type::AbstractPool> varlen_pool_;
+
+  // min and max values of the columns
+  std::unique_ptr<ZoneMap> zone_map_;
+
+ private:
+  // Decompress the column of a frozen tile into its data
+  void ThawTile(const oid_t tile_offset) const;
+
+  // compressed columns of a frozen tile group, by tile offset. they are kept
+  // after their tiles are thawed, since scans may still be reading them.
+  std::vector<std::unique_ptr<CompressedColumn>> compressed_columns_;
+
+  // whether each tile has released its data
+  std::unique_ptr<std::atomic<bool>[]> frozen_tiles_;
+
+  mutable std::atomic<uint32_t> frozen_tile_count_{0};
+
+  // number of tiles thawed since the tile group was frozen
+  mutable std::atomic<uint32_t> thawed_tile_count_{0};
+
+  mutable std::mutex thaw_mutex_;
+
+  // Read the data of an evicted tile back from the eviction file
+  void FaultInTile(const oid_t tile_offset) const;
+
+  // Release the data of the tiles once it is in the eviction file
+  void ReleaseEvictedTiles();
+
+  // copy of the data of the tiles in the eviction file
+  std::shared_ptr<const EvictedCopy> evicted_copy_;
+
+  // whether each tile is only in the eviction file
+  std::unique_ptr<std::atomic<bool>[]> evicted_tiles_;
+
+  mutable std::atomic<uint32_t> evicted_tile_count_{0};
+
+  std::atomic<bool> prefetch_started_{false};
 };
 
 }  // namespace storage
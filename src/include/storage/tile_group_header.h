@@ -19,6 +19,7 @@
 #include "common/macros.h"
 #include "common/synchronization/spin_latch.h"
 #include "common/printable.h"
+#include "storage/delta_record.h"
 #include "storage/tuple.h"
 #include "common/internal_types.h"
 #include "type/value.h"
@@ -88,6 +89,7 @@ class TileGroupHeader : public Printable {
     num_tuple_slots = other.num_tuple_slots;
     next_tuple_slot.store(other.next_tuple_slot);
     immutable = other.immutable;
+    all_visible_cid_ = MAX_CID;
 
     // copy tuple header values
     for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
@@ -107,7 +109,7 @@ class TileGroupHeader : public Printable {
     return *this;
   }
 
-  ~TileGroupHeader() = default;
+  ~TileGroupHeader();
 
   oid_t GetNextEmptyTupleSlot() {
     if (next_tuple_slot >= num_tuple_slots) {
@@ -197,6 +199,12 @@ class TileGroupHeader : public Printable {
     return tuple_headers_[tuple_slot_id].indirection;
   }
 
+  // The headers of consecutive tuple slots are laid out one after another,
+  // so that the visibility of a range of slots is checked in batches
+  inline const TupleHeader *GetTupleHeader(const oid_t &tuple_slot_id) const {
+    return &tuple_headers_[tuple_slot_id];
+  }
+
   // Setters
 
   inline void SetTileGroup(TileGroup *tile_group) {
@@ -206,6 +214,9 @@ class TileGroupHeader : public Printable {
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) const {
     tuple_headers_[tuple_slot_id].txn_id = transaction_id;
+    if (transaction_id != INITIAL_TXN_ID) {
+      ResetAllVisible();
+    }
   }
 
   inline void SetLastReaderCommitId(const oid_t &tuple_slot_id,
@@ -240,11 +251,73 @@ class TileGroupHeader : public Printable {
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
-    auto old_val = INITIAL_TXN_ID;
-    return tuple_headers_[tuple_slot_id].txn_id.compare_exchange_strong(
-        old_val, transaction_id);
+    return SetAtomicTransactionId(tuple_slot_id, INITIAL_TXN_ID,
+                                  transaction_id);
+  }
+
+  inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
+                                     txn_id_t old_transaction_id,
+                                     const txn_id_t &transaction_id) const {
+    if (tuple_headers_[tuple_slot_id].txn_id.compare_exchange_strong(
+            old_transaction_id, transaction_id) == false) {
+      return false;
+    }
+    ResetAllVisible();
+    return true;
+  }
+
+  /**
+   * @brief Every version of the tile group is visible to the transactions
+   * that read as of the returned commit id or later, so they can skip the
+   * visibility check of each version. MAX_CID if that is not known.
+   */
+  inline cid_t GetAllVisibleCommitId() const { return all_visible_cid_; }
+
+  inline bool IsAllVisible(const cid_t &read_id) const {
+    return read_id >= all_visible_cid_;
+  }
+
+  /**
+   * @brief Set the all-visible commit id if the tile group is full, and all
+   * of its versions are live, not owned by any transaction, and committed
+   * before the given commit id. Called by the GC.
+   *
+   * @return True if the tile group is all-visible.
+   */
+  bool SetAllVisible(const cid_t &settled_cid);
+
+  //===--------------------------------------------------------------------===//
+  // Delta versions
+  //===--------------------------------------------------------------------===//
+
+  // True if some version of the tile group inherits columns from an older
+  // version, readers only look up the delta records if it is
+  inline bool HasDeltaRecords() const {
+    return delta_record_count_.load(std::memory_order_acquire) != 0;
+  }
+
+  inline DeltaRecord *GetDeltaRecord(const oid_t &tuple_slot_id) const {
+    if (delta_records_ == nullptr) {
+      return nullptr;
+    }
+    return delta_records_[tuple_slot_id].load(std::memory_order_acquire);
   }
 
+  /**
+   * @brief Attach the delta record of a version installed by an update that
+   * only writes some of its columns. The header takes ownership of it.
+   */
+  void SetDeltaRecord(const oid_t &tuple_slot_id, DeltaRecord *delta_record);
+
+  /**
+   * @brief Mark the delta record of a version folded, once its slot holds
+   * every column.
+   */
+  void FoldDeltaRecord(const oid_t &tuple_slot_id);
+
+  // Free the delta record of a reclaimed version
+  void ReleaseDeltaRecord(const oid_t &tuple_slot_id);
+
   /*
   * @brief The following method use Compare and Swap to set the tilegroup's
   immutable flag to be true. 
@@ -276,6 +349,16 @@ class TileGroupHeader : public Printable {
   const std::string GetInfo() const;
 
  private:
+  // Any transaction that takes a version of the tile group calls this before
+  // it can modify the version. The load pairs with the store of the pending
+  // marker in SetAllVisible(), so either the GC sees the new owner of the
+  // version, or the transaction sees the marker and resets it.
+  inline void ResetAllVisible() const {
+    if (all_visible_cid_ != MAX_CID) {
+      all_visible_cid_ = MAX_CID;
+    }
+  }
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -301,6 +384,16 @@ class TileGroupHeader : public Printable {
   // Immmutable Flag. Should be set by the indextuner to be true.
   // By default it will be set to false.
   bool immutable;
+
+  // the commit id as of which every version is visible, or MAX_CID. the GC
+  // sets it, any transaction that takes ownership of a version resets it.
+  mutable std::atomic<cid_t> all_visible_cid_;
+
+  // the delta records of the versions, allocated with the first one
+  std::unique_ptr<std::atomic<DeltaRecord *>[]> delta_records_;
+
+  // number of delta records that are not folded yet
+  std::atomic<oid_t> delta_record_count_;
 };
 
 }  // namespace storage
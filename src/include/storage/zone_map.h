@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+struct PredicateInfo {
+  int col_id;
+  int comparison_operator;
+  type::Value predicate_value;
+};
+
+/**
+ * @brief The min and max values of the columns of a tile group.
+ *
+ * The ranges are kept in memory next to the tile group, and are widened
+ * whenever a value is written to the tile group. They are never shrunk, so
+ * they always cover every version in the tile group.
+ *
+ * Only the columns of fixed-length numeric, timestamp and date types are
+ * tracked. The values are stored as int64_t, and decimals are mapped to an
+ * int64_t with the same order.
+ */
+class ZoneMap {
+ public:
+  ZoneMap(const std::vector<type::TypeId> &column_types);
+
+  // Widen the range of the column to include the value
+  void Widen(oid_t column_id, const type::Value &value);
+
+  // Copy the ranges of a zone map over the same columns
+  void CopyFrom(const ZoneMap &other);
+
+  // Returns false if no tuple in the tile group can satisfy all of the
+  // predicates, and true otherwise
+  bool ShouldScan(const PredicateInfo *predicates,
+                  int32_t num_predicates) const;
+
+  bool IsTracked(oid_t column_id) const {
+    return column_id < column_count_ &&
+           IsTrackedType(column_types_[column_id]);
+  }
+
+  // The range of a column. Returns false if the column is not tracked, or
+  // no value of the column has been written yet.
+  bool GetRange(oid_t column_id, type::Value &min, type::Value &max) const;
+
+  static bool IsTrackedType(type::TypeId type_id);
+
+ private:
+  struct ColumnRange {
+    std::atomic<int64_t> min;
+    std::atomic<int64_t> max;
+  };
+
+  static int64_t Encode(type::TypeId type_id, const type::Value &value);
+
+  static type::Value Decode(type::TypeId type_id, int64_t encoded);
+
+  oid_t column_count_;
+
+  std::vector<type::TypeId> column_types_;
+
+  std::unique_ptr<ColumnRange[]> ranges_;
+};
+
+}  // namespace storage
+}  // namespace peloton
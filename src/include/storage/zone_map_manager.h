@@ -16,6 +16,7 @@
 
 #include "common/macros.h"
 #include "common/internal_types.h"
+#include "storage/zone_map.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -29,12 +30,6 @@ namespace storage {
 class DataTable;
 class TileGroup;
 
-struct PredicateInfo {
-  int col_id;
-  int comparison_operator;
-  type::Value predicate_value;
-};
-
 class ZoneMapManager {
  public:
   typedef struct ColumnStatistics {
@@ -86,35 +81,6 @@ class ZoneMapManager {
   std::unique_ptr<ZoneMapManager::ColumnStatistics> GetResultVectorAsZoneMap(
       std::unique_ptr<std::vector<type::Value>> &result_vector);
 
-  static bool CheckEqual(const type::Value &predicate_val,
-                         ColumnStatistics *stats) {
-    const type::Value &min = stats->min;
-    const type::Value &max = stats->max;
-    return (min.CompareLessThanEquals(predicate_val)) == CmpBool::CmpTrue &&
-           (max.CompareGreaterThanEquals(predicate_val) == CmpBool::CmpTrue);
-  }
-
-  static bool CheckLessThan(const type::Value &predicate_val,
-                            ColumnStatistics *stats) {
-    return predicate_val.CompareGreaterThan(stats->min) == CmpBool::CmpTrue;
-  }
-
-  static bool CheckLessThanEquals(const type::Value &predicate_val,
-                                  ColumnStatistics *stats) {
-    return predicate_val.CompareGreaterThanEquals(stats->min) ==
-           CmpBool::CmpTrue;
-  }
-
-  static bool CheckGreaterThan(const type::Value &predicate_val,
-                               ColumnStatistics *stats) {
-    return predicate_val.CompareLessThan(stats->max) == CmpBool::CmpTrue;
-  }
-
-  static bool CheckGreaterThanEquals(const type::Value &predicate_val,
-                                     ColumnStatistics *stats) {
-    return predicate_val.CompareLessThanEquals(stats->max) == CmpBool::CmpTrue;
-  }
-
   //===--------------------------------------------------------------------===//
   // Data Members
   //===--------------------------------------------------------------------===//
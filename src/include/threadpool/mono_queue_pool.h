@@ -42,6 +42,8 @@ class MonoQueuePool {
   // TODO(Tianyu): Rename to (Brain)QueryHistoryLog or something
   static MonoQueuePool &GetBrainInstance();
   static MonoQueuePool &GetExecutionInstance();
+  // Reads evicted tile groups back in, which blocks on I/O
+  static MonoQueuePool &GetPrefetchInstance();
 
  private:
   TaskQueue task_queue_;
@@ -137,5 +139,22 @@ inline MonoQueuePool &MonoQueuePool::GetExecutionInstance() {
   return brain_queue_pool;
 }
 
+inline MonoQueuePool &MonoQueuePool::GetPrefetchInstance() {
+  int32_t task_queue_size = settings::SettingsManager::GetInt(
+      settings::SettingId::monoqueue_task_queue_size);
+  int32_t worker_pool_size = settings::SettingsManager::GetInt(
+      settings::SettingId::prefetch_worker_pool_size);
+
+  PELOTON_ASSERT(task_queue_size > 0);
+  PELOTON_ASSERT(worker_pool_size > 0);
+
+  std::string name = "prefetch-pool";
+
+  static MonoQueuePool prefetch_queue_pool(
+      name, static_cast<uint32_t>(task_queue_size),
+      static_cast<uint32_t>(worker_pool_size));
+  return prefetch_queue_pool;
+}
+
 }  // namespace threadpool
 }  // namespace peloton
@@ -34,6 +34,10 @@ namespace concurrency {
 class TransactionContext;
 }  // namespace concurrency
 
+namespace parser {
+class VariableSetStatement;
+}  // namespace parser
+
 namespace tcop {
 
 //===--------------------------------------------------------------------===//
@@ -100,6 +104,15 @@ class TrafficCop {
 
   ResultType CommitQueryHelper();
 
+  // Apply a SET statement to this session. Unknown variables are ignored.
+  ResultType ExecuteVariableSet(const parser::VariableSetStatement &set_stmt);
+
+  bool IsSynchronousCommit() const { return synchronous_commit_; }
+
+  bool IsDefaultTransactionReadOnly() const {
+    return default_transaction_read_only_;
+  }
+
   void ExecuteStatementPlanGetResult();
 
   ResultType ExecuteStatementGetResult();
@@ -172,6 +185,13 @@ class TrafficCop {
   // flag of single statement txn
   bool single_statement_txn_;
 
+  // whether the commits of this session wait for their log to be durable
+  bool synchronous_commit_;
+
+  // whether the transactions of this session are read-only unless they are
+  // begun with BEGIN READ WRITE
+  bool default_transaction_read_only_;
+
   std::vector<ResultValue> result_;
 
   // The current callback to be invoked after execution completes.
@@ -187,10 +207,24 @@ class TrafficCop {
 
   TcopTxnState &GetCurrentTxnState();
 
-  ResultType BeginQueryHelper(size_t thread_id);
+  ResultType BeginQueryHelper(size_t thread_id, bool read_only);
+
+  // Begin a transaction of this session. It is read-only if read_only is
+  // true.
+  concurrency::TransactionContext *BeginTransaction(size_t thread_id,
+                                                    bool read_only);
+
+  // Whether the transaction begun for a statement is read-only: the access
+  // mode of a BEGIN, or the default of the session
+  bool IsReadOnlyBegin(Statement &statement) const;
 
   ResultType AbortQueryHelper();
 
+  // Keep a statement executed by the current transaction for command
+  // logging
+  void RecordCommand(const std::shared_ptr<Statement> &statement,
+                     const std::vector<type::Value> &params);
+
   // Get all data tables from a TableRef.
   // For multi-way join
   // still a HACK
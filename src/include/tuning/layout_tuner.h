@@ -15,6 +15,7 @@
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "clusterer.h"
@@ -76,6 +77,14 @@ class LayoutTuner {
    */
   void AddTable(storage::DataTable *table);
 
+  /**
+   * Remove table from list of tables whose layout must be tuned. Waits for
+   * the table to be done with if it is being tuned.
+   *
+   * @param      table  The table
+   */
+  void RemoveTable(storage::DataTable *table);
+
   /**
    * Clear list
    */
@@ -91,12 +100,35 @@ class LayoutTuner {
    */
   bool UpdateDefaultPartition(storage::DataTable *table);
 
+  /**
+   * Transform cold tile groups of table into its default layout, and freeze
+   * the ones that have not been modified for the freeze interval. Frozen tile
+   * groups, and evicted ones whose tiles were read back in, are evicted while
+   * the tile data is over the memory budget, however many of them that takes.
+   * Resumes from where the previous call for the table stopped.
+   *
+   * @param      table  The table
+   * @return     number of tile groups that were transformed, frozen or
+   *             evicted
+   */
+  oid_t MigrateTileGroups(storage::DataTable *table);
+
  private:
   /**
    * Tables whose layout must be tuned
    */
   std::vector<storage::DataTable *> tables;
 
+  /**
+   * Offset of the next tile group to be visited in each table
+   */
+  std::unordered_map<storage::DataTable *, oid_t> migration_offsets;
+
+  /**
+   * Offset of the next tile group to be evicted in each table
+   */
+  std::unordered_map<storage::DataTable *, oid_t> eviction_offsets;
+
   std::mutex layout_tuner_mutex;
 
   /**
@@ -135,6 +167,9 @@ class LayoutTuner {
   /** Desired layout tile count */
   oid_t tile_count = 2;
 
+  /** Tile groups visited per table in each round */
+  oid_t migration_tile_group_count = 4;
+
 };
 
 }  // namespace indextuner
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_pool.h
+//
+// Identification: src/include/type/arena_pool.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_set>
+
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+#include "type/abstract_pool.h"
+
+namespace peloton {
+namespace type {
+
+//===----------------------------------------------------------------------===//
+//
+// A bump allocator for the uninlined data of a tile group.
+//
+// Memory is carved out of fixed-size blocks that are aligned to their size,
+// so the block of any chunk is found by masking its address. Allocate only
+// bumps the offset of the current block, and the latch is only taken when
+// a new block is installed. Free counts down the live chunks of the block,
+// and the block is released once it is no longer current and all of its
+// chunks are freed.
+//
+// Free is called by the GC after the epoch of the dead version has expired,
+// so a thread can not be still allocating from a block that is released.
+//
+//===----------------------------------------------------------------------===//
+class ArenaPool : public AbstractPool {
+ public:
+  ArenaPool() = default;
+
+  ~ArenaPool();
+
+  void *Allocate(size_t size) override;
+
+  void Free(void *ptr) override;
+
+  // number of blocks that are currently held by the pool
+  size_t GetBlockCount();
+
+  // size of a block, and the alignment of every block
+  static const size_t block_size_ = 64 * 1024;
+
+  // chunks larger than this get a block of their own
+  static const size_t max_chunk_size_ = block_size_ / 4;
+
+ private:
+  struct Block {
+    // offset of the next chunk from the start of the block
+    std::atomic<size_t> next_offset;
+
+    // chunks that are not freed, plus one while the block is current
+    std::atomic<size_t> live_count;
+  };
+
+  static const size_t chunk_alignment_ = 8;
+
+  static const size_t block_header_size_ =
+      (sizeof(Block) + chunk_alignment_ - 1) & ~(chunk_alignment_ - 1);
+
+  Block *NewBlock(size_t size, size_t live_count);
+
+  void ReleaseBlock(Block *block);
+
+  // block that chunks are currently allocated from
+  std::atomic<Block *> current_block_{nullptr};
+
+  // all blocks held by the pool, and the latch protecting them and the
+  // installation of the current block
+  std::unordered_set<Block *> blocks_;
+
+  common::synchronization::SpinLatch blocks_lock_;
+};
+
+}  // namespace type
+}  // namespace peloton
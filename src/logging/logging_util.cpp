@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_util.cpp
+//
+// Identification: src/logging/logging_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "logging/logging_util.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// DIRECTORY
+//===--------------------------------------------------------------------===//
+
+bool LoggingUtil::CreateDirectory(const char *dir_name, int mode) {
+  int return_val = mkdir(dir_name, mode);
+  if (return_val == 0) {
+    LOG_TRACE("Created directory %s successfully", dir_name);
+  } else if (errno == EEXIST) {
+    LOG_TRACE("Directory %s already exists", dir_name);
+  } else {
+    LOG_ERROR("Creating directory failed: %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool LoggingUtil::CheckDirectoryExistence(const char *dir_name) {
+  struct stat info;
+  int return_val = stat(dir_name, &info);
+  return return_val == 0 && S_ISDIR(info.st_mode);
+}
+
+// remove all the files under the directory.
+// if only_remove_file is false, the directory itself is removed as well.
+bool LoggingUtil::RemoveDirectory(const char *dir_name, bool only_remove_file) {
+  std::vector<std::string> file_names;
+  if (GetDirectoryList(dir_name, file_names) == false) {
+    return false;
+  }
+
+  for (auto &file_name : file_names) {
+    std::string full_path = std::string(dir_name) + "/" + file_name;
+    if (remove(full_path.c_str()) != 0) {
+      LOG_ERROR("Failed to remove file %s: %s", full_path.c_str(),
+                strerror(errno));
+      return false;
+    }
+  }
+
+  if (only_remove_file == false) {
+    if (rmdir(dir_name) != 0) {
+      LOG_ERROR("Failed to remove directory %s: %s", dir_name,
+                strerror(errno));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoggingUtil::GetDirectoryList(const char *dir_name,
+                                   std::vector<std::string> &file_names) {
+  DIR *dir = opendir(dir_name);
+  if (dir == nullptr) {
+    LOG_ERROR("Failed to open directory %s: %s", dir_name, strerror(errno));
+    return false;
+  }
+
+  struct dirent *file;
+  while ((file = readdir(dir)) != nullptr) {
+    if (strcmp(file->d_name, ".") == 0 || strcmp(file->d_name, "..") == 0) {
+      continue;
+    }
+    file_names.push_back(file->d_name);
+  }
+
+  closedir(dir);
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// FILE
+//===--------------------------------------------------------------------===//
+
+bool LoggingUtil::OpenFile(const char *name, const char *mode,
+                           FileHandle &file_handle) {
+  auto file = fopen(name, mode);
+  if (file == nullptr) {
+    LOG_ERROR("Failed to open file %s: %s", name, strerror(errno));
+    return false;
+  }
+
+  file_handle.file = file;
+
+  // also get the file descriptor
+  auto fd = fileno(file);
+  if (fd == INVALID_FILE_DESCRIPTOR) {
+    LOG_ERROR("Failed to get the descriptor of file %s", name);
+    fclose(file);
+    file_handle.file = nullptr;
+    return false;
+  }
+
+  file_handle.fd = fd;
+  file_handle.size = GetFileSize(file_handle);
+  return true;
+}
+
+bool LoggingUtil::CloseFile(FileHandle &file_handle) {
+  PELOTON_ASSERT(file_handle.file != nullptr &&
+                 file_handle.fd != INVALID_FILE_DESCRIPTOR);
+
+  int ret = fclose(file_handle.file);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fclose(): %s", strerror(errno));
+    return false;
+  }
+
+  file_handle.file = nullptr;
+  file_handle.fd = INVALID_FILE_DESCRIPTOR;
+  return true;
+}
+
+bool LoggingUtil::IsFileTruncated(FileHandle &file_handle,
+                                  size_t size_to_read) {
+  // Cache current position
+  size_t current_position = ftell(file_handle.file);
+
+  // Check if the actual file size is less than the expected file size
+  // Current position + frame length
+  if (current_position + size_to_read <= file_handle.size) {
+    return false;
+  } else {
+    fseek(file_handle.file, 0, SEEK_END);
+    return true;
+  }
+}
+
+size_t LoggingUtil::GetFileSize(FileHandle &file_handle) {
+  struct stat file_stats;
+  fstat(file_handle.fd, &file_stats);
+  return file_stats.st_size;
+}
+
+bool LoggingUtil::ReadNBytesFromFile(FileHandle &file_handle, void *bytes_read,
+                                     size_t n) {
+  PELOTON_ASSERT(file_handle.fd != INVALID_FILE_DESCRIPTOR &&
+                 file_handle.file != nullptr);
+  int res = fread(bytes_read, n, 1, file_handle.file);
+  return res == 1;
+}
+
+void LoggingUtil::FFlushFsync(FileHandle &file_handle) {
+  // First, flush
+  PELOTON_ASSERT(file_handle.fd != INVALID_FILE_DESCRIPTOR);
+  if (file_handle.fd == INVALID_FILE_DESCRIPTOR) return;
+  int ret = fflush(file_handle.file);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fflush(%d)", ret);
+  }
+  // Finally, sync
+  ret = fsync(file_handle.fd);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fsync(%d)", ret);
+  }
+}
+
+bool LoggingUtil::RemoveFile(const char *name) {
+  int ret = remove(name);
+  if (ret != 0) {
+    LOG_ERROR("Failed to remove file %s: %s", name, strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+eid_t LoggingUtil::GetEpochIdFromFileName(const std::string &file_name,
+                                          const std::string &prefix) {
+  if (file_name.size() <= prefix.size() + 1 ||
+      file_name.compare(0, prefix.size(), prefix) != 0 ||
+      file_name[prefix.size()] != '_') {
+    return INVALID_EID;
+  }
+
+  auto pos = file_name.rfind('_');
+  if (pos == prefix.size()) {
+    return INVALID_EID;
+  }
+
+  return std::strtoull(file_name.c_str() + pos + 1, nullptr, 10);
+}
+
+}  // namespace logging
+}  // namespace peloton
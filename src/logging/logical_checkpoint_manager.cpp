@@ -0,0 +1,675 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_checkpoint_manager.cpp
+//
+// Identification: src/logging/logical_checkpoint_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_checkpoint_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/string_dictionary.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/serializeio.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace logging {
+
+void LogicalCheckpointManager::SetDirectory(const std::string &checkpoint_dir) {
+  PELOTON_ASSERT(is_running_ == false);
+  checkpoint_dir_ = checkpoint_dir;
+}
+
+void LogicalCheckpointManager::StartCheckpointing() {
+  if (is_running_ == true) {
+    return;
+  }
+
+  is_running_ = true;
+  checkpoint_thread_.reset(
+      new std::thread(&LogicalCheckpointManager::Run, this));
+}
+
+void LogicalCheckpointManager::StopCheckpointing() {
+  if (is_running_ == false) {
+    return;
+  }
+
+  is_running_ = false;
+  checkpoint_thread_->join();
+  checkpoint_thread_.reset();
+}
+
+void LogicalCheckpointManager::Run() {
+  auto interval = std::chrono::seconds(checkpoint_interval_);
+  auto last_checkpoint_time = std::chrono::steady_clock::now();
+
+  while (is_running_ == true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_checkpoint_time >= interval) {
+      DoCheckpoint();
+      last_checkpoint_time = now;
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Checkpointing
+//===--------------------------------------------------------------------===//
+
+eid_t LogicalCheckpointManager::DoCheckpoint() {
+  std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+
+  if (LoggingUtil::CheckDirectoryExistence(checkpoint_dir_.c_str()) == false &&
+      LoggingUtil::CreateDirectory(checkpoint_dir_.c_str(), 0700) == false) {
+    LOG_ERROR("Cannot create directory: %s", checkpoint_dir_.c_str());
+    return INVALID_EID;
+  }
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto &log_manager = LogManagerFactory::GetInstance();
+
+  eid_t checkpoint_eid = epoch_manager.GetCurrentEpochId();
+
+  // a transaction stamps its versions while it is being logged. once every
+  // epoch before the checkpoint epoch is persistent, the transactions logged
+  // in these epochs are completely visible to the snapshot below.
+  while (log_manager.GetStatus() == true &&
+         log_manager.GetPersistEpochId() + 1 < checkpoint_eid) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+  }
+
+  // collect the tile groups of all the tables.
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto database_count = storage_manager->GetDatabaseCount();
+  for (oid_t database_itr = 0; database_itr < database_count; ++database_itr) {
+    auto database = storage_manager->GetDatabaseWithOffset(database_itr);
+    auto table_count = database->GetTableCount();
+    for (oid_t table_itr = 0; table_itr < table_count; ++table_itr) {
+      auto table = database->GetTable(table_itr);
+      auto tile_group_count = table->GetTileGroupCount();
+      for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+           ++tile_group_itr) {
+        auto tile_group = table->GetTileGroup(tile_group_itr);
+        if (tile_group != nullptr) {
+          tile_groups.push_back(tile_group);
+        }
+      }
+    }
+  }
+
+  // the snapshot is read by a read-only transaction, which neither blocks
+  // the writers nor gets its versions reclaimed by the garbage collector.
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::vector<std::thread> checkpointer_threads;
+  std::unique_ptr<bool[]> results(new bool[checkpointer_thread_count_]);
+  for (int i = 0; i < checkpointer_thread_count_; ++i) {
+    checkpointer_threads.emplace_back([&, i]() {
+      results[i] =
+          CheckpointTileGroups(tile_groups, txn, i, checkpoint_eid);
+    });
+  }
+  for (auto &checkpointer_thread : checkpointer_threads) {
+    checkpointer_thread.join();
+  }
+
+  txn_manager.CommitTransaction(txn);
+
+  for (int i = 0; i < checkpointer_thread_count_; ++i) {
+    if (results[i] == false) {
+      LOG_ERROR("Failed to take checkpoint %lu", checkpoint_eid);
+      return INVALID_EID;
+    }
+  }
+
+  // publish the checkpoint.
+  FileHandle file_handle;
+  std::string cepoch_file_name = GetCheckpointEpochFileFullPath();
+  if (LoggingUtil::OpenFile(cepoch_file_name.c_str(), "ab", file_handle) ==
+      false) {
+    LOG_ERROR("Unable to open checkpoint epoch file %s",
+              cepoch_file_name.c_str());
+    return INVALID_EID;
+  }
+  size_t write_count = fwrite((const void *)(&checkpoint_eid),
+                              sizeof(checkpoint_eid), 1, file_handle.file);
+  LoggingUtil::FFlushFsync(file_handle);
+  LoggingUtil::CloseFile(file_handle);
+  if (write_count != 1) {
+    LOG_ERROR("Unable to write checkpoint epoch file %s",
+              cepoch_file_name.c_str());
+    return INVALID_EID;
+  }
+
+  checkpoint_epoch_id_ = checkpoint_eid;
+
+  // the older checkpoints and log files are no longer needed for recovery.
+  RemoveCheckpoints(checkpoint_eid);
+  log_manager.TruncateLogs(checkpoint_eid);
+
+  LOG_INFO("Checkpoint %lu is taken with %lu tile groups", checkpoint_eid,
+           tile_groups.size());
+
+  return checkpoint_eid;
+}
+
+bool LogicalCheckpointManager::CheckpointTileGroups(
+    const std::vector<std::shared_ptr<storage::TileGroup>> &tile_groups,
+    concurrency::TransactionContext *txn, const size_t checkpointer_id,
+    const eid_t epoch_id) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  FileHandle file_handle;
+  std::string file_name = GetCheckpointFileFullPath(checkpointer_id, epoch_id);
+  if (LoggingUtil::OpenFile(file_name.c_str(), "wb", file_handle) == false) {
+    LOG_ERROR("Unable to open checkpoint file %s", file_name.c_str());
+    return false;
+  }
+
+  CopySerializeOutput output;
+  output.WriteEnumInSingleByte(static_cast<int>(checkpoint_format_));
+
+  std::vector<oid_t> visible_tuple_slots;
+
+  for (size_t i = checkpointer_id; i < tile_groups.size();
+       i += checkpointer_thread_count_) {
+    auto tile_group = tile_groups[i].get();
+    auto tile_group_header = tile_group->GetHeader();
+
+    visible_tuple_slots.clear();
+    auto next_tuple_slot = tile_group_header->GetCurrentNextTupleSlot();
+    for (oid_t tuple_slot = 0; tuple_slot < next_tuple_slot; ++tuple_slot) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_slot) ==
+          VisibilityType::OK) {
+        visible_tuple_slots.push_back(tuple_slot);
+      }
+    }
+
+    if (visible_tuple_slots.empty() == true) {
+      continue;
+    }
+
+    if (checkpoint_format_ == CheckpointFormatType::BINARY) {
+      SerializeBinaryTileGroup(tile_group, visible_tuple_slots, output);
+    } else {
+      SerializeRowTileGroup(tile_group, visible_tuple_slots, output);
+    }
+
+    size_t write_count = fwrite((const void *)(output.Data()), output.Size(),
+                                1, file_handle.file);
+    if (write_count != 1) {
+      LOG_ERROR("Unable to write checkpoint file %s", file_name.c_str());
+      LoggingUtil::CloseFile(file_handle);
+      return false;
+    }
+    output.Reset();
+  }
+
+  // the file holds the format even if it has no tile group.
+  if (output.Size() != 0) {
+    size_t write_count = fwrite((const void *)(output.Data()), output.Size(),
+                                1, file_handle.file);
+    if (write_count != 1) {
+      LOG_ERROR("Unable to write checkpoint file %s", file_name.c_str());
+      LoggingUtil::CloseFile(file_handle);
+      return false;
+    }
+  }
+
+  LoggingUtil::FFlushFsync(file_handle);
+  LoggingUtil::CloseFile(file_handle);
+  return true;
+}
+
+void LogicalCheckpointManager::SerializeRowTileGroup(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &tuple_slots,
+    CopySerializeOutput &output) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  output.WriteInt(tile_group->GetDatabaseId());
+  output.WriteInt(tile_group->GetTableId());
+  output.WriteInt(tile_group->GetTileGroupId());
+  output.WriteInt(tuple_slots.size());
+
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  auto column_count = schema->GetColumnCount();
+  for (auto tuple_slot : tuple_slots) {
+    output.WriteInt(tuple_slot);
+    output.WriteLong(tile_group_header->GetBeginCommitId(tuple_slot));
+    for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+      type::Value value = tile_group->GetValue(tuple_slot, column_id);
+      value.SerializeTo(output);
+    }
+  }
+}
+
+void LogicalCheckpointManager::SerializeBinaryTileGroup(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &tuple_slots,
+    CopySerializeOutput &output) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto &layout = tile_group->GetLayout();
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  auto column_count = schema->GetColumnCount();
+  size_t tuple_length = schema->GetLength();
+
+  // runs of consecutive tuple slots.
+  std::vector<std::pair<oid_t, oid_t>> runs;
+  for (auto tuple_slot : tuple_slots) {
+    if (runs.empty() == false &&
+        runs.back().first + runs.back().second == tuple_slot) {
+      runs.back().second++;
+    } else {
+      runs.emplace_back(tuple_slot, 1);
+    }
+  }
+
+  output.WriteInt(tile_group->GetDatabaseId());
+  output.WriteInt(tile_group->GetTableId());
+  output.WriteInt(tile_group->GetTileGroupId());
+  output.WriteInt(tuple_slots.size());
+  output.WriteInt(runs.size());
+  for (auto &run : runs) {
+    output.WriteInt(run.first);
+    output.WriteInt(run.second);
+  }
+  output.WriteInt(tuple_length);
+
+  for (auto tuple_slot : tuple_slots) {
+    output.WriteLong(tile_group_header->GetBeginCommitId(tuple_slot));
+  }
+
+  // the tuple data is written in the row layout of the table. in a row
+  // store tile group, that is the layout of its only tile, unless some of its
+  // versions still read columns from older versions.
+  bool has_delta_records = tile_group_header->HasDeltaRecords();
+  if (layout.IsRowStore() == true && has_delta_records == false) {
+    auto tile = tile_group->GetTile(0);
+    for (auto &run : runs) {
+      output.WriteBytes(tile->GetTupleLocation(run.first),
+                        run.second * tuple_length);
+    }
+  } else {
+    for (auto tuple_slot : tuple_slots) {
+      for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+        // the columns that a delta version inherits are copied from the
+        // older version that holds them.
+        oid_t value_slot = tuple_slot;
+        auto value_tile_group =
+            has_delta_records ? tile_group->LocateValue(value_slot, column_id)
+                              : tile_group;
+
+        // the compressed columns of a frozen tile group are decoded, rather
+        // than thawing their tiles.
+        auto compressed_column =
+            value_tile_group->GetCompressedColumn(column_id);
+        if (compressed_column != nullptr) {
+          char value[sizeof(int64_t)];
+          compressed_column->CopyValue(value_slot, value);
+          output.WriteBytes(value, schema->GetLength(column_id));
+          continue;
+        }
+
+        oid_t tile_offset, tile_column_id;
+        value_tile_group->GetLayout().LocateTileAndColumn(
+            column_id, tile_offset, tile_column_id);
+        auto tile = value_tile_group->GetTile(tile_offset);
+        output.WriteBytes(tile->GetTupleLocation(value_slot) +
+                              tile->GetSchema()->GetOffset(tile_column_id),
+                          schema->GetLength(column_id));
+      }
+    }
+  }
+
+  // the uninlined columns hold pointers to a length followed by the bytes.
+  auto uninlined_column_count = schema->GetUninlinedColumnCount();
+  if (uninlined_column_count == 0) {
+    return;
+  }
+
+  for (auto tuple_slot : tuple_slots) {
+    for (oid_t column_itr = 0; column_itr < uninlined_column_count;
+         ++column_itr) {
+      oid_t column_id = schema->GetUninlinedColumn(column_itr);
+      oid_t value_slot = tuple_slot;
+      auto value_tile_group =
+          has_delta_records ? tile_group->LocateValue(value_slot, column_id)
+                            : tile_group;
+      oid_t tile_offset, tile_column_id;
+      value_tile_group->GetLayout().LocateTileAndColumn(
+          column_id, tile_offset, tile_column_id);
+      auto tile = value_tile_group->GetTile(tile_offset);
+      const char *varlen_ptr = *reinterpret_cast<const char *const *>(
+          tile->GetTupleLocation(value_slot) +
+          tile->GetSchema()->GetOffset(tile_column_id));
+
+      if (varlen_ptr == nullptr) {
+        output.WriteInt(type::PELOTON_VALUE_NULL);
+      } else {
+        uint32_t varlen_length = *reinterpret_cast<const uint32_t *>(varlen_ptr);
+        output.WriteInt(varlen_length);
+        output.WriteBytes(varlen_ptr + sizeof(uint32_t), varlen_length);
+      }
+    }
+  }
+}
+
+void LogicalCheckpointManager::RemoveCheckpoints(const eid_t epoch_id) {
+  std::vector<std::string> file_names;
+  if (LoggingUtil::GetDirectoryList(checkpoint_dir_.c_str(), file_names) ==
+      false) {
+    return;
+  }
+
+  for (auto &file_name : file_names) {
+    eid_t file_eid = LoggingUtil::GetEpochIdFromFileName(
+        file_name, checkpoint_filename_prefix_);
+    if (file_eid != INVALID_EID && file_eid < epoch_id) {
+      std::string full_path = checkpoint_dir_ + "/" + file_name;
+      LoggingUtil::RemoveFile(full_path.c_str());
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Recovery
+//===--------------------------------------------------------------------===//
+
+eid_t LogicalCheckpointManager::DoCheckpointRecovery() {
+  std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+
+  eid_t checkpoint_eid = ReadCheckpointEpochId();
+  if (checkpoint_eid == INVALID_EID) {
+    LOG_INFO("No checkpoint is found in %s", checkpoint_dir_.c_str());
+    return INVALID_EID;
+  }
+
+  std::vector<std::string> file_names;
+  LoggingUtil::GetDirectoryList(checkpoint_dir_.c_str(), file_names);
+
+  std::vector<std::string> checkpoint_files;
+  for (auto &file_name : file_names) {
+    if (LoggingUtil::GetEpochIdFromFileName(
+            file_name, checkpoint_filename_prefix_) == checkpoint_eid) {
+      checkpoint_files.push_back(checkpoint_dir_ + "/" + file_name);
+    }
+  }
+
+  // every tile group is written to a single file, so the files can be
+  // loaded in parallel.
+  std::vector<size_t> tuple_counts(checkpointer_thread_count_, 0);
+  std::vector<oid_t> max_tile_group_ids(checkpointer_thread_count_, 0);
+  std::vector<std::thread> recovery_threads;
+  for (int i = 0; i < checkpointer_thread_count_; ++i) {
+    recovery_threads.emplace_back([&, i]() {
+      for (size_t file_itr = i; file_itr < checkpoint_files.size();
+           file_itr += checkpointer_thread_count_) {
+        RecoverCheckpointFile(checkpoint_files[file_itr], tuple_counts[i],
+                              max_tile_group_ids[i]);
+      }
+    });
+  }
+  for (auto &recovery_thread : recovery_threads) {
+    recovery_thread.join();
+  }
+
+  size_t tuple_count = 0;
+  oid_t max_tile_group_id = 0;
+  for (int i = 0; i < checkpointer_thread_count_; ++i) {
+    tuple_count += tuple_counts[i];
+    max_tile_group_id = std::max(max_tile_group_id, max_tile_group_ids[i]);
+  }
+
+  // new tile groups must not reuse the ids of the recovered ones.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  if (storage_manager->GetCurrentTileGroupId() < max_tile_group_id) {
+    storage_manager->SetNextTileGroupId(max_tile_group_id);
+  }
+
+  // new transactions must observe the recovered versions.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  if (epoch_manager.GetCurrentEpochId() <= checkpoint_eid) {
+    epoch_manager.SetCurrentEpochId(checkpoint_eid + 1);
+  }
+
+  checkpoint_epoch_id_ = checkpoint_eid;
+
+  LOG_INFO("Recovered %lu tuples from checkpoint %lu", tuple_count,
+           checkpoint_eid);
+
+  return checkpoint_eid;
+}
+
+void LogicalCheckpointManager::RecoverCheckpointFile(
+    const std::string &file_name, size_t &tuple_count,
+    oid_t &max_tile_group_id) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == INVALID_FILE_DESCRIPTOR) {
+    LOG_ERROR("Unable to open checkpoint file %s", file_name.c_str());
+    return;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    LOG_ERROR("Unable to read checkpoint file %s", file_name.c_str());
+    close(fd);
+    return;
+  }
+  size_t file_size = file_stat.st_size;
+
+  // the file is mapped rather than read, so the tuple data is copied
+  // straight from the page cache to the tiles.
+  void *data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("Unable to map checkpoint file %s", file_name.c_str());
+    return;
+  }
+  madvise(data, file_size, MADV_SEQUENTIAL);
+
+  ReferenceSerializeInput input(data, file_size);
+  auto format = static_cast<CheckpointFormatType>(input.ReadEnumInSingleByte());
+  type::EphemeralPool pool;
+
+  const char *end = static_cast<const char *>(data) + file_size;
+  while (static_cast<const char *>(input.getRawPointer(0)) < end) {
+    oid_t database_id = input.ReadInt();
+    oid_t table_id = input.ReadInt();
+    oid_t tile_group_id = input.ReadInt();
+    oid_t tile_group_tuple_count = input.ReadInt();
+
+    auto tile_group = ResolveTileGroup(database_id, table_id, tile_group_id);
+    if (tile_group == nullptr) {
+      break;
+    }
+    max_tile_group_id = std::max(max_tile_group_id, tile_group_id);
+
+    if (format == CheckpointFormatType::BINARY) {
+      if (RecoverBinaryTuples(input, tile_group, tile_group_tuple_count) ==
+          false) {
+        break;
+      }
+    } else {
+      RecoverRowTuples(input, tile_group, tile_group_tuple_count, &pool);
+    }
+    tuple_count += tile_group_tuple_count;
+  }
+
+  munmap(data, file_size);
+}
+
+storage::TileGroup *LogicalCheckpointManager::ResolveTileGroup(
+    const oid_t database_id, const oid_t table_id, const oid_t tile_group_id) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  storage::DataTable *table = nullptr;
+  try {
+    table = storage_manager->GetTableWithOid(database_id, table_id);
+  } catch (CatalogException &e) {
+    LOG_ERROR("Cannot find table %u in database %u", table_id, database_id);
+    return nullptr;
+  }
+
+  auto tile_group = storage_manager->GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    table->AddTileGroupWithOidForRecovery(tile_group_id);
+    tile_group = storage_manager->GetTileGroup(tile_group_id);
+  } else if (tile_group->GetTableId() != table_id) {
+    LOG_ERROR("Tile group %u is owned by table %u rather than table %u",
+              tile_group_id, tile_group->GetTableId(), table_id);
+    return nullptr;
+  }
+
+  return tile_group.get();
+}
+
+void LogicalCheckpointManager::RecoverRowTuples(ReferenceSerializeInput &input,
+                                                storage::TileGroup *tile_group,
+                                                const oid_t tuple_count,
+                                                type::AbstractPool *pool) {
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  auto column_count = schema->GetColumnCount();
+  for (oid_t i = 0; i < tuple_count; ++i) {
+    oid_t tuple_slot = input.ReadInt();
+    cid_t begin_cid = input.ReadLong();
+
+    storage::Tuple tuple(schema, true);
+    for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+      auto value =
+          type::Value::DeserializeFrom(input, schema->GetType(column_id), pool);
+      tuple.SetValue(column_id, value, pool);
+    }
+
+    tile_group->InsertTupleFromCheckpoint(tuple_slot, &tuple, begin_cid);
+  }
+}
+
+bool LogicalCheckpointManager::RecoverBinaryTuples(
+    ReferenceSerializeInput &input, storage::TileGroup *tile_group,
+    const oid_t tuple_count) {
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+
+  std::vector<std::pair<oid_t, oid_t>> runs(input.ReadInt());
+  for (auto &run : runs) {
+    run.first = input.ReadInt();
+    run.second = input.ReadInt();
+  }
+
+  size_t tuple_length = input.ReadInt();
+  if (tuple_length != schema->GetLength() ||
+      tile_group->GetLayout().IsRowStore() == false) {
+    LOG_ERROR("Tile group %u does not match the layout of the checkpoint",
+              tile_group->GetTileGroupId());
+    return false;
+  }
+
+  std::vector<cid_t> begin_cids(tuple_count);
+  input.ReadBytes(begin_cids.data(), tuple_count * sizeof(cid_t));
+
+  const char *tuple_data = static_cast<const char *>(
+      input.getRawPointer(tuple_count * tuple_length));
+
+  // a single copy for every run of consecutive tuple slots.
+  oid_t tuple_itr = 0;
+  for (auto &run : runs) {
+    tile_group->InsertTuplesFromCheckpoint(
+        run.first, run.second, tuple_data + tuple_itr * tuple_length,
+        begin_cids.data() + tuple_itr);
+    tuple_itr += run.second;
+  }
+
+  // the uninlined columns still point to the memory of the checkpointed
+  // database. they are copied to the pool of the tile.
+  auto uninlined_column_count = schema->GetUninlinedColumnCount();
+  if (uninlined_column_count == 0) {
+    return true;
+  }
+
+  auto tile = tile_group->GetTile(0);
+  auto pool = tile->GetPool();
+  for (auto &run : runs) {
+    for (oid_t tuple_slot = run.first; tuple_slot < run.first + run.second;
+         ++tuple_slot) {
+      for (oid_t column_itr = 0; column_itr < uninlined_column_count;
+           ++column_itr) {
+        oid_t column_id = schema->GetUninlinedColumn(column_itr);
+        char *varlen_location =
+            tile->GetTupleLocation(tuple_slot) + schema->GetOffset(column_id);
+
+        uint32_t varlen_length = input.ReadInt();
+        char *varlen_ptr = nullptr;
+        auto *dictionary = schema->GetDictionary(column_id);
+        if (varlen_length != type::PELOTON_VALUE_NULL &&
+            dictionary != nullptr) {
+          varlen_ptr = const_cast<char *>(dictionary->Intern(
+              static_cast<const char *>(input.getRawPointer(varlen_length)),
+              varlen_length));
+        } else if (varlen_length != type::PELOTON_VALUE_NULL) {
+          varlen_ptr = static_cast<char *>(
+              pool->Allocate(varlen_length + sizeof(uint32_t)));
+          PELOTON_MEMCPY(varlen_ptr, &varlen_length, sizeof(uint32_t));
+          PELOTON_MEMCPY(varlen_ptr + sizeof(uint32_t),
+                         input.getRawPointer(varlen_length), varlen_length);
+        }
+        *reinterpret_cast<char **>(varlen_location) = varlen_ptr;
+      }
+    }
+  }
+
+  return true;
+}
+
+eid_t LogicalCheckpointManager::ReadCheckpointEpochId() {
+  std::string file_name = GetCheckpointEpochFileFullPath();
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(file_name.c_str(), "rb", file_handle) == false) {
+    return INVALID_EID;
+  }
+
+  // the last complete entry is the latest checkpoint.
+  eid_t checkpoint_eid = INVALID_EID;
+  size_t entry_count = LoggingUtil::GetFileSize(file_handle) / sizeof(eid_t);
+  if (entry_count != 0 &&
+      fseek(file_handle.file, (entry_count - 1) * sizeof(eid_t), SEEK_SET) ==
+          0) {
+    if (LoggingUtil::ReadNBytesFromFile(file_handle, &checkpoint_eid,
+                                        sizeof(checkpoint_eid)) == false) {
+      checkpoint_eid = INVALID_EID;
+    }
+  }
+
+  LoggingUtil::CloseFile(file_handle);
+  return checkpoint_eid;
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,572 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_manager.cpp
+//
+// Identification: src/logging/logical_log_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "catalog/schema.h"
+#include "common/statement.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_context.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "storage/abstract_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace logging {
+
+// the logging context of the calling worker thread.
+// contexts are owned by the loggers and outlive the worker threads.
+static thread_local WorkerContext *tl_worker_ctx = nullptr;
+
+void LogicalLogManager::SetDirectory(const std::string &logging_dir) {
+  PELOTON_ASSERT(is_running_ == false);
+  logging_dir_ = logging_dir;
+
+  for (auto &logger : loggers_) {
+    logger->SetDirectory(logging_dir_);
+  }
+}
+
+void LogicalLogManager::StartLogging() {
+  if (is_running_ == true) {
+    return;
+  }
+
+  // check the existence of logging directory.
+  // if not exists, then create the directory.
+  if (LoggingUtil::CheckDirectoryExistence(logging_dir_.c_str()) == false) {
+    LOG_INFO("Logging directory %s is not accessible or does not exist",
+             logging_dir_.c_str());
+    bool res = LoggingUtil::CreateDirectory(logging_dir_.c_str(), 0700);
+    if (res == false) {
+      LOG_ERROR("Cannot create directory: %s", logging_dir_.c_str());
+      return;
+    }
+  }
+
+  // loggers are created once and kept alive across restarts, as worker
+  // threads keep pointing to the contexts registered to them.
+  if (loggers_.empty() == true) {
+    for (int i = 0; i < logger_thread_count_; ++i) {
+      loggers_.emplace_back(new LogicalLogger(i, logging_dir_));
+    }
+  }
+
+  // the epochs that have been persisted are closed. the transactions that
+  // are logged from now on must fall into a later epoch.
+  eid_t max_persist_eid = persist_epoch_id_;
+  for (auto &logger : loggers_) {
+    if (logger->GetPersistEpochId() > max_persist_eid) {
+      max_persist_eid = logger->GetPersistEpochId();
+    }
+  }
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  if (epoch_manager.GetCurrentEpochId() <= max_persist_eid) {
+    epoch_manager.SetCurrentEpochId(max_persist_eid + 1);
+  }
+
+  if (logging_mode_ == LoggingModeType::COMMAND) {
+    std::lock_guard<std::mutex> lock(statement_mutex_);
+    statement_ids_.clear();
+    for (auto &logged_statement : LogicalLogRecovery::ReadStatementFile(
+             GetStatementFileFullPath())) {
+      statement_ids_[std::make_pair(logged_statement.database_name,
+                                    logged_statement.query)] =
+          logged_statement.statement_id;
+    }
+
+    std::string file_name = GetStatementFileFullPath();
+    if (LoggingUtil::OpenFile(file_name.c_str(), "ab",
+                              statement_file_handle_) == false) {
+      LOG_ERROR("Unable to open statement file %s", file_name.c_str());
+      return;
+    }
+  }
+
+  for (auto &logger : loggers_) {
+    logger->StartLogging();
+  }
+
+  is_pepoch_running_ = true;
+  is_pepoch_stopped_ = false;
+  pepoch_thread_.reset(
+      new std::thread(&LogicalLogManager::RunPepochLogger, this));
+
+  is_running_ = true;
+}
+
+void LogicalLogManager::StopLogging() {
+  if (is_running_ == false) {
+    return;
+  }
+
+  // stop accepting new transactions first.
+  is_running_ = false;
+
+  // every logger persists its remaining buffers before exiting.
+  for (auto &logger : loggers_) {
+    logger->StopLogging();
+  }
+
+  // the pepoch logger publishes the final persistent epoch before exiting.
+  is_pepoch_running_ = false;
+  pepoch_thread_->join();
+  pepoch_thread_.reset();
+
+  // release the transactions whose epoch will not be persisted.
+  {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+    is_pepoch_stopped_ = true;
+  }
+  persist_cv_.notify_all();
+
+  {
+    std::lock_guard<std::mutex> lock(statement_mutex_);
+    if (statement_file_handle_.file != nullptr) {
+      LoggingUtil::CloseFile(statement_file_handle_);
+    }
+  }
+}
+
+eid_t LogicalLogManager::DoRecovery(const size_t thread_count,
+                                    const eid_t begin_eid) {
+  PELOTON_ASSERT(is_running_ == false);
+
+  LogicalLogRecovery recovery(logging_dir_, thread_count);
+  eid_t recovered_eid = recovery.Recover(begin_eid);
+  recovery_stats_ = recovery.GetStats();
+
+  // the recovered epochs are durable. the pepoch file must not go back.
+  if (recovered_eid != INVALID_EID && persist_epoch_id_ < recovered_eid) {
+    persist_epoch_id_ = recovered_eid;
+  }
+
+  return recovered_eid;
+}
+
+void LogicalLogManager::TruncateLogs(const eid_t eid) {
+  std::vector<std::string> file_names;
+  if (LoggingUtil::GetDirectoryList(logging_dir_.c_str(), file_names) ==
+      false) {
+    return;
+  }
+
+  // the loggers never write to an epoch that is older than the persistent
+  // epoch, so these files are no longer touched.
+  PELOTON_ASSERT(is_running_ == false || eid <= persist_epoch_id_ + 1);
+
+  for (auto &file_name : file_names) {
+    eid_t epoch_id = LoggingUtil::GetEpochIdFromFileName(
+        file_name, LogicalLogger::GetLogFilePrefix());
+    if (epoch_id != INVALID_EID && epoch_id < eid) {
+      std::string full_path = logging_dir_ + "/" + file_name;
+      LoggingUtil::RemoveFile(full_path.c_str());
+    }
+  }
+}
+
+void LogicalLogManager::RegisterWorker() {
+  PELOTON_ASSERT(tl_worker_ctx == nullptr);
+  PELOTON_ASSERT(loggers_.empty() == false);
+
+  oid_t worker_id = worker_count_.fetch_add(1);
+  size_t logger_id = worker_id % loggers_.size();
+
+  std::shared_ptr<WorkerContext> worker_ctx(
+      new WorkerContext(worker_id, logger_id));
+  loggers_[logger_id]->RegisterWorker(worker_ctx);
+
+  tl_worker_ctx = worker_ctx.get();
+}
+
+void LogicalLogManager::DeregisterWorker() {
+  if (tl_worker_ctx == nullptr) {
+    return;
+  }
+
+  loggers_[tl_worker_ctx->logger_id]->DeregisterWorker(tl_worker_ctx);
+  tl_worker_ctx = nullptr;
+}
+
+//===--------------------------------------------------------------------===//
+// Worker Side Logging
+//===--------------------------------------------------------------------===//
+
+void LogicalLogManager::LogBegin(const cid_t &commit_id) {
+  if (is_running_ == false) {
+    return;
+  }
+
+  if (tl_worker_ctx == nullptr) {
+    RegisterWorker();
+  }
+
+  auto worker_ctx = tl_worker_ctx;
+
+  // throttle the worker until the logger has returned a buffer, as the pool
+  // must not be waited on while holding the latch.
+  while (worker_ctx->buffer_pool.GetEmptySlotCount() <= 1) {
+    _mm_pause();
+  }
+
+  // the latch is held until the transaction is completely logged.
+  worker_ctx->latch.Lock();
+
+  // the epoch must be read while holding the latch.
+  // see LogicalLogger::Run() for details.
+  worker_ctx->current_eid =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+  worker_ctx->current_cid = commit_id;
+  worker_ctx->current_record_count = 0;
+
+  auto &current_buffer = worker_ctx->current_buffer;
+  if (current_buffer != nullptr &&
+      current_buffer->GetEpochId() != worker_ctx->current_eid) {
+    if (current_buffer->Empty() == true) {
+      current_buffer->SetEpochId(worker_ctx->current_eid);
+    } else {
+      // the epoch has been changed.
+      auto eid = current_buffer->GetEpochId();
+      worker_ctx->per_epoch_buffers[eid].push_back(std::move(current_buffer));
+    }
+  }
+}
+
+eid_t LogicalLogManager::LogEnd() {
+  auto worker_ctx = tl_worker_ctx;
+  if (worker_ctx == nullptr || worker_ctx->current_cid == INVALID_CID) {
+    return INVALID_EID;
+  }
+
+  // nothing to log for transactions that did not modify any tuple.
+  eid_t logged_eid = INVALID_EID;
+  if (worker_ctx->current_record_count != 0) {
+    LogRecord record = LogRecordFactory::CreateTxnRecord(
+        LogRecordType::TRANSACTION_COMMIT, worker_ctx->current_cid);
+    WriteRecordToBuffer(worker_ctx, record);
+    logged_eid = worker_ctx->current_eid;
+  }
+
+  worker_ctx->current_cid = INVALID_CID;
+  worker_ctx->latch.Unlock();
+
+  return logged_eid;
+}
+
+bool LogicalLogManager::LogCommands(
+    const concurrency::TransactionContext *txn) {
+  auto worker_ctx = tl_worker_ctx;
+  if (logging_mode_ != LoggingModeType::COMMAND || worker_ctx == nullptr ||
+      worker_ctx->current_cid == INVALID_CID) {
+    return false;
+  }
+
+  auto commands = txn->GetCommands();
+  if (commands == nullptr || commands->empty() == true) {
+    return false;
+  }
+
+  // resolve all the statements first. the transaction is logged as tuples
+  // if any of them cannot be recorded.
+  std::vector<oid_t> statement_ids;
+  for (auto &command : *commands) {
+    auto &statement = command.statement;
+    if (statement->GetLogStatementId() == INVALID_OID) {
+      statement->SetLogStatementId(GetStatementId(command.database_name,
+                                                  statement->GetQueryString()));
+    }
+    if (statement->GetLogStatementId() == INVALID_OID) {
+      return false;
+    }
+    statement_ids.push_back(statement->GetLogStatementId());
+  }
+
+  for (size_t i = 0; i < commands->size(); ++i) {
+    LogRecord record = LogRecordFactory::CreateCommandRecord(
+        statement_ids[i], &commands->at(i).params);
+    WriteRecordToBuffer(worker_ctx, record);
+  }
+  return true;
+}
+
+oid_t LogicalLogManager::GetStatementId(const std::string &database_name,
+                                        const std::string &query) {
+  std::lock_guard<std::mutex> lock(statement_mutex_);
+
+  auto key = std::make_pair(database_name, query);
+  auto itr = statement_ids_.find(key);
+  if (itr != statement_ids_.end()) {
+    return itr->second;
+  }
+
+  if (statement_file_handle_.file == nullptr) {
+    return INVALID_OID;
+  }
+
+  oid_t statement_id = statement_ids_.size();
+
+  CopySerializeOutput output;
+  output.WriteInt(0);
+  output.WriteInt(statement_id);
+  output.WriteTextString(database_name);
+  output.WriteTextString(query);
+  output.WriteIntAt(0, static_cast<int32_t>(output.Size() - sizeof(int32_t)));
+
+  // the statement must be durable before any record refers to it.
+  size_t write_count =
+      fwrite(output.Data(), output.Size(), 1, statement_file_handle_.file);
+  if (write_count != 1) {
+    LOG_ERROR("Unable to write statement file");
+    return INVALID_OID;
+  }
+  LoggingUtil::FFlushFsync(statement_file_handle_);
+
+  statement_ids_[key] = statement_id;
+  return statement_id;
+}
+
+void LogicalLogManager::WaitForPersistence(const eid_t eid) {
+  if (persist_epoch_id_ >= eid) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(persist_mutex_);
+  persist_cv_.wait(lock, [this, eid] {
+    return persist_epoch_id_ >= eid || is_pepoch_stopped_ == true;
+  });
+}
+
+void LogicalLogManager::LogInsert(const ItemPointer &tuple_pos) {
+  auto worker_ctx = tl_worker_ctx;
+  if (worker_ctx == nullptr || worker_ctx->current_cid == INVALID_CID) {
+    return;
+  }
+
+  LogRecord record =
+      LogRecordFactory::CreateTupleRecord(LogRecordType::TUPLE_INSERT, tuple_pos);
+  WriteRecordToBuffer(worker_ctx, record);
+}
+
+void LogicalLogManager::LogUpdate(const ItemPointer &old_version,
+                                  const ItemPointer &new_version,
+                                  const std::vector<oid_t> *updated_columns) {
+  auto worker_ctx = tl_worker_ctx;
+  if (worker_ctx == nullptr || worker_ctx->current_cid == INVALID_CID) {
+    return;
+  }
+
+  LogRecord record = LogRecordFactory::CreateTupleRecord(
+      LogRecordType::TUPLE_UPDATE, old_version, new_version, updated_columns);
+  WriteRecordToBuffer(worker_ctx, record);
+}
+
+void LogicalLogManager::LogDelete(const ItemPointer &tuple_pos) {
+  auto worker_ctx = tl_worker_ctx;
+  if (worker_ctx == nullptr || worker_ctx->current_cid == INVALID_CID) {
+    return;
+  }
+
+  LogRecord record =
+      LogRecordFactory::CreateTupleRecord(LogRecordType::TUPLE_DELETE, tuple_pos);
+  WriteRecordToBuffer(worker_ctx, record);
+}
+
+void LogicalLogManager::WriteRecordToBuffer(WorkerContext *worker_ctx,
+                                            LogRecord &record) {
+  auto record_type = record.GetType();
+
+  // the begin record is written lazily, so that transactions that do not
+  // modify the database do not produce any log.
+  if (worker_ctx->current_record_count == 0 &&
+      record_type != LogRecordType::TRANSACTION_BEGIN) {
+    LogRecord begin_record = LogRecordFactory::CreateTxnRecord(
+        LogRecordType::TRANSACTION_BEGIN, worker_ctx->current_cid);
+    WriteRecordToBuffer(worker_ctx, begin_record);
+  }
+  worker_ctx->current_record_count++;
+
+  CopySerializeOutput &output = worker_ctx->output_buffer;
+  output.Reset();
+
+  // reserve space for the record length
+  size_t start = output.Position();
+  output.WriteInt(0);
+
+  output.WriteEnumInSingleByte(static_cast<int>(record_type));
+  output.WriteLong(worker_ctx->current_cid);
+
+  switch (record_type) {
+    case LogRecordType::TUPLE_INSERT:
+    case LogRecordType::TUPLE_DELETE:
+    case LogRecordType::TUPLE_UPDATE: {
+      auto &tuple_pos = record.GetItemPointer();
+      auto tile_group =
+          storage::StorageManager::GetInstance()->GetTileGroup(tuple_pos.block);
+
+      output.WriteInt(tile_group->GetDatabaseId());
+      output.WriteInt(tile_group->GetTableId());
+      output.WriteInt(tuple_pos.block);
+      output.WriteInt(tuple_pos.offset);
+
+      if (record_type == LogRecordType::TUPLE_DELETE) {
+        break;
+      }
+
+      auto schema = tile_group->GetAbstractTable()->GetSchema();
+      auto column_count = schema->GetColumnCount();
+
+      if (record_type == LogRecordType::TUPLE_UPDATE) {
+        auto &old_tuple_pos = record.GetOldItemPointer();
+        output.WriteInt(old_tuple_pos.block);
+        output.WriteInt(old_tuple_pos.offset);
+
+        // only the modified columns of the new version are logged.
+        auto updated_columns = record.GetUpdatedColumns();
+        if (updated_columns != nullptr) {
+          output.WriteInt(updated_columns->size());
+          for (auto column_id : *updated_columns) {
+            output.WriteInt(column_id);
+          }
+          for (auto column_id : *updated_columns) {
+            type::Value value =
+                tile_group->GetValue(tuple_pos.offset, column_id);
+            value.SerializeTo(output);
+          }
+          break;
+        }
+
+        output.WriteInt(column_count);
+        for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+          output.WriteInt(column_id);
+        }
+      }
+
+      for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+        type::Value value = tile_group->GetValue(tuple_pos.offset, column_id);
+        value.SerializeTo(output);
+      }
+      break;
+    }
+    case LogRecordType::COMMAND: {
+      output.WriteInt(record.GetStatementId());
+
+      auto params = record.GetParams();
+      output.WriteInt(params->size());
+      for (auto &param : *params) {
+        output.WriteEnumInSingleByte(static_cast<int>(param.GetTypeId()));
+        param.SerializeTo(output);
+      }
+      break;
+    }
+    case LogRecordType::TRANSACTION_BEGIN:
+    case LogRecordType::TRANSACTION_COMMIT:
+      break;
+    default:
+      LOG_ERROR("Unsupported log record type %s",
+                LogRecordTypeToString(record_type).c_str());
+      PELOTON_ASSERT(false);
+  }
+
+  output.WriteIntAt(start, static_cast<int32_t>(output.Size() - sizeof(int32_t)));
+
+  auto &current_buffer = worker_ctx->current_buffer;
+  if (current_buffer == nullptr) {
+    current_buffer = AcquireLogBuffer(worker_ctx);
+  }
+
+  if (current_buffer->WriteData(output.Data(), output.Size()) == false) {
+    // the buffer is full. hand it over to the logger.
+    // the logger cannot take it before the transaction is completely logged,
+    // since the latch is held until LogEnd().
+    worker_ctx->per_epoch_buffers[worker_ctx->current_eid].push_back(
+        std::move(current_buffer));
+
+    current_buffer = AcquireLogBuffer(worker_ctx);
+
+    UNUSED_ATTRIBUTE bool res =
+        current_buffer->WriteData(output.Data(), output.Size());
+    PELOTON_ASSERT(res == true);
+  }
+}
+
+std::unique_ptr<LogBuffer> LogicalLogManager::AcquireLogBuffer(
+    WorkerContext *worker_ctx) {
+  // the caller holds the latch, so it must not wait for the logger to
+  // return a buffer to the pool. LogBegin() waits for a free buffer before
+  // taking the latch; a transaction that outgrows the pool gets buffers that
+  // do not belong to it, and the logger releases them once persisted.
+  if (worker_ctx->buffer_pool.GetEmptySlotCount() > 1) {
+    return worker_ctx->buffer_pool.GetBuffer(worker_ctx->current_eid);
+  }
+  return std::unique_ptr<LogBuffer>(
+      new LogBuffer(worker_ctx->worker_id, worker_ctx->current_eid));
+}
+
+//===--------------------------------------------------------------------===//
+// Persistent Epoch
+//===--------------------------------------------------------------------===//
+
+void LogicalLogManager::RunPepochLogger() {
+  FileHandle file_handle;
+  std::string file_name = GetPepochFileFullPath();
+  bool res = LoggingUtil::OpenFile(file_name.c_str(), "ab", file_handle);
+  if (res == false) {
+    LOG_ERROR("Unable to open pepoch file %s", file_name.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  while (is_pepoch_running_ == true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    UpdatePersistEpoch(file_handle);
+  }
+
+  // all the loggers have stopped. publish the final epoch.
+  UpdatePersistEpoch(file_handle);
+
+  LoggingUtil::CloseFile(file_handle);
+}
+
+void LogicalLogManager::UpdatePersistEpoch(FileHandle &file_handle) {
+  eid_t min_persist_eid = MAX_EID;
+  for (auto &logger : loggers_) {
+    auto logger_persist_eid = logger->GetPersistEpochId();
+    if (logger_persist_eid < min_persist_eid) {
+      min_persist_eid = logger_persist_eid;
+    }
+  }
+
+  if (min_persist_eid == MAX_EID || min_persist_eid <= persist_epoch_id_) {
+    return;
+  }
+
+  size_t write_count =
+      fwrite((const void *)(&min_persist_eid), sizeof(min_persist_eid), 1,
+             file_handle.file);
+  if (write_count != 1) {
+    LOG_ERROR("Unable to write pepoch file");
+    exit(EXIT_FAILURE);
+  }
+
+  LoggingUtil::FFlushFsync(file_handle);
+
+  {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+    persist_epoch_id_ = min_persist_eid;
+  }
+  persist_cv_.notify_all();
+}
+
+}  // namespace logging
+}  // namespace peloton
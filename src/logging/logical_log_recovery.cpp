@@ -0,0 +1,1001 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_recovery.cpp
+//
+// Identification: src/logging/logical_log_recovery.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+#include "binder/bind_node_visitor.h"
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "common/statement.h"
+#include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_recovery.h"
+#include "logging/logical_logger.h"
+#include "optimizer/optimizer.h"
+#include "parser/postgresparser.h"
+#include "planner/abstract_plan.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/serializeio.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace logging {
+
+eid_t LogicalLogRecovery::Recover(const eid_t begin_eid) {
+  std::vector<LogFile> files;
+
+  eid_t persist_eid = ReadPersistEpochId();
+  if (persist_eid == INVALID_EID) {
+    LOG_INFO("No persistent epoch is found in %s", log_dir_.c_str());
+  } else {
+    files = ListLogFiles(begin_eid, persist_eid);
+  }
+
+  Timer<std::milli> read_timer, replay_timer, index_timer;
+
+  eid_t max_eid = INVALID_EID;
+  // the indexes are rebuilt from every table the first time, and from the
+  // recovered tile groups once they are stale.
+  bool indexes_rebuilt = false;
+  bool indexes_stale = false;
+  size_t batch_begin = 0;
+  while (batch_begin < files.size()) {
+    // every batch holds at least one file.
+    size_t batch_end = batch_begin;
+    size_t batch_bytes = 0;
+    while (batch_end < files.size() &&
+           (batch_end == batch_begin ||
+            batch_bytes + files[batch_end].file_size <= batch_size_)) {
+      batch_bytes += files[batch_end].file_size;
+      max_eid = std::max(max_eid, files[batch_end].epoch_id);
+      batch_end++;
+    }
+
+    // the records point into the file data, which must outlive the replay.
+    std::vector<std::unique_ptr<char[]>> file_data(batch_end - batch_begin);
+    PartitionedRecords partitions(
+        thread_count_, std::vector<std::vector<ReplayRecord>>(thread_count_));
+
+    read_timer.Start();
+    ReadBatch(files, batch_begin, batch_end, file_data, partitions);
+    read_timer.Stop();
+
+    std::sort(commands_.begin(), commands_.end(),
+              [](const CommandRecord &lhs, const CommandRecord &rhs) {
+                if (lhs.commit_id != rhs.commit_id) {
+                  return lhs.commit_id < rhs.commit_id;
+                }
+                return lhs.sequence < rhs.sequence;
+              });
+
+    // the transactions logged as commands split the tuple records of the
+    // batch into segments, so that both are replayed in commit order.
+    size_t command_itr = 0;
+    while (true) {
+      cid_t end_cid = MAX_CID;
+      if (command_itr < commands_.size()) {
+        end_cid = commands_[command_itr].commit_id;
+      }
+
+      replay_timer.Start();
+      if (ReplayRecords(SplitRecords(partitions, end_cid)) == true) {
+        indexes_stale = true;
+      }
+      replay_timer.Stop();
+
+      if (end_cid == MAX_CID) {
+        break;
+      }
+
+      // the statements are executed by new transactions, on top of the
+      // tuples and indexes recovered so far.
+      if (indexes_stale == true || indexes_rebuilt == false) {
+        index_timer.Start();
+        RebuildIndexes(indexes_rebuilt == false);
+        index_timer.Stop();
+        indexes_rebuilt = true;
+        indexes_stale = false;
+      }
+      PrepareNewTransactions(max_eid);
+
+      replay_timer.Start();
+      ReplayCommands(command_itr);
+      replay_timer.Stop();
+    }
+    std::vector<CommandRecord>().swap(commands_);
+
+    stats_.file_count += batch_end - batch_begin;
+    stats_.byte_count += batch_bytes;
+
+    batch_begin = batch_end;
+  }
+
+  // rebuild the indexes once, rather than maintaining them per tuple.
+  // every table is visited, as tuples may also have been loaded from a
+  // checkpoint before replaying the log.
+  index_timer.Start();
+  RebuildIndexes(true);
+  index_timer.Stop();
+
+  stats_.read_time_ms = read_timer.GetDuration();
+  stats_.replay_time_ms = replay_timer.GetDuration();
+  stats_.index_time_ms = index_timer.GetDuration();
+
+  PrepareNewTransactions(max_eid);
+
+  LOG_INFO(
+      "Recovered %lu records of %lu transactions from %lu files (%lu bytes) "
+      "in %.2f ms: %.2f records/s",
+      stats_.record_count, stats_.txn_count, stats_.file_count,
+      stats_.byte_count, stats_.GetTotalTimeMs(), stats_.GetThroughput());
+  if (stats_.skipped_record_count != 0) {
+    LOG_ERROR("Skipped %lu records that cannot be resolved",
+              stats_.skipped_record_count);
+  }
+  if (stats_.command_count != 0) {
+    LOG_INFO("Re-executed %lu logged statements, %lu of them failed",
+             stats_.command_count, stats_.failed_command_count);
+  }
+
+  return max_eid;
+}
+
+LogicalLogRecovery::PartitionedRecords LogicalLogRecovery::SplitRecords(
+    PartitionedRecords &partitions, const cid_t end_cid) {
+  PartitionedRecords segment(
+      thread_count_, std::vector<std::vector<ReplayRecord>>(thread_count_));
+  for (size_t i = 0; i < thread_count_; ++i) {
+    for (size_t j = 0; j < thread_count_; ++j) {
+      auto &records = partitions[i][j];
+      if (end_cid == MAX_CID) {
+        segment[i][j].swap(records);
+        continue;
+      }
+
+      auto segment_end = std::stable_partition(
+          records.begin(), records.end(),
+          [end_cid](const ReplayRecord &record) {
+            return record.commit_id < end_cid;
+          });
+      segment[i][j].assign(records.begin(), segment_end);
+      records.erase(records.begin(), segment_end);
+    }
+  }
+  return segment;
+}
+
+bool LogicalLogRecovery::ReplayRecords(PartitionedRecords &&partitions) {
+  std::vector<size_t> record_counts(thread_count_, 0);
+  std::vector<size_t> skipped_counts(thread_count_, 0);
+  std::vector<std::vector<ReplayRecord>> new_versions(thread_count_);
+  std::vector<std::vector<ReplayRecord>> old_versions(thread_count_);
+
+  bool is_empty = true;
+  for (auto &thread_partitions : partitions) {
+    for (auto &records : thread_partitions) {
+      is_empty = is_empty && records.empty();
+    }
+  }
+  if (is_empty == true) {
+    return false;
+  }
+
+  std::vector<std::thread> replay_threads;
+  for (size_t i = 0; i < thread_count_; ++i) {
+    replay_threads.emplace_back(
+        &LogicalLogRecovery::ReplayPartition, this, i, std::ref(partitions),
+        std::ref(record_counts[i]), std::ref(skipped_counts[i]),
+        std::ref(new_versions[i]), std::ref(old_versions[i]));
+  }
+  for (auto &replay_thread : replay_threads) {
+    replay_thread.join();
+  }
+
+  // the new versions are built from the old versions, which must not have
+  // been invalidated yet.
+  ReplayNewVersions(new_versions, stats_.record_count,
+                    stats_.delta_record_count, stats_.skipped_record_count);
+
+  replay_threads.clear();
+  for (size_t i = 0; i < thread_count_; ++i) {
+    replay_threads.emplace_back(&LogicalLogRecovery::ReplayOldVersions, this,
+                                i, std::cref(old_versions[i]),
+                                std::ref(skipped_counts[i]));
+  }
+  for (auto &replay_thread : replay_threads) {
+    replay_thread.join();
+  }
+
+  for (size_t i = 0; i < thread_count_; ++i) {
+    stats_.record_count += record_counts[i];
+    stats_.skipped_record_count += skipped_counts[i];
+  }
+  return true;
+}
+
+void LogicalLogRecovery::PrepareNewTransactions(const eid_t max_eid) {
+  oid_t max_tile_group_id = 0;
+  for (auto &partition_tile_groups : recovered_tile_groups_) {
+    for (auto &entry : partition_tile_groups) {
+      max_tile_group_id = std::max(max_tile_group_id, entry.first);
+    }
+  }
+
+  // new tile groups must not reuse the ids of the recovered ones.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  if (storage_manager->GetCurrentTileGroupId() < max_tile_group_id) {
+    storage_manager->SetNextTileGroupId(max_tile_group_id);
+  }
+
+  // new transactions must observe the recovered versions.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  if (max_eid != INVALID_EID && epoch_manager.GetCurrentEpochId() <= max_eid) {
+    epoch_manager.SetCurrentEpochId(max_eid + 1);
+  }
+}
+
+void LogicalLogRecovery::RebuildIndexes(const bool all_tables) {
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+  if (all_tables == true) {
+    auto storage_manager = storage::StorageManager::GetInstance();
+    auto database_count = storage_manager->GetDatabaseCount();
+    for (oid_t database_itr = 0; database_itr < database_count;
+         ++database_itr) {
+      auto database = storage_manager->GetDatabaseWithOffset(database_itr);
+      auto table_count = database->GetTableCount();
+      for (oid_t table_itr = 0; table_itr < table_count; ++table_itr) {
+        auto table = database->GetTable(table_itr);
+        auto tile_group_count = table->GetTileGroupCount();
+        for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+             ++tile_group_itr) {
+          auto tile_group = table->GetTileGroup(tile_group_itr);
+          if (tile_group != nullptr) {
+            tile_groups.push_back(tile_group);
+          }
+        }
+      }
+    }
+  } else {
+    // the tuples of the other tile groups are already indexed.
+    for (auto &partition_tile_groups : recovered_tile_groups_) {
+      for (auto &entry : partition_tile_groups) {
+        if (entry.second != nullptr) {
+          tile_groups.push_back(entry.second);
+        }
+      }
+    }
+  }
+
+  std::vector<std::thread> index_threads;
+  for (size_t i = 0; i < thread_count_; ++i) {
+    index_threads.emplace_back(&LogicalLogRecovery::RebuildTileGroupIndexes,
+                               this, std::cref(tile_groups), i);
+  }
+  for (auto &index_thread : index_threads) {
+    index_thread.join();
+  }
+}
+
+eid_t LogicalLogRecovery::ReadPersistEpochId() {
+  std::string file_name = log_dir_ + "/" + pepoch_filename_;
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(file_name.c_str(), "rb", file_handle) == false) {
+    return INVALID_EID;
+  }
+
+  // the last complete entry is the latest persistent epoch.
+  eid_t persist_eid = INVALID_EID;
+  size_t entry_count = LoggingUtil::GetFileSize(file_handle) / sizeof(eid_t);
+  if (entry_count != 0 &&
+      fseek(file_handle.file, (entry_count - 1) * sizeof(eid_t), SEEK_SET) ==
+          0) {
+    if (LoggingUtil::ReadNBytesFromFile(file_handle, &persist_eid,
+                                        sizeof(persist_eid)) == false) {
+      persist_eid = INVALID_EID;
+    }
+  }
+
+  LoggingUtil::CloseFile(file_handle);
+  return persist_eid;
+}
+
+std::vector<LogicalLogRecovery::LogFile> LogicalLogRecovery::ListLogFiles(
+    const eid_t begin_eid, const eid_t persist_eid) {
+  std::vector<LogFile> files;
+
+  std::vector<std::string> file_names;
+  if (LoggingUtil::GetDirectoryList(log_dir_.c_str(), file_names) == false) {
+    return files;
+  }
+
+  for (auto &file_name : file_names) {
+    eid_t epoch_id = LoggingUtil::GetEpochIdFromFileName(
+        file_name, LogicalLogger::GetLogFilePrefix());
+    if (epoch_id == INVALID_EID || epoch_id < begin_eid ||
+        epoch_id > persist_eid) {
+      continue;
+    }
+
+    std::string full_path = log_dir_ + "/" + file_name;
+    FileHandle file_handle;
+    if (LoggingUtil::OpenFile(full_path.c_str(), "rb", file_handle) == false) {
+      continue;
+    }
+    size_t file_size = LoggingUtil::GetFileSize(file_handle);
+    LoggingUtil::CloseFile(file_handle);
+
+    files.push_back({full_path, epoch_id, file_size});
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const LogFile &lhs, const LogFile &rhs) {
+              return lhs.epoch_id < rhs.epoch_id;
+            });
+
+  return files;
+}
+
+void LogicalLogRecovery::ReadBatch(
+    const std::vector<LogFile> &files, const size_t begin, const size_t end,
+    std::vector<std::unique_ptr<char[]>> &file_data,
+    PartitionedRecords &partitions) {
+  std::vector<size_t> txn_counts(thread_count_, 0);
+  std::vector<std::vector<CommandRecord>> commands(thread_count_);
+
+  auto read_files = [&](const size_t thread_id) {
+    for (size_t i = begin + thread_id; i < end; i += thread_count_) {
+      auto &file = files[i];
+      auto &data = file_data[i - begin];
+
+      FileHandle file_handle;
+      if (LoggingUtil::OpenFile(file.file_name.c_str(), "rb", file_handle) ==
+          false) {
+        LOG_ERROR("Unable to open log file %s", file.file_name.c_str());
+        continue;
+      }
+
+      // a single sequential read of the whole file.
+      data.reset(new char[file.file_size]);
+      bool res = LoggingUtil::ReadNBytesFromFile(file_handle, data.get(),
+                                                 file.file_size);
+      LoggingUtil::CloseFile(file_handle);
+      if (res == false) {
+        LOG_ERROR("Unable to read log file %s", file.file_name.c_str());
+        continue;
+      }
+
+      ParseLogFile(data.get(), file.file_size, partitions[thread_id],
+                   commands[thread_id], txn_counts[thread_id]);
+    }
+  };
+
+  std::vector<std::thread> read_threads;
+  for (size_t i = 0; i < thread_count_; ++i) {
+    read_threads.emplace_back(read_files, i);
+  }
+  for (auto &read_thread : read_threads) {
+    read_thread.join();
+  }
+
+  for (auto txn_count : txn_counts) {
+    stats_.txn_count += txn_count;
+  }
+
+  for (auto &thread_commands : commands) {
+    std::move(thread_commands.begin(), thread_commands.end(),
+              std::back_inserter(commands_));
+  }
+}
+
+void LogicalLogRecovery::ParseLogFile(
+    const char *data, const size_t size,
+    std::vector<std::vector<ReplayRecord>> &partitions,
+    std::vector<CommandRecord> &commands, size_t &txn_count) {
+  // records of the transaction that is being parsed.
+  std::vector<ReplayRecord> txn_records;
+  std::vector<CommandRecord> txn_commands;
+  cid_t txn_cid = INVALID_CID;
+
+  size_t pos = 0;
+  while (pos + sizeof(int32_t) <= size) {
+    int32_t record_length;
+    PELOTON_MEMCPY(&record_length, data + pos, sizeof(record_length));
+    pos += sizeof(record_length);
+
+    // the tail of the file may be a partially written record.
+    if (record_length <= 0 || pos + record_length > size) {
+      break;
+    }
+
+    const char *record_end = data + pos + record_length;
+    ReferenceSerializeInput input(data + pos, record_length);
+    pos += record_length;
+
+    auto record_type = static_cast<LogRecordType>(input.ReadEnumInSingleByte());
+    cid_t commit_id = input.ReadLong();
+
+    switch (record_type) {
+      case LogRecordType::TRANSACTION_BEGIN: {
+        txn_records.clear();
+        txn_commands.clear();
+        txn_cid = commit_id;
+        break;
+      }
+      case LogRecordType::TRANSACTION_COMMIT: {
+        if (commit_id == txn_cid) {
+          for (auto &record : txn_records) {
+            partitions[GetPartitionId(record.location.block)].push_back(record);
+          }
+          std::move(txn_commands.begin(), txn_commands.end(),
+                    std::back_inserter(commands));
+          txn_count++;
+        }
+        txn_records.clear();
+        txn_commands.clear();
+        txn_cid = INVALID_CID;
+        break;
+      }
+      case LogRecordType::COMMAND: {
+        if (commit_id != txn_cid) {
+          break;
+        }
+
+        CommandRecord command;
+        command.commit_id = commit_id;
+        command.sequence = txn_commands.size();
+        command.statement_id = input.ReadInt();
+        auto params = static_cast<const char *>(input.getRawPointer(0));
+        command.params.assign(params, record_end - params);
+        txn_commands.push_back(std::move(command));
+        break;
+      }
+      case LogRecordType::TUPLE_INSERT:
+      case LogRecordType::TUPLE_DELETE:
+      case LogRecordType::TUPLE_UPDATE: {
+        if (commit_id != txn_cid) {
+          // the begin record of this transaction is lost.
+          break;
+        }
+
+        ReplayRecord record;
+        record.commit_id = commit_id;
+        record.type = record_type;
+        record.database_id = input.ReadInt();
+        record.table_id = input.ReadInt();
+        record.location.block = input.ReadInt();
+        record.location.offset = input.ReadInt();
+        record.old_location = INVALID_ITEMPOINTER;
+        record.data = nullptr;
+        record.data_size = 0;
+
+        if (record_type == LogRecordType::TUPLE_DELETE) {
+          txn_records.push_back(record);
+          break;
+        }
+
+        if (record_type == LogRecordType::TUPLE_UPDATE) {
+          ItemPointer old_location;
+          old_location.block = input.ReadInt();
+          old_location.offset = input.ReadInt();
+
+          // invalidate the old version.
+          ReplayRecord old_record = record;
+          old_record.location = old_location;
+          old_record.new_location = record.location;
+          txn_records.push_back(old_record);
+
+          // and insert the new version, which only holds the modified
+          // columns.
+          record.type = LogRecordType::TUPLE_INSERT;
+          record.old_location = old_location;
+        }
+
+        record.data = static_cast<const char *>(input.getRawPointer(0));
+        record.data_size = record_end - record.data;
+        txn_records.push_back(record);
+        break;
+      }
+      default: {
+        LOG_ERROR("Unknown log record type %s",
+                  LogRecordTypeToString(record_type).c_str());
+        break;
+      }
+    }
+  }
+}
+
+void LogicalLogRecovery::ReplayPartition(
+    const size_t partition_id, PartitionedRecords &partitions,
+    size_t &record_count, size_t &skipped_count,
+    std::vector<ReplayRecord> &new_versions,
+    std::vector<ReplayRecord> &old_versions) {
+  std::vector<ReplayRecord> records;
+  for (auto &thread_partitions : partitions) {
+    auto &thread_records = thread_partitions[partition_id];
+    records.insert(records.end(), thread_records.begin(), thread_records.end());
+    std::vector<ReplayRecord>().swap(thread_records);
+  }
+
+  // replay the records tile group by tile group.
+  std::sort(records.begin(), records.end(),
+            [](const ReplayRecord &lhs, const ReplayRecord &rhs) {
+              if (lhs.location.block != rhs.location.block) {
+                return lhs.location.block < rhs.location.block;
+              }
+              if (lhs.location.offset != rhs.location.offset) {
+                return lhs.location.offset < rhs.location.offset;
+              }
+              return lhs.commit_id < rhs.commit_id;
+            });
+
+  // holds the varlen values of the deserialized tuples.
+  type::EphemeralPool pool;
+
+  for (auto &record : records) {
+    auto tile_group = ResolveTileGroup(partition_id, record);
+    if (tile_group == nullptr) {
+      skipped_count++;
+      continue;
+    }
+
+    if (record.type == LogRecordType::TUPLE_UPDATE) {
+      old_versions.push_back(record);
+      continue;
+    }
+    if (record.old_location.IsNull() == false) {
+      new_versions.push_back(record);
+      continue;
+    }
+
+    oid_t tuple_slot = INVALID_OID;
+    switch (record.type) {
+      case LogRecordType::TUPLE_INSERT: {
+        auto schema = tile_group->GetAbstractTable()->GetSchema();
+        storage::Tuple tuple(schema, true);
+
+        ReferenceSerializeInput input(record.data, record.data_size);
+        auto column_count = schema->GetColumnCount();
+        for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+          auto value = type::Value::DeserializeFrom(
+              input, schema->GetType(column_id), &pool);
+          tuple.SetValue(column_id, value, &pool);
+        }
+
+        tuple_slot = tile_group->InsertTupleFromRecovery(
+            record.commit_id, record.location.offset, &tuple);
+        break;
+      }
+      case LogRecordType::TUPLE_DELETE: {
+        tuple_slot = tile_group->DeleteTupleFromRecovery(
+            record.commit_id, record.location.offset);
+        break;
+      }
+      default:
+        break;
+    }
+
+    if (tuple_slot == INVALID_OID) {
+      LOG_ERROR("Cannot replay record at (%u, %u)", record.location.block,
+                record.location.offset);
+      skipped_count++;
+      continue;
+    }
+
+    record_count++;
+  }
+}
+
+void LogicalLogRecovery::ReplayNewVersions(
+    std::vector<std::vector<ReplayRecord>> &new_versions, size_t &record_count,
+    size_t &delta_count, size_t &skipped_count) {
+  std::vector<ReplayRecord> records;
+  for (auto &partition_records : new_versions) {
+    records.insert(records.end(), partition_records.begin(),
+                   partition_records.end());
+    std::vector<ReplayRecord>().swap(partition_records);
+  }
+
+  if (records.empty() == true) {
+    return;
+  }
+
+  // the slot of a reclaimed version may be reused by a later update in the
+  // same batch, so a location does not identify a single version. the
+  // updates that share a location, either as their new or their old version,
+  // are grouped together and replayed by a single thread in commit id order.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const ReplayRecord &lhs, const ReplayRecord &rhs) {
+                     return lhs.commit_id < rhs.commit_id;
+                   });
+
+  std::unordered_map<ItemPointer, size_t, ItemPointerHasher,
+                     ItemPointerComparator> location_ids;
+  std::vector<size_t> parents;
+  auto get_location_id = [&](const ItemPointer &location) {
+    auto result = location_ids.emplace(location, parents.size());
+    if (result.second == true) {
+      parents.push_back(parents.size());
+    }
+    return result.first->second;
+  };
+  auto find_root = [&](size_t location_id) {
+    while (parents[location_id] != location_id) {
+      parents[location_id] = parents[parents[location_id]];
+      location_id = parents[location_id];
+    }
+    return location_id;
+  };
+
+  for (auto &record : records) {
+    auto new_root = find_root(get_location_id(record.location));
+    auto old_root = find_root(get_location_id(record.old_location));
+    parents[new_root] = old_root;
+  }
+
+  // the records of every group are in commit id order.
+  std::unordered_map<size_t, size_t> group_ids;
+  std::vector<std::vector<size_t>> groups;
+  for (size_t i = 0; i < records.size(); ++i) {
+    auto root = find_root(location_ids[records[i].location]);
+    auto result = group_ids.emplace(root, groups.size());
+    if (result.second == true) {
+      groups.emplace_back();
+    }
+    groups[result.first->second].push_back(i);
+  }
+
+  std::vector<size_t> record_counts(thread_count_, 0);
+  std::vector<size_t> delta_counts(thread_count_, 0);
+  std::vector<size_t> skipped_counts(thread_count_, 0);
+
+  auto replay_groups = [&](const size_t thread_id) {
+    // holds the varlen values of the deserialized tuples.
+    type::EphemeralPool pool;
+
+    for (size_t i = thread_id; i < groups.size(); i += thread_count_) {
+      for (auto record_itr : groups[i]) {
+        ReplayNewVersion(records[record_itr], &pool, record_counts[thread_id],
+                         delta_counts[thread_id], skipped_counts[thread_id]);
+      }
+    }
+  };
+
+  std::vector<std::thread> replay_threads;
+  for (size_t i = 0; i < thread_count_; ++i) {
+    replay_threads.emplace_back(replay_groups, i);
+  }
+  for (auto &replay_thread : replay_threads) {
+    replay_thread.join();
+  }
+
+  for (size_t i = 0; i < thread_count_; ++i) {
+    record_count += record_counts[i];
+    delta_count += delta_counts[i];
+    skipped_count += skipped_counts[i];
+  }
+}
+
+void LogicalLogRecovery::ReplayNewVersion(const ReplayRecord &record,
+                                          type::AbstractPool *pool,
+                                          size_t &record_count,
+                                          size_t &delta_count,
+                                          size_t &skipped_count) {
+  // the tile group has been resolved while replaying its partition.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto tile_group = storage_manager->GetTileGroup(record.location.block);
+  if (tile_group == nullptr) {
+    skipped_count++;
+    return;
+  }
+
+  // the version has been loaded from a checkpoint, or replaced by a later
+  // delete.
+  cid_t current_begin_cid =
+      tile_group->GetHeader()->GetBeginCommitId(record.location.offset);
+  if (current_begin_cid != MAX_CID && current_begin_cid >= record.commit_id) {
+    record_count++;
+    return;
+  }
+
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  auto column_count = schema->GetColumnCount();
+  storage::Tuple tuple(schema, true);
+
+  ReferenceSerializeInput input(record.data, record.data_size);
+  std::vector<oid_t> column_ids(input.ReadInt());
+  for (auto &column_id : column_ids) {
+    column_id = input.ReadInt();
+  }
+
+  // the unmodified columns are copied from the old version.
+  if (column_ids.size() != column_count) {
+    auto old_tile_group =
+        storage_manager->GetTileGroup(record.old_location.block);
+    auto old_tuple_slot = record.old_location.offset;
+    if (old_tile_group == nullptr ||
+        old_tile_group->GetHeader()->GetTransactionId(old_tuple_slot) !=
+            INITIAL_TXN_ID) {
+      LOG_ERROR("Cannot find the old version (%u, %u) of (%u, %u)",
+                record.old_location.block, record.old_location.offset,
+                record.location.block, record.location.offset);
+      skipped_count++;
+      return;
+    }
+
+    for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+      tuple.SetValue(column_id,
+                     old_tile_group->GetValue(old_tuple_slot, column_id), pool);
+    }
+    delta_count++;
+  }
+
+  for (auto column_id : column_ids) {
+    auto value =
+        type::Value::DeserializeFrom(input, schema->GetType(column_id), pool);
+    tuple.SetValue(column_id, value, pool);
+  }
+
+  if (tile_group->InsertTupleFromRecovery(
+          record.commit_id, record.location.offset, &tuple) == INVALID_OID) {
+    LOG_ERROR("Cannot replay record at (%u, %u)", record.location.block,
+              record.location.offset);
+    skipped_count++;
+    return;
+  }
+
+  record_count++;
+}
+
+void LogicalLogRecovery::ReplayOldVersions(
+    const size_t partition_id, const std::vector<ReplayRecord> &old_versions,
+    size_t &skipped_count) {
+  for (auto &record : old_versions) {
+    auto tile_group = ResolveTileGroup(partition_id, record);
+    if (tile_group->UpdateTupleFromRecovery(record.commit_id,
+                                            record.location.offset,
+                                            record.new_location) ==
+        INVALID_OID) {
+      LOG_ERROR("Cannot replay record at (%u, %u)", record.location.block,
+                record.location.offset);
+      skipped_count++;
+    }
+  }
+}
+
+void LogicalLogRecovery::ReplayCommands(size_t &command_itr) {
+  if (statement_file_read_ == false) {
+    for (auto &logged_statement :
+         ReadStatementFile(log_dir_ + "/" + statement_filename_)) {
+      logged_statements_[logged_statement.statement_id] = logged_statement;
+    }
+    statement_file_read_ = true;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &parser = parser::PostgresParser::GetInstance();
+  optimizer::Optimizer optimizer;
+
+  // holds the varlen values of the deserialized parameters.
+  type::EphemeralPool pool;
+
+  cid_t commit_id = commands_[command_itr].commit_id;
+  auto txn = txn_manager.BeginTransaction();
+
+  bool success = true;
+  for (; command_itr < commands_.size() &&
+         commands_[command_itr].commit_id == commit_id;
+       ++command_itr) {
+    if (success == false) {
+      continue;
+    }
+    auto &command = commands_[command_itr];
+    stats_.command_count++;
+
+    try {
+      // every statement is planned once, and re-executed with the
+      // parameters of every command.
+      auto &statement = statements_[command.statement_id];
+      if (statement == nullptr) {
+        auto logged_statement = logged_statements_.find(command.statement_id);
+        if (logged_statement == logged_statements_.end()) {
+          throw Exception("Unknown statement " +
+                          std::to_string(command.statement_id));
+        }
+        auto &query = logged_statement->second.query;
+        auto sql_stmt_list = parser.BuildParseTree(query);
+        if (sql_stmt_list == nullptr || sql_stmt_list->is_valid == false) {
+          throw ParserException("Error Parsing SQL statement");
+        }
+        auto query_type = StatementTypeToQueryType(
+            sql_stmt_list->GetStatement(0)->GetType(),
+            sql_stmt_list->GetStatement(0));
+        statement.reset(
+            new Statement("", query_type, query, std::move(sql_stmt_list)));
+
+        auto bind_node_visitor = binder::BindNodeVisitor(
+            txn, logged_statement->second.database_name);
+        bind_node_visitor.BindNameToNode(
+            statement->GetStmtParseTreeList()->GetStatement(0));
+        statement->SetPlanTree(optimizer.BuildPelotonPlanTree(
+            statement->GetStmtParseTreeList(), txn));
+      }
+
+      ReferenceSerializeInput input(command.params.data(),
+                                    command.params.size());
+      std::vector<type::Value> params(input.ReadInt());
+      for (auto &param : params) {
+        auto type_id = static_cast<type::TypeId>(input.ReadEnumInSingleByte());
+        param = type::Value::DeserializeFrom(input, type_id, &pool);
+      }
+
+      auto plan = statement->GetPlanTree();
+      if (params.empty() == false) {
+        plan->SetParameterValues(&params);
+      }
+
+      // the plan is executed synchronously.
+      ResultType result = ResultType::FAILURE;
+      executor::PlanExecutor::ExecutePlan(
+          plan, txn, params, std::vector<int>(),
+          [&result](executor::ExecutionResult status,
+                    std::vector<ResultValue> &&values UNUSED_ATTRIBUTE) {
+            result = status.m_result;
+          });
+      success = result == ResultType::SUCCESS &&
+                txn->GetResult() == ResultType::SUCCESS;
+    } catch (Exception &e) {
+      LOG_ERROR("Cannot replay statement %u: %s", command.statement_id,
+                e.what());
+      success = false;
+    }
+
+    if (success == false) {
+      stats_.failed_command_count++;
+    }
+  }
+
+  if (success == true) {
+    txn_manager.CommitTransaction(txn);
+  } else {
+    txn_manager.AbortTransaction(txn);
+  }
+}
+
+std::vector<LoggedStatement> LogicalLogRecovery::ReadStatementFile(
+    const std::string &file_name) {
+  std::vector<LoggedStatement> logged_statements;
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(file_name.c_str(), "rb", file_handle) == false) {
+    return logged_statements;
+  }
+
+  size_t file_size = LoggingUtil::GetFileSize(file_handle);
+  std::unique_ptr<char[]> data(new char[file_size]);
+  bool res =
+      LoggingUtil::ReadNBytesFromFile(file_handle, data.get(), file_size);
+  LoggingUtil::CloseFile(file_handle);
+  if (res == false) {
+    LOG_ERROR("Unable to read statement file %s", file_name.c_str());
+    return logged_statements;
+  }
+
+  size_t pos = 0;
+  while (pos + sizeof(int32_t) <= file_size) {
+    int32_t entry_length;
+    PELOTON_MEMCPY(&entry_length, data.get() + pos, sizeof(entry_length));
+    pos += sizeof(entry_length);
+
+    if (entry_length <= 0 || pos + entry_length > file_size) {
+      break;
+    }
+
+    ReferenceSerializeInput input(data.get() + pos, entry_length);
+    pos += entry_length;
+
+    LoggedStatement logged_statement;
+    logged_statement.statement_id = input.ReadInt();
+    logged_statement.database_name = input.ReadTextString();
+    logged_statement.query = input.ReadTextString();
+    logged_statements.push_back(std::move(logged_statement));
+  }
+
+  return logged_statements;
+}
+
+storage::TileGroup *LogicalLogRecovery::ResolveTileGroup(
+    const size_t partition_id, const ReplayRecord &record) {
+  auto tile_group_id = record.location.block;
+
+  // a tile group is only touched by the partition it is hashed to.
+  auto &tile_groups = recovered_tile_groups_[partition_id];
+  auto itr = tile_groups.find(tile_group_id);
+  if (itr != tile_groups.end()) {
+    return itr->second.get();
+  }
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  std::shared_ptr<storage::TileGroup> tile_group;
+  try {
+    auto table = storage_manager->GetTableWithOid(record.database_id,
+                                                  record.table_id);
+    tile_group = storage_manager->GetTileGroup(tile_group_id);
+    if (tile_group == nullptr) {
+      table->AddTileGroupWithOidForRecovery(tile_group_id);
+      tile_group = storage_manager->GetTileGroup(tile_group_id);
+    } else if (tile_group->GetTableId() != record.table_id) {
+      LOG_ERROR("Tile group %u is owned by table %u rather than table %u",
+                tile_group_id, tile_group->GetTableId(), record.table_id);
+      tile_group = nullptr;
+    }
+  } catch (CatalogException &e) {
+    LOG_ERROR("Cannot find table %u in database %u", record.table_id,
+              record.database_id);
+  }
+
+  tile_groups[tile_group_id] = tile_group;
+  return tile_group.get();
+}
+
+void LogicalLogRecovery::RebuildTileGroupIndexes(
+    const std::vector<std::shared_ptr<storage::TileGroup>> &tile_groups,
+    const size_t thread_id) {
+  std::unordered_map<storage::DataTable *, size_t> tuple_counts;
+
+  for (size_t i = thread_id; i < tile_groups.size(); i += thread_count_) {
+    auto tile_group = tile_groups[i].get();
+    auto tile_group_header = tile_group->GetHeader();
+    auto table =
+        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+    PELOTON_ASSERT(table != nullptr);
+
+    auto &tuple_count = tuple_counts[table];
+    auto next_tuple_slot = tile_group_header->GetCurrentNextTupleSlot();
+    for (oid_t tuple_slot = 0; tuple_slot < next_tuple_slot; ++tuple_slot) {
+      // only the latest versions are reachable from the indexes.
+      // tuples that already have an indirection are indexed.
+      if (tile_group_header->GetTransactionId(tuple_slot) != INITIAL_TXN_ID ||
+          tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID ||
+          tile_group_header->GetIndirection(tuple_slot) != nullptr) {
+        continue;
+      }
+
+      ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_slot);
+      ItemPointer *index_entry_ptr = table->InsertInIndexesFromRecovery(
+          &tuple, ItemPointer(tile_group->GetTileGroupId(), tuple_slot));
+      tile_group_header->SetIndirection(tuple_slot, index_entry_ptr);
+
+      tuple_count++;
+    }
+  }
+
+  for (auto &entry : tuple_counts) {
+    entry.first->IncreaseTupleCount(entry.second);
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_logger.cpp
+//
+// Identification: src/logging/logical_logger.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "concurrency/epoch_manager_factory.h"
+#include "logging/logical_logger.h"
+#include "logging/logging_util.h"
+
+namespace peloton {
+namespace logging {
+
+void LogicalLogger::RegisterWorker(std::shared_ptr<WorkerContext> worker_ctx) {
+  worker_map_lock_.Lock();
+  worker_map_[worker_ctx->worker_id] = worker_ctx;
+  worker_map_lock_.Unlock();
+}
+
+void LogicalLogger::DeregisterWorker(WorkerContext *worker_ctx) {
+  worker_map_lock_.Lock();
+  worker_map_.erase(worker_ctx->worker_id);
+  worker_map_lock_.Unlock();
+}
+
+void LogicalLogger::Run() {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  while (true) {
+    bool is_running = is_running_;
+
+    eid_t current_global_eid = epoch_manager.GetCurrentEpochId();
+
+    if (is_running == true) {
+      // every epoch before the current global epoch is closed: a worker that
+      // starts logging a transaction after this point observes an epoch id
+      // that is no smaller than current_global_eid.
+      PersistEpochs(current_global_eid - 1);
+    } else {
+      // the system is shutting down. persist everything.
+      PersistEpochs(current_global_eid);
+      break;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+  }
+}
+
+void LogicalLogger::PersistEpochs(const eid_t upper_eid) {
+  if (upper_eid <= persist_epoch_id_) {
+    return;
+  }
+
+  std::map<eid_t, std::vector<std::unique_ptr<LogBuffer>>> epoch_buffers;
+
+  worker_map_lock_.Lock();
+  for (auto &worker_entry : worker_map_) {
+    auto &worker_ctx = worker_entry.second;
+
+    // the worker holds its latch while logging a transaction.
+    // so we never observe a partially logged transaction here.
+    worker_ctx->latch.Lock();
+
+    auto &current_buffer = worker_ctx->current_buffer;
+    if (current_buffer != nullptr && current_buffer->Empty() == false &&
+        current_buffer->GetEpochId() <= upper_eid) {
+      auto eid = current_buffer->GetEpochId();
+      worker_ctx->per_epoch_buffers[eid].push_back(std::move(current_buffer));
+    }
+
+    auto buffer_itr = worker_ctx->per_epoch_buffers.begin();
+    while (buffer_itr != worker_ctx->per_epoch_buffers.end() &&
+           buffer_itr->first <= upper_eid) {
+      auto &buffers = epoch_buffers[buffer_itr->first];
+      for (auto &log_buffer : buffer_itr->second) {
+        buffers.push_back(std::move(log_buffer));
+      }
+      buffer_itr = worker_ctx->per_epoch_buffers.erase(buffer_itr);
+    }
+
+    worker_ctx->latch.Unlock();
+  }
+  worker_map_lock_.Unlock();
+
+  // group commit: a single fsync per epoch file.
+  for (auto &epoch_entry : epoch_buffers) {
+    FileHandle file_handle;
+    std::string file_name = GetLogFileFullPath(epoch_entry.first);
+    bool res = LoggingUtil::OpenFile(file_name.c_str(), "ab", file_handle);
+    if (res == false) {
+      LOG_ERROR("Unable to open log file %s", file_name.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    for (auto &log_buffer : epoch_entry.second) {
+      size_t write_count = fwrite((const void *)(log_buffer->GetData()),
+                                  log_buffer->GetSize(), 1, file_handle.file);
+      if (write_count != 1) {
+        LOG_ERROR("Unable to write log file %s", file_name.c_str());
+        exit(EXIT_FAILURE);
+      }
+      ReturnLogBuffer(std::move(log_buffer));
+    }
+
+    LoggingUtil::FFlushFsync(file_handle);
+    LoggingUtil::CloseFile(file_handle);
+  }
+
+  persist_epoch_id_ = upper_eid;
+}
+
+void LogicalLogger::ReturnLogBuffer(std::unique_ptr<LogBuffer> log_buffer) {
+  log_buffer->Reset();
+
+  worker_map_lock_.Lock();
+  auto worker_itr = worker_map_.find(log_buffer->GetThreadId());
+  if (worker_itr != worker_map_.end()) {
+    auto &buffer_pool = worker_itr->second->buffer_pool;
+    // a large transaction may have been given more buffers than the pool
+    // holds. the extra ones are released.
+    if (buffer_pool.GetEmptySlotCount() < buffer_pool.GetMaxSlotCount()) {
+      buffer_pool.PutBuffer(std::move(log_buffer));
+    }
+  }
+  // otherwise, the worker has been deregistered, and the buffer is released.
+  worker_map_lock_.Unlock();
+}
+
+}  // namespace logging
+}  // namespace peloton
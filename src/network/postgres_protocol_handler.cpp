@@ -218,6 +218,18 @@ ProcessResult PostgresProtocolHandler::ExecQueryMessage(
       ExecQueryMessageGetResult(status);
       return ProcessResult::COMPLETE;
     };
+    case QueryType::QUERY_SET: {
+      auto status = traffic_cop_->ExecuteVariableSet(
+          static_cast<parser::VariableSetStatement &>(*sql_stmt));
+      if (status != ResultType::SUCCESS) {
+        SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                            traffic_cop_->GetErrorMessage()}});
+      } else {
+        CompleteCommand(query_type, 0);
+      }
+      SendReadyForQuery(NetworkTransactionStateType::IDLE);
+      return ProcessResult::COMPLETE;
+    }
     case QueryType::QUERY_EXPLAIN: {
       auto status = ExecQueryExplain(
           query, static_cast<parser::ExplainStatement &>(*sql_stmt));
@@ -347,6 +359,16 @@ void PostgresProtocolHandler::ExecParseMessage(InputPacket *pkt) {
   }
   bool skip = !HardcodedExecuteFilter(query_type);
   if (skip) {
+    // SET is not planned. it takes effect on the session as it is parsed.
+    if (query_type == QueryType::QUERY_SET &&
+        traffic_cop_->ExecuteVariableSet(
+            static_cast<parser::VariableSetStatement &>(
+                *sql_stmt_list->GetStatement(0))) != ResultType::SUCCESS) {
+      skipped_stmt_ = true;
+      SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                          traffic_cop_->GetErrorMessage()}});
+      return;
+    }
     skipped_stmt_ = true;
     skipped_query_string_ = query;
     skipped_query_type_ = query_type;
@@ -17,6 +17,7 @@
 #include "catalog/table_catalog.h"
 #include "codegen/type/type.h"
 #include "concurrency/transaction_context.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "expression/expression_util.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/properties.h"
@@ -94,8 +95,17 @@ void PlanGenerator::Visit(const PhysicalSeqScan *op) {
   bool parallel_exec_enabled = settings::SettingsManager::GetBool(
       settings::SettingId::parallel_execution);
 
-  bool parallel_scan = parallel_exec_enabled;
-  if (parallel_exec_enabled) {
+  // A scan for update records the tuples it owns in the read/write set of
+  // the transaction, which only its own thread may touch. So does every scan
+  // of a serializable or repeatable read transaction under optimistic
+  // concurrency control, which validates its reads. The plan is cached and
+  // may run in transactions of any isolation level, so scans are not
+  // parallel under optimistic concurrency control at all.
+  bool parallel_scan =
+      parallel_exec_enabled && !op->is_for_update &&
+      concurrency::TransactionManagerFactory::GetProtocol() !=
+          ProtocolType::OPTIMISTIC;
+  if (parallel_scan) {
     // Parallel scans are enabled. Check if the table meets the minimum number
     // of tuples to support parallel execution.
     auto num_tilegroups = data_table->GetTileGroupCount();
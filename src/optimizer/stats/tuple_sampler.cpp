@@ -46,6 +46,10 @@ size_t TupleSampler::AcquireSampleTuples(size_t target_sample_count) {
     rand_tilegroup_offset = rand() % tile_group_count;
     storage::TileGroup *tile_group =
         table->GetTileGroup(rand_tilegroup_offset).get();
+    // the tile group has been dropped after compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
     oid_t tuple_per_group = tile_group->GetActiveTupleCount();
     LOG_TRACE("tile_group: offset: %lu, addr: %p, tuple_per_group: %u",
               rand_tilegroup_offset, tile_group, tuple_per_group);
@@ -105,7 +109,11 @@ bool TupleSampler::GetTupleInTileGroup(storage::TileGroup *tile_group,
 
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
-      type::Value val = (tile_tuple.GetValue(tile_column_itr));
+      // the columns a delta version inherits are read from an older version
+      type::Value val =
+          tile->IsInherited(tuple_offset, tile_column_itr)
+              ? tile->GetValue(tuple_offset, tile_column_itr)
+              : tile_tuple.GetValue(tile_column_itr);
       tuple->SetValue(tuple_column_itr, val, pool_.get());
       tuple_column_itr++;
     }
@@ -1573,8 +1573,25 @@ parser::AnalyzeStatement *PostgresParser::VacuumTransform(VacuumStmt *root) {
 }
 
 parser::VariableSetStatement *PostgresParser::VariableSetTransform(
-    UNUSED_ATTRIBUTE VariableSetStmt *root) {
+    VariableSetStmt *root) {
   VariableSetStatement *res = new VariableSetStatement();
+  if (root->name != nullptr) {
+    res->name = StringUtil::Lower(root->name);
+  }
+
+  // only single-valued variables are kept.
+  if (root->kind == VAR_SET_VALUE && root->args != nullptr &&
+      root->args->length == 1) {
+    auto arg = reinterpret_cast<Node *>(root->args->head->data.ptr_value);
+    if (arg->type == T_A_Const) {
+      auto &val = reinterpret_cast<A_Const *>(arg)->val;
+      if (val.type == T_Integer) {
+        res->value = std::to_string(val.val.ival);
+      } else if (val.type == T_String || val.type == T_Float) {
+        res->value = val.val.str;
+      }
+    }
+  }
   return res;
 }
 
@@ -1800,8 +1817,23 @@ parser::SQLStatement *PostgresParser::DeleteTransform(DeleteStmt *root) {
 // Transform Postgres TransacStmt into Peloton TransactionStmt
 parser::TransactionStatement *PostgresParser::TransactionTransform(
     TransactionStmt *root) {
-  if (root->kind == TRANS_STMT_BEGIN) {
-    return new parser::TransactionStatement(TransactionStatement::kBegin);
+  if (root->kind == TRANS_STMT_BEGIN || root->kind == TRANS_STMT_START) {
+    auto result = new parser::TransactionStatement(TransactionStatement::kBegin);
+    if (root->options == nullptr) {
+      return result;
+    }
+
+    // READ ONLY and READ WRITE, the isolation levels are not supported
+    for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
+      auto def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
+      if (strcmp(def_elem->defname, "transaction_read_only") != 0) {
+        continue;
+      }
+      auto read_only = reinterpret_cast<A_Const *>(def_elem->arg)->val.val.ival;
+      result->access_mode = read_only ? TransactionStatement::kReadOnly
+                                      : TransactionStatement::kReadWrite;
+    }
+    return result;
   } else if (root->kind == TRANS_STMT_COMMIT) {
     return new parser::TransactionStatement(TransactionStatement::kCommit);
   } else if (root->kind == TRANS_STMT_ROLLBACK) {
@@ -35,6 +35,12 @@ const std::string TransactionStatement::GetInfo(int num_indent) const {
   }
   os << std::endl;
 
+  if (access_mode != kDefaultAccess) {
+    os << StringUtil::Indent(num_indent + 1) << "Access Mode: "
+       << (access_mode == kReadOnly ? "Read Only" : "Read Write")
+       << std::endl;
+  }
+
   return os.str();
 }
 
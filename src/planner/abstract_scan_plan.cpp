@@ -40,8 +40,12 @@ void AbstractScan::PerformBinding(BindingContext &binding_context) {
     for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
       const auto column = schema->GetColumn(col_id);
       bool nullable = schema->AllowNull(col_id);
-      auto type = codegen::type::Type{column.GetType(), nullable};
-      attributes_.push_back(AttributeInfo{type, col_id, column.GetName()});
+      AttributeInfo attribute;
+      attribute.type = codegen::type::Type{column.GetType(), nullable};
+      attribute.attribute_id = col_id;
+      attribute.name = column.GetName();
+      attribute.dictionary = column.GetDictionary();
+      attributes_.push_back(attribute);
     }
 
     // Perform attribute binding only for actual output columns
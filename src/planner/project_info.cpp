@@ -84,12 +84,7 @@ bool ProjectInfo::Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
                            const AbstractTuple *tuple2,
                            executor::ExecutorContext *econtext) const {
   // (A) Execute target list
-  for (auto target : target_list_) {
-    auto col_id = target.first;
-    auto expr = target.second.expr;
-    auto value = expr->Evaluate(tuple1, tuple2, econtext);
-    dest->SetValue(col_id, value);
-  }
+  EvaluateTargets(dest, tuple1, tuple2, econtext);
 
   // (B) Execute direct map
   for (auto dm : direct_map_list_) {
@@ -110,6 +105,29 @@ bool ProjectInfo::Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
   return true;
 }
 
+bool ProjectInfo::EvaluateTargets(AbstractTuple *dest,
+                                  const AbstractTuple *tuple1,
+                                  const AbstractTuple *tuple2,
+                                  executor::ExecutorContext *econtext) const {
+  for (auto target : target_list_) {
+    auto col_id = target.first;
+    auto expr = target.second.expr;
+    auto value = expr->Evaluate(tuple1, tuple2, econtext);
+    dest->SetValue(col_id, value);
+  }
+
+  return true;
+}
+
+bool ProjectInfo::IsIdentityDirectMap() const {
+  for (auto &dm : direct_map_list_) {
+    if (dm.second.first != 0 || dm.first != dm.second.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ProjectInfo::PerformRebinding(
     BindingContext &output_context,
     const std::vector<const BindingContext *> &input_contexts) const {
@@ -14,21 +14,25 @@
 #include <cpuid.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <linux/mempolicy.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/internal_types.h"
+#include "settings/settings_manager.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -304,6 +308,10 @@ static void (*Func_drain)(void) = drain_no_pcommit;
 #define DATA_FILE_LEN 1024 * 1024 * UINT64_C(512)  // 512 MB
 #define DATA_FILE_NAME "peloton.pmem"
 
+// Only allocations of at least a page get a mapping of their own
+#define MAPPED_ALLOCATION_MIN_SIZE 4096
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
 // global singleton
 BackendManager &BackendManager::GetInstance(void) {
   static BackendManager backend_manager;
@@ -421,7 +429,13 @@ BackendManager::BackendManager()
 }
 
 BackendManager::~BackendManager() {
-  LOG_TRACE("Allocation count : %ld \n", allocation_count);
+  LOG_TRACE("Allocation count : %ld \n", allocation_count.load());
+
+  for (auto &eviction_file : eviction_files) {
+    if (eviction_file.fd >= 0) {
+      close(eviction_file.fd);
+    }
+  }
 
   // // Check if we need a PMEM pool
   // if (peloton_logging_mode != LoggingType::NVM_WBL) return;
@@ -449,6 +463,20 @@ void *BackendManager::Allocate(BackendType type, size_t size) {
   switch (type) {
     case BackendType::MM:
     case BackendType::NVM: {
+      if (type == BackendType::MM && size >= MAPPED_ALLOCATION_MIN_SIZE) {
+        // Smaller tiles would waste most of a huge page
+        bool huge_pages = size >= HUGE_PAGE_SIZE &&
+                          settings::SettingsManager::GetBool(
+                              settings::SettingId::huge_page_tile_data);
+        bool numa_aware = settings::SettingsManager::GetBool(
+            settings::SettingId::numa_aware_allocation);
+        if (huge_pages || numa_aware) {
+          void *address = AllocateMapped(size, huge_pages, numa_aware);
+          if (address != nullptr) {
+            return address;
+          }
+        }
+      }
       return ::operator new(size);
     } break;
 
@@ -496,6 +524,9 @@ void BackendManager::Release(BackendType type, void *address) {
   switch (type) {
     case BackendType::MM:
     case BackendType::NVM: {
+      if (type == BackendType::MM && ReleaseMapped(address)) {
+        break;
+      }
       ::operator delete(address);
     } break;
 
@@ -512,6 +543,183 @@ void BackendManager::Release(BackendType type, void *address) {
   }
 }
 
+void *BackendManager::AllocateMapped(size_t size, bool huge_pages,
+                                     bool numa_aware) {
+  size_t mapped_size = size;
+  void *address = MAP_FAILED;
+
+  // Explicit huge pages must have been reserved by the administrator. Fall
+  // back to transparent huge pages if there are not enough of them left.
+  if (huge_pages) {
+    mapped_size = (size + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+    address = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+
+  if (address == MAP_FAILED) {
+    mapped_size = size;
+    address = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) {
+      LOG_DEBUG("Could not map %lu bytes : %s", size, strerror(errno));
+      return nullptr;
+    }
+    if (huge_pages) {
+      madvise(address, mapped_size, MADV_HUGEPAGE);
+    }
+  }
+
+  // The pages are placed when they are first touched, prefer the node of the
+  // thread that is allocating them
+  if (numa_aware) {
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 &&
+        node < sizeof(unsigned long) * 8) {
+      unsigned long node_mask = 1UL << node;
+      if (syscall(SYS_mbind, address, mapped_size, MPOL_PREFERRED, &node_mask,
+                  sizeof(node_mask) * 8, 0) != 0) {
+        LOG_TRACE("Could not bind memory to node %u : %s", node,
+                  strerror(errno));
+      }
+    }
+  }
+
+  mapped_allocation_lock.Lock();
+  mapped_allocations[address] = mapped_size;
+  mapped_allocation_lock.Unlock();
+
+  return address;
+}
+
+bool BackendManager::ReleaseMapped(void *address) {
+  mapped_allocation_lock.Lock();
+  auto mapped_itr = mapped_allocations.find(address);
+  if (mapped_itr == mapped_allocations.end()) {
+    mapped_allocation_lock.Unlock();
+    return false;
+  }
+  size_t mapped_size = mapped_itr->second;
+  mapped_allocations.erase(mapped_itr);
+  mapped_allocation_lock.Unlock();
+
+  munmap(address, mapped_size);
+  return true;
+}
+
+size_t BackendManager::GetMappedAllocationCount() {
+  mapped_allocation_lock.Lock();
+  size_t mapped_allocation_count = mapped_allocations.size();
+  mapped_allocation_lock.Unlock();
+  return mapped_allocation_count;
+}
+
+BackendManager::EvictionFile &BackendManager::GetEvictionFile(
+    BackendType type) {
+  PELOTON_ASSERT(type == BackendType::SSD || type == BackendType::HDD);
+  auto &eviction_file = eviction_files[type == BackendType::SSD ? 0 : 1];
+  if (eviction_file.fd >= 0) {
+    return eviction_file;
+  }
+
+  // Fallback to tmp directory if the backend has no file system
+  struct stat dir_stat;
+  std::string dir_name = (type == BackendType::SSD) ? SSD_DIR : HDD_DIR;
+  if (stat(dir_name.c_str(), &dir_stat) != 0 || !S_ISDIR(dir_stat.st_mode)) {
+    dir_name = TMP_DIR;
+  }
+
+  std::string file_name = dir_name + "peloton_evicted_XXXXXX";
+  std::vector<char> file_name_buffer(file_name.begin(), file_name.end());
+  file_name_buffer.push_back('\0');
+  int fd = mkstemp(file_name_buffer.data());
+  if (fd < 0) {
+    throw Exception("could not create eviction file in " + dir_name + " : " +
+                    strerror(errno));
+  }
+  unlink(file_name_buffer.data());
+
+  LOG_DEBUG("Evicting %s data to %s", BackendTypeToString(type).c_str(),
+            dir_name.c_str());
+  eviction_file.fd = fd;
+  return eviction_file;
+}
+
+size_t BackendManager::WriteEvicted(BackendType type, const char *data,
+                                    size_t size) {
+  int fd;
+  size_t offset;
+  {
+    std::lock_guard<std::mutex> lock(eviction_file_lock);
+    auto &eviction_file = GetEvictionFile(type);
+    fd = eviction_file.fd;
+
+    // Reuse the smallest free block that is large enough
+    auto block_itr = eviction_file.free_blocks.lower_bound(size);
+    if (block_itr != eviction_file.free_blocks.end()) {
+      offset = block_itr->second;
+      size_t remaining_size = block_itr->first - size;
+      eviction_file.free_blocks.erase(block_itr);
+      if (remaining_size > 0) {
+        eviction_file.free_blocks.emplace(remaining_size, offset + size);
+      }
+    } else {
+      offset = eviction_file.end_offset;
+      eviction_file.end_offset += size;
+    }
+  }
+
+  size_t written_size = 0;
+  while (written_size < size) {
+    ssize_t status = pwrite(fd, data + written_size, size - written_size,
+                            offset + written_size);
+    if (status < 0 && errno == EINTR) {
+      continue;
+    }
+    if (status <= 0) {
+      ReleaseEvicted(type, offset, size);
+      throw Exception("could not write to eviction file : " +
+                      std::string(strerror(errno)));
+    }
+    written_size += status;
+  }
+
+  return offset;
+}
+
+void BackendManager::ReadEvicted(BackendType type, size_t offset, char *data,
+                                 size_t size) {
+  int fd;
+  {
+    std::lock_guard<std::mutex> lock(eviction_file_lock);
+    fd = GetEvictionFile(type).fd;
+  }
+
+  size_t read_size = 0;
+  while (read_size < size) {
+    ssize_t status =
+        pread(fd, data + read_size, size - read_size, offset + read_size);
+    if (status < 0 && errno == EINTR) {
+      continue;
+    }
+    if (status <= 0) {
+      throw Exception("could not read from eviction file : " +
+                      std::string(strerror(errno)));
+    }
+    read_size += status;
+  }
+}
+
+void BackendManager::ReleaseEvicted(BackendType type, size_t offset,
+                                    size_t size) {
+  std::lock_guard<std::mutex> lock(eviction_file_lock);
+  auto &eviction_file = GetEvictionFile(type);
+  if (offset + size == eviction_file.end_offset) {
+    eviction_file.end_offset = offset;
+  } else {
+    eviction_file.free_blocks.emplace(size, offset);
+  }
+}
+
 void BackendManager::Sync(BackendType type, void *address, size_t length) {
   switch (type) {
     case BackendType::MM: {
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.cpp
+//
+// Identification: src/storage/compressed_column.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/compressed_column.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "type/type.h"
+
+namespace peloton {
+namespace storage {
+
+const uint32_t CompressedColumn::max_bit_width_;
+
+CompressedColumn::CompressedColumn(type::TypeId type_id, uint32_t tuple_count)
+    : type_id_(type_id),
+      value_size_(type::Type::GetTypeSize(type_id)),
+      tuple_count_(tuple_count),
+      encoding_(ColumnEncoding::NONE) {}
+
+std::unique_ptr<CompressedColumn> CompressedColumn::Compress(
+    type::TypeId type_id, const char *column, uint32_t stride,
+    uint32_t tuple_count) {
+  if (IsCompressedType(type_id) == false || tuple_count == 0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CompressedColumn> compressed(
+      new CompressedColumn(type_id, tuple_count));
+  auto value_size = compressed->value_size_;
+
+  // Find the range of the values, and the runs of equal values
+  std::vector<int64_t> values(tuple_count);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    values[tuple_itr] =
+        ReadRawValue(column + tuple_itr * stride, value_size);
+  }
+  auto range = std::minmax_element(values.begin(), values.end());
+  int64_t min = *range.first;
+  uint64_t max_offset = static_cast<uint64_t>(*range.second) -
+                        static_cast<uint64_t>(min);
+
+  uint32_t bit_width = 0;
+  while (bit_width < 64 && (max_offset >> bit_width) != 0) {
+    bit_width++;
+  }
+
+  size_t run_count = 1;
+  for (oid_t tuple_itr = 1; tuple_itr < tuple_count; tuple_itr++) {
+    if (values[tuple_itr] != values[tuple_itr - 1]) {
+      run_count++;
+    }
+  }
+
+  // Pick the smaller encoding, if it is smaller than the tile column
+  size_t uncompressed_size = static_cast<size_t>(value_size) * tuple_count;
+  size_t packed_size =
+      (static_cast<size_t>(tuple_count) * bit_width + 7) / 8 + sizeof(uint64_t);
+  size_t run_length_size = run_count * (sizeof(oid_t) + sizeof(int64_t));
+  bool use_frame_of_reference =
+      bit_width <= max_bit_width_ && packed_size <= run_length_size;
+
+  if (use_frame_of_reference) {
+    if (packed_size >= uncompressed_size) {
+      return nullptr;
+    }
+
+    compressed->encoding_ = ColumnEncoding::FRAME_OF_REFERENCE;
+    compressed->reference_ = min;
+    compressed->bit_width_ = bit_width;
+    compressed->packed_size_ = packed_size;
+    compressed->packed_data_.reset(new char[packed_size]);
+    char *packed_data = compressed->packed_data_.get();
+    PELOTON_MEMSET(packed_data, 0, packed_size);
+
+    // the bits of a value start in the byte at bit_offset / 8, and span at
+    // most eight bytes, since the bit width is at most 56.
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      uint64_t bit_offset = static_cast<uint64_t>(tuple_itr) * bit_width;
+      uint64_t offset = static_cast<uint64_t>(values[tuple_itr]) -
+                        static_cast<uint64_t>(min);
+      uint64_t word;
+      PELOTON_MEMCPY(&word, packed_data + bit_offset / 8, sizeof(word));
+      word |= offset << (bit_offset % 8);
+      PELOTON_MEMCPY(packed_data + bit_offset / 8, &word, sizeof(word));
+    }
+  } else {
+    if (run_length_size >= uncompressed_size) {
+      return nullptr;
+    }
+
+    compressed->encoding_ = ColumnEncoding::RUN_LENGTH;
+    compressed->run_ends_.reserve(run_count);
+    compressed->run_values_.reserve(run_count);
+    for (oid_t tuple_itr = 1; tuple_itr <= tuple_count; tuple_itr++) {
+      if (tuple_itr == tuple_count ||
+          values[tuple_itr] != values[tuple_itr - 1]) {
+        compressed->run_ends_.push_back(tuple_itr);
+        compressed->run_values_.push_back(values[tuple_itr - 1]);
+      }
+    }
+  }
+
+  return compressed;
+}
+
+bool CompressedColumn::IsCompressedType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::DATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+type::Value CompressedColumn::GetValue(oid_t tuple_id) const {
+  char value[sizeof(int64_t)];
+  CopyValue(tuple_id, value);
+  return type::Value::DeserializeFrom(value, type_id_, true);
+}
+
+void CompressedColumn::CopyValue(oid_t tuple_id, char *location) const {
+  WriteRawValue(location, value_size_, GetRawValue(tuple_id));
+}
+
+void CompressedColumn::Decompress(char *column, uint32_t stride) const {
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+    CopyValue(tuple_itr, column + tuple_itr * stride);
+  }
+}
+
+size_t CompressedColumn::GetSize() const {
+  return packed_size_ + run_ends_.size() * sizeof(oid_t) +
+         run_values_.size() * sizeof(int64_t);
+}
+
+int64_t CompressedColumn::GetRunValue(oid_t tuple_id) const {
+  auto run = std::upper_bound(run_ends_.begin(), run_ends_.end(), tuple_id);
+  PELOTON_ASSERT(run != run_ends_.end());
+  return run_values_[run - run_ends_.begin()];
+}
+
+int64_t CompressedColumn::ReadRawValue(const char *location,
+                                       uint32_t value_size) {
+  switch (value_size) {
+    case sizeof(int8_t):
+      return *reinterpret_cast<const int8_t *>(location);
+    case sizeof(int16_t):
+      return *reinterpret_cast<const int16_t *>(location);
+    case sizeof(int32_t):
+      return *reinterpret_cast<const int32_t *>(location);
+    default:
+      PELOTON_ASSERT(value_size == sizeof(int64_t));
+      return *reinterpret_cast<const int64_t *>(location);
+  }
+}
+
+void CompressedColumn::WriteRawValue(char *location, uint32_t value_size,
+                                     int64_t value) {
+  switch (value_size) {
+    case sizeof(int8_t):
+      *reinterpret_cast<int8_t *>(location) = static_cast<int8_t>(value);
+      break;
+    case sizeof(int16_t):
+      *reinterpret_cast<int16_t *>(location) = static_cast<int16_t>(value);
+      break;
+    case sizeof(int32_t):
+      *reinterpret_cast<int32_t *>(location) = static_cast<int32_t>(value);
+      break;
+    default:
+      PELOTON_ASSERT(value_size == sizeof(int64_t));
+      *reinterpret_cast<int64_t *>(location) = value;
+      break;
+  }
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <functional>
 #include <mutex>
 #include <utility>
 
@@ -27,6 +29,7 @@
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
+#include "settings/settings_manager.h"
 #include "storage/abstract_table.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
@@ -36,6 +39,7 @@
 #include "storage/tile_group_factory.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "threadpool/mono_queue_pool.h"
 #include "tuning/clusterer.h"
 #include "tuning/sample.h"
 
@@ -68,6 +72,9 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
       tuples_per_tilegroup_(tuples_per_tilegroup),
       current_layout_oid_(ATOMIC_VAR_INIT(COLUMN_STORE_LAYOUT_OID)),
       adapt_table_(adapt_table),
+      delta_versions_(is_catalog == false &&
+                      settings::SettingsManager::GetBool(
+                          settings::SettingId::delta_versions)),
       trigger_list_(new trigger::TriggerList()) {
   if (is_catalog == true) {
     active_tilegroup_count_ = 1;
@@ -77,7 +84,14 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
     active_indirection_array_count_ = default_active_indirection_array_count_;
   }
 
-  active_tile_groups_.resize(active_tilegroup_count_);
+  active_tile_groups_.reset(
+      new std::atomic<storage::TileGroup *>[active_tilegroup_count_]);
+  preallocated_tile_groups_.reset(
+      new std::atomic<storage::TileGroup *>[active_tilegroup_count_]);
+  for (size_t i = 0; i < active_tilegroup_count_; ++i) {
+    active_tile_groups_[i] = nullptr;
+    preallocated_tile_groups_[i] = nullptr;
+  }
 
   active_indirection_arrays_.resize(active_indirection_array_count_);
   // Create tile groups.
@@ -109,6 +123,11 @@ DataTable::~DataTable() {
     }
   }
 
+  // free the tile groups that have never been installed
+  for (size_t i = 0; i < active_tilegroup_count_; ++i) {
+    delete preallocated_tile_groups_[i].exchange(nullptr);
+  }
+
   // drop all indirection arrays
   for (auto indirection_array : active_indirection_arrays_) {
     auto oid = indirection_array->GetOid();
@@ -211,26 +230,30 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   // check if there are recycled tuple slots
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
   auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
-  if (free_item_pointer.IsNull() == false) {
-    // when inserting a tuple
-    if (tuple != nullptr) {
-      auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
-          free_item_pointer.block);
-      tile_group->CopyTuple(tuple, free_item_pointer.offset);
+  while (free_item_pointer.IsNull() == false) {
+    auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
+        free_item_pointer.block);
+    // the slots of a tile group that is being compacted are not reused
+    if (tile_group != nullptr &&
+        tile_group->GetHeader()->GetImmutability() == false) {
+      // when inserting a tuple
+      if (tuple != nullptr) {
+        tile_group->CopyTuple(tuple, free_item_pointer.offset);
+      }
+      return free_item_pointer;
     }
-    return free_item_pointer;
+    free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  size_t active_tile_group_id = GetActiveTileGroupId();
+  storage::TileGroup *tile_group = nullptr;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
 
   // get valid tuple.
   while (true) {
-    // get the last tile group.
-    tile_group = active_tile_groups_[active_tile_group_id];
+    tile_group = active_tile_groups_[active_tile_group_id].load();
 
     tuple_slot = tile_group->InsertTuple(tuple);
 
@@ -239,17 +262,27 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
       tile_group_id = tile_group->GetTileGroupId();
       break;
     }
+
+    // the tile group is full, and its successor is being installed by the
+    // thread that got its last tuple slot. try the next active tile group
+    // rather than waiting for it.
+    active_tile_group_id = (active_tile_group_id + 1) % active_tilegroup_count_;
   }
 
-  // if this is the last tuple slot we can get
-  // then create a new tile group
-  if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
-    AddDefaultTileGroup(active_tile_group_id);
+  // once half of the tile group is used, the thread that gets the middle
+  // tuple slot allocates its successor. the thread that gets the last
+  // tuple slot installs it.
+  auto allocated_tuple_count = tile_group->GetAllocatedTupleCount();
+  if (tuple_slot == allocated_tuple_count / 2) {
+    PreallocateTileGroup(active_tile_group_id);
+  }
+  if (tuple_slot == allocated_tuple_count - 1) {
+    InstallTileGroup(active_tile_group_id, tile_group);
   }
 
   LOG_TRACE("tile group count: %lu, tile group id: %u, address: %p",
             tile_group_count_.load(), tile_group->GetTileGroupId(),
-            tile_group.get());
+            tile_group);
 
   // Set tuple location
   ItemPointer location(tile_group_id, tuple_slot);
@@ -388,6 +421,150 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   return location;
 }
 
+//===--------------------------------------------------------------------===//
+// BULK LOAD
+//===--------------------------------------------------------------------===//
+
+TileGroup *DataTable::AddBulkLoadTileGroup() {
+  std::shared_ptr<TileGroup> tile_group(
+      GetTileGroupWithLayout(default_layout_));
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+
+  tile_groups_.Append(tile_group_id);
+
+  // add tile group metadata in locator
+  storage::StorageManager::GetInstance()->AddTileGroup(tile_group_id,
+                                                       tile_group);
+
+  // we must guarantee that the compiler always add tile group before adding
+  // tile_group_count_.
+  COMPILER_MEMORY_FENCE;
+
+  tile_group_count_++;
+
+  LOG_TRACE("Added a bulk load tile group : %u ", tile_group_id);
+  return tile_group.get();
+}
+
+namespace {
+
+// Orders the keys of an index, NULLs first
+bool IndexKeyLess(const std::unique_ptr<storage::Tuple> &lhs,
+                  const std::unique_ptr<storage::Tuple> &rhs) {
+  oid_t column_count = lhs->GetSchema()->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    type::Value lhs_value = lhs->GetValue(column_itr);
+    type::Value rhs_value = rhs->GetValue(column_itr);
+    if (lhs_value.IsNull() || rhs_value.IsNull()) {
+      if (lhs_value.IsNull() != rhs_value.IsNull()) {
+        return lhs_value.IsNull();
+      }
+      continue;
+    }
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      return true;
+    }
+    if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool DataTable::BulkInsertTuples(TileGroup *tile_group,
+                                 const oid_t &tuple_start,
+                                 const oid_t &tuple_end,
+                                 concurrency::TransactionContext *transaction) {
+  if (tuple_start >= tuple_end) {
+    return true;
+  }
+
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  oid_t tuple_count = tuple_end - tuple_start;
+
+  // Check the constraints of every tuple before any of them is inserted
+  for (oid_t tuple_id = tuple_start; tuple_id < tuple_end; tuple_id++) {
+    ContainerTuple<TileGroup> tuple(tile_group, tuple_id);
+    if (CheckConstraints(&tuple) == false) {
+      LOG_TRACE("BulkInsertTuples(): Constraint violated");
+      return false;
+    }
+    if (CheckForeignKeyConstraints(&tuple, transaction) == false) {
+      LOG_TRACE("ForeignKey constraint violated");
+      return false;
+    }
+  }
+
+  // Set up the headers of all the tuples in one pass. The tuples belong to
+  // the transaction before they are in any index, so that a key that occurs
+  // twice in the load is caught by the uniqueness checks.
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  int index_count = GetIndexCount();
+  std::vector<ItemPointer *> index_entry_ptrs(tuple_count, nullptr);
+  for (oid_t tuple_id = tuple_start; tuple_id < tuple_end; tuple_id++) {
+    ItemPointer location(tile_group_id, tuple_id);
+    ItemPointer *index_entry_ptr = nullptr;
+    if (index_count != 0) {
+      index_entry_ptr = AllocateIndirection(location);
+      index_entry_ptrs[tuple_id - tuple_start] = index_entry_ptr;
+    }
+    transaction_manager.PerformInsert(transaction, location, index_entry_ptr);
+  }
+  IncreaseTupleCount(tuple_count);
+
+  // Insert the keys of each index in key order
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, transaction, std::placeholders::_1);
+
+  std::vector<std::unique_ptr<storage::Tuple>> keys(tuple_count);
+  std::vector<oid_t> key_order(tuple_count);
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) continue;
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    for (oid_t key_itr = 0; key_itr < tuple_count; key_itr++) {
+      ContainerTuple<TileGroup> tuple(tile_group, tuple_start + key_itr);
+      keys[key_itr].reset(new storage::Tuple(index_schema, true));
+      keys[key_itr]->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+      key_order[key_itr] = key_itr;
+    }
+    std::sort(key_order.begin(), key_order.end(),
+              [&keys](const oid_t &lhs, const oid_t &rhs) {
+                return IndexKeyLess(keys[lhs], keys[rhs]);
+              });
+
+    for (auto key_itr : key_order) {
+      bool res = true;
+      switch (index->GetIndexType()) {
+        case IndexConstraintType::PRIMARY_KEY:
+        case IndexConstraintType::UNIQUE: {
+          res = index->CondInsertEntry(keys[key_itr].get(),
+                                       index_entry_ptrs[key_itr], fn);
+        } break;
+
+        case IndexConstraintType::DEFAULT:
+        default:
+          index->InsertEntry(keys[key_itr].get(), index_entry_ptrs[key_itr]);
+          break;
+      }
+
+      // The inserted tuples are rolled back when the transaction aborts
+      if (res == false) {
+        LOG_TRACE("Index constraint violated on %s", index->GetName().c_str());
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 /**
  * @brief Insert a tuple into all indexes. If index is primary/unique,
  * check visibility of existing
@@ -403,29 +580,7 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
                                 ItemPointer **index_entry_ptr) {
   int index_count = GetIndexCount();
 
-  size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
-
-  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-
-  while (true) {
-    auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
-    indirection_offset = active_indirection_array->AllocateIndirection();
-
-    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
-          active_indirection_array->GetIndirectionByOffset(indirection_offset);
-      break;
-    }
-  }
-
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
+  *index_entry_ptr = AllocateIndirection(location);
 
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -477,6 +632,54 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
   return true;
 }
 
+ItemPointer *DataTable::InsertInIndexesFromRecovery(const AbstractTuple *tuple,
+                                                    ItemPointer location) {
+  ItemPointer *index_entry_ptr = AllocateIndirection(location);
+
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) continue;
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
+
+    index->InsertEntry(key.get(), index_entry_ptr);
+  }
+
+  return index_entry_ptr;
+}
+
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
+  size_t active_indirection_array_id =
+      number_of_tuples_ % active_indirection_array_count_;
+
+  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *index_entry_ptr = nullptr;
+
+  while (true) {
+    auto active_indirection_array =
+        active_indirection_arrays_[active_indirection_array_id];
+    indirection_offset = active_indirection_array->AllocateIndirection();
+
+    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+      index_entry_ptr =
+          active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      break;
+    }
+  }
+
+  index_entry_ptr->block = location.block;
+  index_entry_ptr->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    AddDefaultIndirectionArray(active_indirection_array_id);
+  }
+
+  return index_entry_ptr;
+}
+
 bool DataTable::InsertInSecondaryIndexes(
     const AbstractTuple *tuple, const TargetList *targets_ptr,
     concurrency::TransactionContext *transaction,
@@ -869,19 +1072,49 @@ oid_t DataTable::AddDefaultIndirectionArray(
 }
 
 oid_t DataTable::AddDefaultTileGroup() {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
-  return AddDefaultTileGroup(active_tile_group_id);
+  return AddDefaultTileGroup(GetActiveTileGroupId());
 }
 
 oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
-  oid_t tile_group_id = INVALID_OID;
+  return InstallTileGroup(active_tile_group_id,
+                          active_tile_groups_[active_tile_group_id].load());
+}
+
+size_t DataTable::GetActiveTileGroupId() const {
+  // every thread starts from a different active tile group, so that
+  // concurrent inserters do not contend on the same tuple slots.
+  static std::atomic<size_t> inserter_count(0);
+  static thread_local size_t inserter_id = inserter_count++;
+  return inserter_id % active_tilegroup_count_;
+}
+
+void DataTable::PreallocateTileGroup(const size_t &active_tile_group_id) {
+  TileGroup *tile_group = GetTileGroupWithLayout(default_layout_);
+  PELOTON_ASSERT(tile_group != nullptr);
 
-  // Create a tile group with that partitioning
+  TileGroup *expected = nullptr;
+  if (preallocated_tile_groups_[active_tile_group_id].compare_exchange_strong(
+          expected, tile_group) == false) {
+    delete tile_group;
+  }
+}
+
+oid_t DataTable::InstallTileGroup(const size_t &active_tile_group_id,
+                                  TileGroup *full_tile_group) {
+  // use the tile group allocated ahead of time, unless the layout of the
+  // table has been changed since then.
   std::shared_ptr<TileGroup> tile_group(
-      GetTileGroupWithLayout(default_layout_));
+      preallocated_tile_groups_[active_tile_group_id].exchange(nullptr));
+  if (tile_group != nullptr &&
+      &tile_group->GetLayout() != default_layout_.get()) {
+    tile_group.reset();
+  }
+  if (tile_group == nullptr) {
+    tile_group.reset(GetTileGroupWithLayout(default_layout_));
+  }
   PELOTON_ASSERT(tile_group.get());
 
-  tile_group_id = tile_group->GetTileGroupId();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
 
   LOG_TRACE("Added a tile group ");
   tile_groups_.Append(tile_group_id);
@@ -890,9 +1123,13 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   storage::StorageManager::GetInstance()->AddTileGroup(tile_group_id,
                                                        tile_group);
 
-  COMPILER_MEMORY_FENCE;
-
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  // the tile group must be visible in the locator before inserters can
+  // return its tuple slots.
+  TileGroup *expected = full_tile_group;
+  UNUSED_ATTRIBUTE bool res =
+      active_tile_groups_[active_tile_group_id].compare_exchange_strong(
+          expected, tile_group.get());
+  PELOTON_ASSERT(res == true);
 
   // we must guarantee that the compiler always add tile group before adding
   // tile_group_count_.
@@ -949,9 +1186,9 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetActiveTileGroupId();
 
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  active_tile_groups_[active_tile_group_id] = tile_group.get();
 
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
@@ -1154,9 +1391,11 @@ std::vector<catalog::Schema> TransformTileGroupSchema(
   return new_schema;
 }
 
-// Set the transformed tile group column-at-a-time
+// Set the transformed tile group column-at-a-time. Only the header and zone
+// map are copied if copy_tiles is false.
 void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
-                             storage::TileGroup *new_tile_group) {
+                             storage::TileGroup *new_tile_group,
+                             bool copy_tiles) {
   auto new_layout = new_tile_group->GetLayout();
   auto orig_layout = orig_tile_group->GetLayout();
 
@@ -1170,7 +1409,7 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
   oid_t orig_tile_offset, orig_tile_column_offset;
   oid_t new_tile_offset, new_tile_column_offset;
 
-  auto column_count = new_column_count;
+  oid_t column_count = copy_tiles ? new_column_count : 0;
   auto tuple_count = orig_tile_group->GetAllocatedTupleCount();
   // Go over each column copying onto the new tile group
   for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
@@ -1181,9 +1420,20 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     new_layout.LocateTileAndColumn(column_itr, new_tile_offset,
                                    new_tile_column_offset);
 
-    auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
     auto new_tile = new_tile_group->GetTile(new_tile_offset);
 
+    // A compressed column is decoded without thawing its tile
+    auto compressed_column = orig_tile_group->GetCompressedColumn(column_itr);
+    if (compressed_column != nullptr) {
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        type::Value val = compressed_column->GetValue(tuple_itr);
+        new_tile->SetValue(val, tuple_itr, new_tile_column_offset);
+      }
+      continue;
+    }
+
+    auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
+
     // Copy the column over to the new tile group
     for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
       type::Value val =
@@ -1192,10 +1442,83 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     }
   }
 
-  // Finally, copy over the tile header
+  // The values are the same, and so are their ranges
+  new_tile_group->GetZoneMap()->CopyFrom(*orig_tile_group->GetZoneMap());
+
+  // Finally, copy over the tile header. The copy must point back to the
+  // new tile group rather than to the original one.
   auto header = orig_tile_group->GetHeader();
   auto new_header = new_tile_group->GetHeader();
   *new_header = *header;
+  new_header->SetTileGroup(new_tile_group);
+}
+
+// Versions of a tile group that is being migrated are owned by this
+// transaction id, so that concurrent writers and serializable readers back
+// off and retry on the new tile group.
+static const txn_id_t migration_txn_id = MAX_TXN_ID;
+
+// Give up the ownership of a version taken by the migration. The reclaimed
+// slots are the only ones that have not been committed.
+static void ReleaseColdTuple(const TileGroupHeader *header,
+                             const oid_t tuple_slot_id) {
+  if (header->GetBeginCommitId(tuple_slot_id) == MAX_CID) {
+    header->SetTransactionId(tuple_slot_id, INVALID_TXN_ID);
+  } else {
+    header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+  }
+}
+
+// Take ownership of every version of a cold tile group. A tile group is cold
+// if all of its tuple slots have been handed out, and every version is
+// committed, not owned by any transaction and holds all of its columns. Dead
+// versions and the slots reclaimed by the GC are cold as well. The reclaimed
+// slots of a tile group are not recycled anymore once it has been found to
+// have some, and they are only taken from the next attempt on, when an
+// inserter that got one of them before has set its transaction id. Returns
+// false, and releases the versions taken so far, if the tile group is not
+// cold.
+bool LockColdTileGroup(storage::TileGroup *tile_group) {
+  auto header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (header->GetCurrentNextTupleSlot() < tuple_count) {
+    return false;
+  }
+
+  bool is_immutable = header->GetImmutability();
+
+  oid_t tuple_itr;
+  for (tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto &latch = header->GetSpinLatch(tuple_itr);
+    latch.Lock();
+    bool is_locked = false;
+    if (header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+      if (is_immutable == false) {
+        header->SetImmutability();
+      } else {
+        is_locked = header->SetAtomicTransactionId(tuple_itr, INVALID_TXN_ID,
+                                                   migration_txn_id);
+      }
+    } else {
+      is_locked = header->GetBeginCommitId(tuple_itr) != MAX_CID &&
+                  header->SetAtomicTransactionId(tuple_itr, migration_txn_id);
+    }
+    latch.Unlock();
+    if (is_locked == false) {
+      break;
+    }
+  }
+
+  // the delta versions that still read columns from older versions in other
+  // tile groups can not be copied on their own
+  if (tuple_itr == tuple_count && header->HasDeltaRecords() == false) {
+    return true;
+  }
+
+  for (oid_t unlock_itr = 0; unlock_itr < tuple_itr; unlock_itr++) {
+    ReleaseColdTuple(header, unlock_itr);
+  }
+  return false;
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -1212,6 +1535,9 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto storage_tilegroup = storage::StorageManager::GetInstance();
   auto tile_group = storage_tilegroup->GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
   auto diff = tile_group->GetLayout().GetLayoutDifference(*default_layout_);
 
   // Check threshold for transformation
@@ -1219,25 +1545,270 @@ storage::TileGroup *DataTable::TransformTileGroup(
     return nullptr;
   }
 
+  // A frozen or evicted tile group stays in the column layout
+  if (tile_group->IsFrozen() || tile_group->HasEvictedCopy()) {
+    return nullptr;
+  }
+
   LOG_TRACE("Transforming tile group : %u", tile_group_offset);
+  return MigrateTileGroup(tile_group, default_layout_, false, false);
+}
+
+storage::TileGroup *DataTable::FreezeTileGroup(const oid_t &tile_group_offset,
+                                               const eid_t &cold_epoch_id) {
+  if (tile_group_offset >= tile_groups_.GetSize()) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return nullptr;
+  }
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  auto tile_group =
+      storage::StorageManager::GetInstance()->GetTileGroup(tile_group_id);
+  if (tile_group == nullptr || tile_group->IsFrozen() ||
+      tile_group->HasEvictedCopy()) {
+    return nullptr;
+  }
+
+  // Every version must have been committed before the cold epoch. The
+  // epoch of a commit id is in its upper half.
+  auto header = tile_group->GetHeader();
+  auto tuple_count = std::min<oid_t>(header->GetCurrentNextTupleSlot(),
+                                     tile_group->GetAllocatedTupleCount());
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    // the slots reclaimed by the GC are cold
+    if (header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+      continue;
+    }
+    cid_t begin_cid = header->GetBeginCommitId(tuple_itr);
+    if (begin_cid == MAX_CID || (begin_cid >> 32) >= cold_epoch_id) {
+      return nullptr;
+    }
+  }
+
+  LOG_TRACE("Freezing tile group : %u", tile_group_offset);
+  std::shared_ptr<const Layout> column_layout(
+      new const Layout(schema->GetColumnCount(), LayoutType::COLUMN));
+  return MigrateTileGroup(tile_group, column_layout, true, false);
+}
+
+storage::TileGroup *DataTable::EvictTileGroup(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= tile_groups_.GetSize()) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return nullptr;
+  }
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  auto tile_group =
+      storage::StorageManager::GetInstance()->GetTileGroup(tile_group_id);
+  // An evicted tile group whose tiles have been read back in is evicted again
+  if (tile_group == nullptr ||
+      (tile_group->IsFrozen() == false && tile_group->IsFaultedIn() == false)) {
+    return nullptr;
+  }
+
+  LOG_TRACE("Evicting tile group : %u", tile_group_offset);
+  std::shared_ptr<const Layout> column_layout(
+      new const Layout(schema->GetColumnCount(), LayoutType::COLUMN));
+  return MigrateTileGroup(tile_group, column_layout, false, true);
+}
+
+void DataTable::PrefetchTileGroup(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= tile_groups_.GetSize()) {
+    return;
+  }
+
+  // Once the tile data takes up the memory budget, scans read the tile
+  // groups back in as they reach them, rather than ahead of themselves
+  size_t memory_budget =
+      static_cast<size_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::tile_group_memory_budget)) *
+      1024 * 1024;
+  if (memory_budget != 0 &&
+      storage::Tile::GetResidentDataSize() >= memory_budget) {
+    return;
+  }
+
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr || tile_group->IsEvicted() == false ||
+      tile_group->StartPrefetch() == false) {
+    return;
+  }
+
+  // The task keeps the tile group alive until it has been read back in. The
+  // reads block, so they run on a pool of their own.
+  threadpool::MonoQueuePool::GetPrefetchInstance().SubmitTask(
+      [tile_group] { tile_group->FaultIn(); });
+}
+
+bool DataTable::CompactTileGroup(const oid_t &tile_group_id,
+                                 const double &live_tuple_ratio) {
+  auto tile_group = GetTileGroupById(tile_group_id);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  auto header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (header->GetImmutability() == false) {
+    // Tuples are still inserted into a tile group that is not full
+    if (header->GetCurrentNextTupleSlot() < tuple_count) {
+      return false;
+    }
+    for (size_t active_itr = 0; active_itr < active_tilegroup_count_;
+         active_itr++) {
+      if (active_tile_groups_[active_itr].load() == tile_group.get()) {
+        return false;
+      }
+    }
+  }
+
+  oid_t live_tuple_count = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (header->GetTransactionId(tuple_itr) != INVALID_TXN_ID &&
+        header->GetEndCommitId(tuple_itr) == MAX_CID) {
+      live_tuple_count++;
+    }
+  }
+  if (header->GetImmutability() == false) {
+    if (live_tuple_count > live_tuple_ratio * tuple_count) {
+      return false;
+    }
+
+    // The slots of the tile group are not recycled from now on
+    header->SetImmutability();
+  }
+  if (live_tuple_count == 0) {
+    return true;
+  }
+
+  LOG_TRACE("Compacting tile group : %u", tile_group_id);
+
+  // Every visible tuple is copied into a new version. The indexes point to
+  // the indirections of the tuples, so they do not change.
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto column_count = schema->GetColumnCount();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (txn_manager.IsVisible(txn, header, tuple_itr) != VisibilityType::OK) {
+      continue;
+    }
+
+    // A tuple that is being modified is moved by a later compaction
+    if (txn_manager.IsOwnable(txn, header, tuple_itr) == false ||
+        txn_manager.AcquireOwnership(txn, header, tuple_itr) == false) {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      break;
+    }
+
+    ItemPointer new_location = AcquireVersion();
+    auto new_tile_group = GetTileGroupById(new_location.block);
+    ContainerTuple<storage::TileGroup> old_tuple(tile_group.get(), tuple_itr);
+    ContainerTuple<storage::TileGroup> new_tuple(new_tile_group.get(),
+                                                 new_location.offset);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      new_tuple.SetValue(column_itr, old_tuple.GetValue(column_itr));
+    }
+
+    txn_manager.PerformUpdate(txn, ItemPointer(tile_group_id, tuple_itr),
+                              new_location);
+  }
+
+  if (txn->GetResult() != ResultType::SUCCESS) {
+    txn_manager.AbortTransaction(txn);
+    return false;
+  }
+  return txn_manager.CommitTransaction(txn) == ResultType::SUCCESS;
+}
+
+bool DataTable::DropCompactedTileGroup(const oid_t &tile_group_id) {
+  auto tile_group = GetTileGroupById(tile_group_id);
+  if (tile_group == nullptr) {
+    return true;
+  }
+  PELOTON_ASSERT(tile_group->GetHeader()->GetImmutability());
+
+  // The GC resets the versions that it reclaims
+  auto header = tile_group->GetHeader();
+  for (oid_t tuple_itr = 0; tuple_itr < tile_group->GetAllocatedTupleCount();
+       tuple_itr++) {
+    if (header->GetTransactionId(tuple_itr) != INVALID_TXN_ID) {
+      return false;
+    }
+  }
+
+  // The offsets of the other tile groups stay the same
+  auto tile_groups_size = tile_groups_.GetSize();
+  for (std::size_t tile_groups_itr = 0; tile_groups_itr < tile_groups_size;
+       tile_groups_itr++) {
+    if (tile_groups_.Find(tile_groups_itr) == tile_group_id) {
+      tile_groups_.Erase(tile_groups_itr, invalid_tile_group_id);
+      break;
+    }
+  }
+
+  LOG_TRACE("Dropping compacted tile group : %u", tile_group_id);
+  storage::StorageManager::GetInstance()->DropTileGroup(tile_group_id);
+  return true;
+}
+
+storage::TileGroup *DataTable::MigrateTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group,
+    const std::shared_ptr<const Layout> &layout, bool freeze, bool evict) {
+  // Tuples are still inserted into an active tile group
+  for (size_t active_itr = 0; active_itr < active_tilegroup_count_;
+       active_itr++) {
+    if (active_tile_groups_[active_itr].load() == tile_group.get()) {
+      return nullptr;
+    }
+  }
+
+  // Only cold tile groups are migrated. Their versions stay owned by the
+  // migration, so the original tile group can not be modified anymore, even
+  // by transactions that still hold a pointer to it.
+  if (LockColdTileGroup(tile_group.get()) == false) {
+    LOG_TRACE("Tile group is not cold : %u", tile_group->GetTileGroupId());
+    return nullptr;
+  }
 
   // Get the schema for the new transformed tile group
-  auto new_schema =
-      TransformTileGroupSchema(tile_group.get(), *default_layout_);
+  auto new_schema = TransformTileGroupSchema(tile_group.get(), *layout);
 
   // Allocate space for the transformed tile group
   std::shared_ptr<storage::TileGroup> new_tile_group(
       TileGroupFactory::GetTileGroup(
           tile_group->GetDatabaseId(), tile_group->GetTableId(),
           tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
-          new_schema, default_layout_, tile_group->GetAllocatedTupleCount()));
+          new_schema, layout, tile_group->GetAllocatedTupleCount()));
+
+  // Set the transformed tile group column-at-a-time. The tiles of a tile
+  // group that is evicted again are not copied, as their data is still in
+  // the eviction file.
+  bool reevict = evict && tile_group->HasEvictedCopy();
+  SetTransformedTileGroup(tile_group.get(), new_tile_group.get(),
+                          reevict == false);
+
+  // The versions of the new tile group are not owned by the migration
+  auto new_header = new_tile_group->GetHeader();
+  for (oid_t tuple_itr = 0; tuple_itr < new_tile_group->GetAllocatedTupleCount();
+       tuple_itr++) {
+    ReleaseColdTuple(new_header, tuple_itr);
+  }
 
-  // Set the transformed tile group column-at-a-time
-  SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+  if (freeze) {
+    new_tile_group->Freeze();
+  }
+  if (reevict) {
+    new_tile_group->ShareEvictedCopy(*tile_group);
+  } else if (evict) {
+    new_tile_group->Evict(BackendType::SSD);
+  }
 
-  // Set the location of the new tile group
-  // and clean up the orig tile group
-  storage_tilegroup->AddTileGroup(tile_group_id, new_tile_group);
+  // Set the location of the new tile group. The orig tile group is
+  // reclaimed once the transactions that may still read it are done.
+  storage::StorageManager::GetInstance()->AddTileGroup(
+      tile_group->GetTileGroupId(), new_tile_group);
 
   return new_tile_group.get();
 }
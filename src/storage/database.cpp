@@ -17,8 +17,10 @@
 #include "common/logger.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
+#include "settings/settings_manager.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
+#include "tuning/layout_tuner.h"
 
 namespace peloton {
 namespace storage {
@@ -49,6 +51,12 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
       auto *gc_manager = &gc::GCManagerFactory::GetInstance();
       assert(gc_manager != nullptr);
       gc_manager->RegisterTable(table->GetOid());
+
+      // Register table to layout tuner.
+      if (settings::SettingsManager::GetBool(
+              settings::SettingId::layout_tuner)) {
+        tuning::LayoutTuner::GetInstance().AddTable(table);
+      }
     }
   }
 }
@@ -81,6 +89,8 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     oid_t table_offset = 0;
     for (auto table : tables) {
       if (table->GetOid() == table_oid) {
+        // Deregister table from layout tuner.
+        tuning::LayoutTuner::GetInstance().RemoveTable(table);
         delete table;
         break;
       }
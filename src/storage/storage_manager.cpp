@@ -12,6 +12,9 @@
 
 #include "storage/storage_manager.h"
 
+#include <algorithm>
+
+#include "concurrency/epoch_manager_factory.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
@@ -21,9 +24,17 @@ namespace storage {
 
 std::shared_ptr<storage::TileGroup> StorageManager::empty_tile_group_;
 
-StorageManager::StorageManager() = default;
+StorageManager::StorageManager() {
+  for (auto &block : tile_group_blocks_) {
+    block = nullptr;
+  }
+}
 
-StorageManager::~StorageManager() = default;
+StorageManager::~StorageManager() {
+  for (auto &block : tile_group_blocks_) {
+    delete[] block.load();
+  }
+}
 
 // Get instance of the global catalog storage manager
 StorageManager *StorageManager::GetInstance() {
@@ -123,13 +134,28 @@ bool StorageManager::RemoveDatabaseFromStorageManager(oid_t database_oid) {
 
 void StorageManager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
+  // a tile group that is replaced may still be read by running transactions.
+  std::shared_ptr<storage::TileGroup> old_location;
+  if (tile_group_locator_.Find(oid, old_location) &&
+      old_location != location) {
+    RetireTileGroup(std::move(old_location));
+  }
+
   // add/update the catalog reference to the tile group
+  SetTileGroupPtr(oid, location.get());
   tile_group_locator_.Upsert(oid, location);
 }
 
 void StorageManager::DropTileGroup(const oid_t oid) {
+  std::shared_ptr<storage::TileGroup> location;
+  if (tile_group_locator_.Find(oid, location) == false) {
+    return;
+  }
+
   // drop the catalog reference to the tile group
+  SetTileGroupPtr(oid, nullptr);
   tile_group_locator_.Erase(oid);
+  RetireTileGroup(std::move(location));
 }
 
 std::shared_ptr<storage::TileGroup> StorageManager::GetTileGroup(const oid_t oid) {
@@ -141,7 +167,64 @@ std::shared_ptr<storage::TileGroup> StorageManager::GetTileGroup(const oid_t oid
 }
 
 // used for logging test
-void StorageManager::ClearTileGroup() { tile_group_locator_.Clear(); }
+void StorageManager::ClearTileGroup() {
+  tile_group_locator_.Clear();
+  for (auto &block : tile_group_blocks_) {
+    auto tile_groups = block.load();
+    if (tile_groups == nullptr) {
+      continue;
+    }
+    for (size_t i = 0; i < tile_group_block_size_; ++i) {
+      tile_groups[i] = nullptr;
+    }
+  }
+}
+
+void StorageManager::SetTileGroupPtr(const oid_t oid,
+                                     storage::TileGroup *tile_group) {
+  auto &block = tile_group_blocks_[oid >> tile_group_block_bits_];
+  auto tile_groups = block.load();
+  if (tile_groups == nullptr) {
+    if (tile_group == nullptr) {
+      return;
+    }
+    auto new_tile_groups =
+        new std::atomic<storage::TileGroup *>[tile_group_block_size_]();
+    if (block.compare_exchange_strong(tile_groups, new_tile_groups)) {
+      tile_groups = new_tile_groups;
+    } else {
+      // another thread has allocated the block.
+      delete[] new_tile_groups;
+    }
+  }
+  tile_groups[oid & (tile_group_block_size_ - 1)] = tile_group;
+}
+
+void StorageManager::RetireTileGroup(
+    std::shared_ptr<storage::TileGroup> tile_group) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  eid_t current_eid = epoch_manager.GetCurrentEpochId();
+  eid_t expired_eid = epoch_manager.GetExpiredEpochId();
+
+  // the tile groups are freed outside of the latch.
+  std::vector<std::shared_ptr<storage::TileGroup>> expired_tile_groups;
+
+  retired_tile_group_latch_.Lock();
+  retired_tile_groups_.emplace_back(current_eid, std::move(tile_group));
+  // MAX_EID means that no thread is in any epoch.
+  auto itr = std::partition(
+      retired_tile_groups_.begin(), retired_tile_groups_.end(),
+      [expired_eid](
+          const std::pair<eid_t, std::shared_ptr<storage::TileGroup>> &entry) {
+        return expired_eid != MAX_EID && entry.first > expired_eid;
+      });
+  for (auto expired_itr = itr; expired_itr != retired_tile_groups_.end();
+       ++expired_itr) {
+    expired_tile_groups.push_back(std::move(expired_itr->second));
+  }
+  retired_tile_groups_.erase(itr, retired_tile_groups_.end());
+  retired_tile_group_latch_.Unlock();
+}
 
 }  // namespace storage
 }  // namespace peloton
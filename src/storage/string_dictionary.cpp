@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.cpp
+//
+// Identification: src/storage/string_dictionary.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/string_dictionary.h"
+
+namespace peloton {
+namespace storage {
+
+const int32_t StringDictionary::invalid_code_;
+
+const char *StringDictionary::Intern(const char *data, uint32_t length) {
+  StringKey key{data, length};
+
+  // Most strings of a low cardinality column are already in the dictionary
+  latch_.ReadLock();
+  auto varlen_itr = varlens_.find(key);
+  if (varlen_itr != varlens_.end()) {
+    const char *varlen = varlen_itr->second;
+    latch_.Unlock();
+    return varlen;
+  }
+  latch_.Unlock();
+
+  latch_.WriteLock();
+  varlen_itr = varlens_.find(key);
+  if (varlen_itr != varlens_.end()) {
+    const char *varlen = varlen_itr->second;
+    latch_.Unlock();
+    return varlen;
+  }
+
+  int32_t code = static_cast<int32_t>(entries_.size()) + 1;
+  auto *entry = static_cast<char *>(
+      pool_.Allocate(sizeof(int32_t) + sizeof(uint32_t) + length));
+  PELOTON_MEMCPY(entry, &code, sizeof(int32_t));
+  char *varlen = entry + sizeof(int32_t);
+  PELOTON_MEMCPY(varlen, &length, sizeof(uint32_t));
+  PELOTON_MEMCPY(varlen + sizeof(uint32_t), data, length);
+
+  entries_.push_back(entry);
+  varlens_.emplace(StringKey{varlen + sizeof(uint32_t), length}, varlen);
+  latch_.Unlock();
+
+  return varlen;
+}
+
+void StringDictionary::SerializeTo(const type::Value &value, char *storage) {
+  const char *varlen = nullptr;
+  if (value.IsNull() == false) {
+    varlen = Intern(value.GetData(), value.GetLength());
+  }
+  *reinterpret_cast<const char **>(storage) = varlen;
+}
+
+int32_t StringDictionary::GetCode(const char *data, uint32_t length) const {
+  StringKey key{data, length};
+
+  latch_.ReadLock();
+  auto varlen_itr = varlens_.find(key);
+  int32_t code =
+      (varlen_itr != varlens_.end()) ? GetCode(varlen_itr->second)
+                                     : invalid_code_;
+  latch_.Unlock();
+
+  return code;
+}
+
+const char *StringDictionary::GetVarlen(int32_t code) const {
+  const char *varlen = nullptr;
+
+  latch_.ReadLock();
+  if (code > 0 && static_cast<size_t>(code) <= entries_.size()) {
+    varlen = entries_[code - 1] + sizeof(int32_t);
+  }
+  latch_.Unlock();
+
+  return varlen;
+}
+
+size_t StringDictionary::GetStringCount() const {
+  latch_.ReadLock();
+  size_t string_count = entries_.size();
+  latch_.Unlock();
+  return string_count;
+}
+
+}  // namespace storage
+}  // namespace peloton
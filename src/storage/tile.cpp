@@ -18,10 +18,12 @@
 #include "common/macros.h"
 #include "type/serializer.h"
 #include "common/internal_types.h"
-#include "type/ephemeral_pool.h"
+#include "type/arena_pool.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/backend_manager.h"
+#include "storage/string_dictionary.h"
 #include "storage/tile.h"
+#include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
 #include "storage/tuple_iterator.h"
@@ -29,6 +31,8 @@
 namespace peloton {
 namespace storage {
 
+std::atomic<size_t> Tile::resident_data_size{0};
+
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
            int tuple_count)
@@ -40,7 +44,6 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       schema(tuple_schema),
       data(NULL),
       tile_group(tile_group),
-      pool(NULL),
       num_tuple_slots(tuple_count),
       column_count(tuple_schema.GetColumnCount()),
       tuple_length(tuple_schema.GetLength()),
@@ -53,41 +56,53 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
   tile_size = tuple_count * tuple_length;
 
   // allocate tuple storage space for inlined data
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // data = reinterpret_cast<char *>(
-  // storage_manager.Allocate(backend_type, tile_size));
+  AllocateData();
 
-  data = new char[tile_size];
-  PELOTON_ASSERT(data != NULL);
-
-  // zero out the data
-  PELOTON_MEMSET(data, 0, tile_size);
-
-  // allocate pool for blob storage if schema not inlined
-  // if (schema.IsInlined() == false) {
-  pool = new type::EphemeralPool();
-  //}
+  // uninlined data is allocated from the arena of the tile group, and a
+  // tile without a tile group gets an arena of its own
+  if (tile_group != nullptr) {
+    pool = tile_group->varlen_pool_;
+  } else {
+    pool.reset(new type::ArenaPool());
+  }
 }
 
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // storage_manager.Release(backend_type, data);
-
-  delete[] data;
-  data = NULL;
+  ReleaseData();
 
   // reclaim the tile memory (UNINLINED data)
-  // if (schema.IsInlined() == false) {
-  delete pool;
-  //}
-  pool = NULL;
+  pool.reset();
 
   // clear any cached column headers
   if (column_header) delete column_header;
   column_header = NULL;
 }
 
+void Tile::ReleaseData() {
+  if (data == NULL) {
+    return;
+  }
+  auto &backend_manager = BackendManager::GetInstance();
+  backend_manager.Release(backend_type, data);
+  data = NULL;
+  resident_data_size -= tile_size;
+}
+
+// The backend manager places the data on huge pages, and on the NUMA node of
+// the inserting thread, if the settings ask for it
+void Tile::AllocateData() {
+  PELOTON_ASSERT(data == NULL);
+  auto &backend_manager = BackendManager::GetInstance();
+  data = reinterpret_cast<char *>(
+      backend_manager.Allocate(backend_type, tile_size));
+  PELOTON_ASSERT(data != NULL);
+  resident_data_size += tile_size;
+
+  // zero out the data
+  PELOTON_MEMSET(data, 0, tile_size);
+}
+
 //===--------------------------------------------------------------------===//
 // Tuples
 //===--------------------------------------------------------------------===//
@@ -116,6 +131,15 @@ type::Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
 
   const type::TypeId column_type = schema.GetType(column_id);
 
+  // the value of a delta version may be held by an older version
+  if (IsInherited(tuple_offset, column_id) == true) {
+    oid_t table_column_id = table_column_ids[column_id];
+    oid_t older_tuple_offset = tuple_offset;
+    auto older_tile_group =
+        tile_group->LocateValue(older_tuple_offset, table_column_id);
+    return older_tile_group->GetValue(older_tuple_offset, table_column_id);
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + schema.GetOffset(column_id);
   const bool is_inlined = schema.IsInlined(column_id);
@@ -135,12 +159,32 @@ type::Value Tile::GetValueFast(const oid_t tuple_offset,
   PELOTON_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PELOTON_ASSERT(column_offset < schema.GetLength());
 
+  // the slots of delta versions are read column by column
+  if (tile_group_header != nullptr &&
+      tile_group_header->HasDeltaRecords() == true) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (schema.GetOffset(column_itr) == column_offset) {
+        return GetValue(tuple_offset, column_itr);
+      }
+    }
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + column_offset;
 
   return type::Value::DeserializeFrom(field_location, column_type, is_inlined);
 }
 
+bool Tile::IsInherited(const oid_t tuple_offset, const oid_t column_id) const {
+  if (tile_group_header == nullptr ||
+      tile_group_header->HasDeltaRecords() == false) {
+    return false;
+  }
+  auto delta_record = tile_group_header->GetDeltaRecord(tuple_offset);
+  return delta_record != nullptr &&
+         delta_record->IsInherited(table_column_ids[column_id]);
+}
+
 /**
  * Sets value at tuple slot.
  */
@@ -157,13 +201,23 @@ void Tile::SetValue(const type::Value &value, const oid_t tuple_offset,
 
   // const bool is_in_bytes = false;
   PELOTON_ASSERT(pool != nullptr);
+  // The strings of a dictionary-encoded column are interned
+  auto *dictionary = schema.GetDictionary(column_id);
   // Cast the value if the type is different from column type
   const type::TypeId col_type = schema.GetType(column_id);
   if (value.GetTypeId() == col_type) {
-    value.SerializeTo(field_location, is_inlined, pool);
+    if (dictionary != nullptr) {
+      dictionary->SerializeTo(value, field_location);
+    } else {
+      value.SerializeTo(field_location, is_inlined, pool.get());
+    }
   } else {
     type::Value casted_value = value.CastAs(col_type);
-    casted_value.SerializeTo(field_location, is_inlined, pool);
+    if (dictionary != nullptr) {
+      dictionary->SerializeTo(casted_value, field_location);
+    } else {
+      casted_value.SerializeTo(field_location, is_inlined, pool.get());
+    }
   }
 }
 
@@ -183,7 +237,7 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
 
   // const bool is_in_bytes = false;
   PELOTON_ASSERT(pool != nullptr);
-  value.SerializeTo(field_location, is_inlined, pool);
+  value.SerializeTo(field_location, is_inlined, pool.get());
 }
 
 Tile *Tile::CopyTile(BackendType backend_type) {
@@ -196,6 +250,7 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   Tile *new_tile = TileFactory::GetTile(
       backend_type, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
       new_header, *schema, tile_group, allocated_tuple_count);
+  new_tile->table_column_ids = table_column_ids;
 
   PELOTON_MEMCPY(static_cast<void *>(new_tile->data), static_cast<void *>(data),
             tile_size);
@@ -20,10 +20,12 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "storage/abstract_table.h"
+#include "storage/backend_manager.h"
 #include "storage/layout.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "type/arena_pool.h"
 #include "util/stringbox_util.h"
 
 namespace peloton {
@@ -40,7 +42,8 @@ TileGroup::TileGroup(BackendType backend_type,
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots_(tuple_count),
-      tile_group_layout_(layout) {
+      tile_group_layout_(layout),
+      varlen_pool_(new type::ArenaPool()) {
   tile_count_ = schemas.size();
   for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
     StorageManager *storage_manager = storage::StorageManager::GetInstance();
@@ -53,6 +56,31 @@ TileGroup::TileGroup(BackendType backend_type,
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  std::vector<std::vector<oid_t>> table_column_ids(tile_count_);
+  for (oid_t column_itr = 0; column_itr < tile_group_layout_->GetColumnCount();
+       column_itr++) {
+    oid_t tile_offset, tile_column_id;
+    tile_group_layout_->LocateTileAndColumn(column_itr, tile_offset,
+                                            tile_column_id);
+    if (table_column_ids[tile_offset].size() <= tile_column_id) {
+      table_column_ids[tile_offset].resize(tile_column_id + 1);
+    }
+    table_column_ids[tile_offset][tile_column_id] = column_itr;
+  }
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    tiles[tile_itr]->SetTableColumnIds(table_column_ids[tile_itr]);
+  }
+
+  std::vector<type::TypeId> column_types;
+  oid_t column_count = tile_group_layout_->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    oid_t tile_offset, tile_column_id;
+    tile_group_layout_->LocateTileAndColumn(column_itr, tile_offset,
+                                            tile_column_id);
+    column_types.push_back(schemas[tile_offset].GetType(tile_column_id));
+  }
+  zone_map_.reset(new ZoneMap(column_types));
 }
 
 TileGroup::~TileGroup() {
@@ -122,6 +150,7 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map_->Widen(column_itr, val);
       column_itr++;
     }
   }
@@ -203,6 +232,7 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map_->Widen(column_itr, val);
       column_itr++;
     }
   }
@@ -302,6 +332,7 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      zone_map_->Widen(column_itr, val);
       column_itr++;
     }
   }
@@ -315,11 +346,51 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
   return tuple_slot_id;
 }
 
+oid_t TileGroup::InsertTuplesFromCheckpoint(oid_t tuple_slot_id,
+                                            oid_t tuple_count,
+                                            const char *tuple_data,
+                                            const cid_t *commit_ids) {
+  // the tuples must be in the row layout of a single tile.
+  PELOTON_ASSERT(tile_count_ == 1);
+
+  if (tuple_count == 0) return tuple_slot_id;
+
+  auto status =
+      tile_group_header->GetEmptyTupleSlot(tuple_slot_id + tuple_count - 1);
+
+  // No more slots
+  if (status == false) return INVALID_OID;
+
+  storage::Tile *tile = GetTile(0);
+  PELOTON_ASSERT(tile);
+  size_t tuple_length = tile->GetSchema()->GetLength();
+  PELOTON_MEMCPY(tile->GetTupleLocation(tuple_slot_id), tuple_data,
+                 tuple_count * tuple_length);
+
+  // Set MVCC info
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    oid_t tuple_slot = tuple_slot_id + tuple_itr;
+    UpdateZoneMap(tuple_slot);
+    tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    tile_group_header->SetBeginCommitId(tuple_slot, commit_ids[tuple_itr]);
+    tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+  }
+
+  return tuple_slot_id;
+}
+
 type::Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   PELOTON_ASSERT(tuple_id < GetNextTupleSlot());
   oid_t tile_column_id, tile_offset;
   tile_group_layout_->LocateTileAndColumn(column_id, tile_offset,
                                           tile_column_id);
+
+  // the value of a frozen tile is decoded without thawing the tile
+  auto compressed_column = GetCompressedColumn(column_id);
+  if (compressed_column != nullptr) {
+    return compressed_column->GetValue(tuple_id);
+  }
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
 }
 
@@ -330,15 +401,256 @@ void TileGroup::SetValue(type::Value &value, oid_t tuple_id,
   tile_group_layout_->LocateTileAndColumn(column_id, tile_offset,
                                           tile_column_id);
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+
+  zone_map_->Widen(column_id, value);
+}
+
+void TileGroup::UpdateZoneMap(oid_t tuple_slot_id) {
+  oid_t column_count = tile_group_layout_->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    if (zone_map_->IsTracked(column_itr)) {
+      zone_map_->Widen(column_itr, GetValue(tuple_slot_id, column_itr));
+    }
+  }
 }
 
+TileGroup *TileGroup::LocateValue(oid_t &tuple_id, oid_t column_id) {
+  TileGroup *tile_group = this;
+  while (tile_group->tile_group_header->HasDeltaRecords() == true) {
+    auto delta_record =
+        tile_group->tile_group_header->GetDeltaRecord(tuple_id);
+    if (delta_record == nullptr ||
+        delta_record->IsInherited(column_id) == false) {
+      break;
+    }
+    // the older version is reclaimed only after the column is folded
+    auto &older_location = delta_record->GetOlderLocation();
+    tile_group =
+        StorageManager::GetInstance()->GetTileGroupPtr(older_location.block);
+    PELOTON_ASSERT(tile_group != nullptr);
+    tuple_id = older_location.offset;
+  }
+  return tile_group;
+}
+
+void TileGroup::FoldDeltaVersion(oid_t tuple_id,
+                                 const ItemPointer &older_location) {
+  auto delta_record = tile_group_header->GetDeltaRecord(tuple_id);
+  // the slot may have been reclaimed and reused by another version
+  if (delta_record == nullptr || delta_record->IsFolded() == true ||
+      !(delta_record->GetOlderLocation() == older_location)) {
+    return;
+  }
+
+  oid_t column_count = tile_group_layout_->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    if (delta_record->IsInherited(column_itr) == true) {
+      auto value = GetValue(tuple_id, column_itr);
+      SetValue(value, tuple_id, column_itr);
+    }
+  }
+
+  // readers go on reading the older version until the record is folded
+  tile_group_header->FoldDeltaRecord(tuple_id);
+}
 
 std::shared_ptr<Tile> TileGroup::GetTileReference(
     const oid_t tile_offset) const {
   PELOTON_ASSERT(tile_offset < tile_count_);
+  if (frozen_tile_count_.load(std::memory_order_acquire) != 0) {
+    ThawTile(tile_offset);
+  }
+  if (evicted_tile_count_.load(std::memory_order_acquire) != 0) {
+    FaultInTile(tile_offset);
+  }
   return tiles[tile_offset];
 }
 
+//===--------------------------------------------------------------------===//
+// Frozen tile groups
+//===--------------------------------------------------------------------===//
+
+void TileGroup::Freeze() {
+  PELOTON_ASSERT(tile_group_layout_->IsColumnStore());
+  PELOTON_ASSERT(IsFrozen() == false);
+
+  compressed_columns_.resize(tile_count_);
+  frozen_tiles_.reset(new std::atomic<bool>[tile_count_]);
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    frozen_tiles_[tile_itr] = false;
+
+    auto tile = tiles[tile_itr].get();
+    auto tile_schema = tile->GetSchema();
+    PELOTON_ASSERT(tile_schema->GetColumnCount() == 1);
+    if (tile_schema->IsInlined(0) == false) {
+      continue;
+    }
+
+    auto compressed_column = CompressedColumn::Compress(
+        tile_schema->GetType(0), tile->GetTupleLocation(0),
+        tile_schema->GetLength(), num_tuple_slots_);
+    if (compressed_column == nullptr) {
+      continue;
+    }
+
+    tile->ReleaseData();
+    compressed_columns_[tile_itr] = std::move(compressed_column);
+    frozen_tiles_[tile_itr] = true;
+    frozen_tile_count_++;
+  }
+
+  LOG_TRACE("Froze tile group %u : %u compressed columns, %lu bytes",
+            tile_group_id, frozen_tile_count_.load(), GetCompressedSize());
+}
+
+const CompressedColumn *TileGroup::GetCompressedColumn(
+    oid_t column_id) const {
+  if (frozen_tile_count_.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  oid_t tile_offset = tile_group_layout_->GetTileIdFromColumnId(column_id);
+  if (frozen_tiles_[tile_offset].load(std::memory_order_acquire) == false) {
+    return nullptr;
+  }
+  return compressed_columns_[tile_offset].get();
+}
+
+size_t TileGroup::GetCompressedSize() const {
+  size_t compressed_size = 0;
+  for (oid_t tile_itr = 0; tile_itr < compressed_columns_.size(); tile_itr++) {
+    if (frozen_tiles_[tile_itr].load(std::memory_order_acquire) == true) {
+      compressed_size += compressed_columns_[tile_itr]->GetSize();
+    }
+  }
+  return compressed_size;
+}
+
+// The tile is thawed when it is accessed through anything but the compressed
+// column, e.g. to be modified. Neither its data nor its compressed column are
+// released, since accessors may keep using them. The tile group is not frozen
+// from then on, so the layout tuner freezes it again into a new tile group
+// once it is cold, and both are reclaimed along with this one.
+void TileGroup::ThawTile(const oid_t tile_offset) const {
+  if (frozen_tiles_[tile_offset].load(std::memory_order_acquire) == false) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(thaw_mutex_);
+  if (frozen_tiles_[tile_offset].load(std::memory_order_relaxed) == false) {
+    return;
+  }
+
+  auto tile = tiles[tile_offset].get();
+  tile->AllocateData();
+  compressed_columns_[tile_offset]->Decompress(
+      tile->GetTupleLocation(0), tile->GetSchema()->GetLength());
+
+  frozen_tiles_[tile_offset].store(false, std::memory_order_release);
+  frozen_tile_count_--;
+  thawed_tile_count_++;
+  LOG_TRACE("Thawed tile %u of tile group %u", tile_offset, tile_group_id);
+}
+
+//===--------------------------------------------------------------------===//
+// Evicted tile groups
+//===--------------------------------------------------------------------===//
+
+EvictedCopy::~EvictedCopy() {
+  auto &backend_manager = BackendManager::GetInstance();
+  for (size_t tile_itr = 0; tile_itr < offsets.size(); tile_itr++) {
+    backend_manager.ReleaseEvicted(backend, offsets[tile_itr],
+                                   sizes[tile_itr]);
+  }
+}
+
+void TileGroup::Evict(BackendType eviction_backend) {
+  PELOTON_ASSERT(IsFrozen() == false && HasEvictedCopy() == false);
+
+  auto &backend_manager = BackendManager::GetInstance();
+  std::shared_ptr<EvictedCopy> evicted_copy(new EvictedCopy());
+  evicted_copy->backend = eviction_backend;
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    auto tile = tiles[tile_itr].get();
+    evicted_copy->offsets.push_back(backend_manager.WriteEvicted(
+        eviction_backend, tile->GetTupleLocation(0), tile->GetInlinedSize()));
+    evicted_copy->sizes.push_back(tile->GetInlinedSize());
+  }
+
+  evicted_copy_ = std::move(evicted_copy);
+  ReleaseEvictedTiles();
+}
+
+void TileGroup::ShareEvictedCopy(const TileGroup &evicted_tile_group) {
+  PELOTON_ASSERT(IsFrozen() == false && HasEvictedCopy() == false);
+  PELOTON_ASSERT(evicted_tile_group.HasEvictedCopy());
+  PELOTON_ASSERT(tile_count_ == evicted_tile_group.tile_count_);
+
+  evicted_copy_ = evicted_tile_group.evicted_copy_;
+  ReleaseEvictedTiles();
+}
+
+void TileGroup::ReleaseEvictedTiles() {
+  evicted_tiles_.reset(new std::atomic<bool>[tile_count_]);
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    tiles[tile_itr]->ReleaseData();
+    evicted_tiles_[tile_itr] = true;
+    evicted_tile_count_++;
+  }
+
+  LOG_TRACE("Evicted tile group %u : %u tiles", tile_group_id,
+            evicted_tile_count_.load());
+}
+
+void TileGroup::FaultIn() {
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    if (evicted_tile_count_.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+    FaultInTile(tile_itr);
+  }
+}
+
+size_t TileGroup::GetResidentSize() const {
+  size_t resident_size = 0;
+  for (oid_t tile_itr = 0; tile_itr < tile_count_; tile_itr++) {
+    if (frozen_tiles_ != nullptr &&
+        frozen_tiles_[tile_itr].load(std::memory_order_acquire) == true) {
+      continue;
+    }
+    if (evicted_tiles_ != nullptr &&
+        evicted_tiles_[tile_itr].load(std::memory_order_acquire) == true) {
+      continue;
+    }
+    resident_size += tiles[tile_itr]->GetInlinedSize();
+  }
+  return resident_size;
+}
+
+// A tile that is read back in stays in memory until the tile group is evicted
+// again. The copy in the file is kept, so evicting it again does not write it.
+void TileGroup::FaultInTile(const oid_t tile_offset) const {
+  if (evicted_tiles_[tile_offset].load(std::memory_order_acquire) == false) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(thaw_mutex_);
+  if (evicted_tiles_[tile_offset].load(std::memory_order_relaxed) == false) {
+    return;
+  }
+
+  auto tile = tiles[tile_offset].get();
+  auto &backend_manager = BackendManager::GetInstance();
+  tile->AllocateData();
+  backend_manager.ReadEvicted(
+      evicted_copy_->backend, evicted_copy_->offsets[tile_offset],
+      tile->GetTupleLocation(0), evicted_copy_->sizes[tile_offset]);
+
+  evicted_tiles_[tile_offset].store(false, std::memory_order_release);
+  evicted_tile_count_--;
+  LOG_TRACE("Faulted in tile %u of tile group %u", tile_offset, tile_group_id);
+}
+
 void TileGroup::Sync() {
   // Sync the tile group data by syncing all the underlying tiles
   for (auto tile : tiles) {
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #include "storage/tile_group_header.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -36,7 +37,9 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       tile_group(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      all_visible_cid_(MAX_CID),
+      delta_record_count_(0) {
   tuple_headers_.reset(new TupleHeader[tuple_count]);
 
   // Set MVCC Initial Value
@@ -55,6 +58,53 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
   immutable = false;
 }
 
+TileGroupHeader::~TileGroupHeader() {
+  if (delta_records_ != nullptr) {
+    for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+         tuple_slot_id++) {
+      delete delta_records_[tuple_slot_id].load();
+    }
+  }
+}
+
+void TileGroupHeader::SetDeltaRecord(const oid_t &tuple_slot_id,
+                                     DeltaRecord *delta_record) {
+  if (delta_records_ == nullptr) {
+    tile_header_lock.Lock();
+    if (delta_records_ == nullptr) {
+      std::unique_ptr<std::atomic<DeltaRecord *>[]> delta_records(
+          new std::atomic<DeltaRecord *>[num_tuple_slots]);
+      for (oid_t slot_itr = START_OID; slot_itr < num_tuple_slots;
+           slot_itr++) {
+        delta_records[slot_itr] = nullptr;
+      }
+      delta_records_ = std::move(delta_records);
+    }
+    tile_header_lock.Unlock();
+  }
+
+  PELOTON_ASSERT(GetDeltaRecord(tuple_slot_id) == nullptr);
+  delta_record_count_.fetch_add(1, std::memory_order_acq_rel);
+  delta_records_[tuple_slot_id].store(delta_record, std::memory_order_release);
+}
+
+void TileGroupHeader::FoldDeltaRecord(const oid_t &tuple_slot_id) {
+  auto delta_record = GetDeltaRecord(tuple_slot_id);
+  if (delta_record != nullptr && delta_record->SetFolded() == true) {
+    delta_record_count_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void TileGroupHeader::ReleaseDeltaRecord(const oid_t &tuple_slot_id) {
+  auto delta_record = GetDeltaRecord(tuple_slot_id);
+  if (delta_record == nullptr) {
+    return;
+  }
+  FoldDeltaRecord(tuple_slot_id);
+  delta_records_[tuple_slot_id].store(nullptr, std::memory_order_release);
+  delete delta_record;
+}
+
 //===--------------------------------------------------------------------===//
 // Tile Group Header
 //===--------------------------------------------------------------------===//
@@ -207,6 +257,48 @@ void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
   LOG_TRACE("%s", os.str().c_str());
 }
 
+// Record that every version of a full tile group is live and was committed
+// before settled_cid, so that scans can skip the per-version visibility checks.
+// The tile group is marked pending while its versions are checked. A
+// transaction that takes one of the versions in the meantime resets the
+// marker, so that the all-visible commit id is not set.
+bool TileGroupHeader::SetAllVisible(const cid_t &settled_cid) {
+  static const cid_t pending_cid = MAX_CID - 1;
+
+  cid_t all_visible_cid = all_visible_cid_;
+  if (all_visible_cid != MAX_CID) {
+    return all_visible_cid != pending_cid;
+  }
+
+  // Tuples are still inserted into a tile group that is not full
+  if (GetCurrentNextTupleSlot() < num_tuple_slots) {
+    return false;
+  }
+
+  if (all_visible_cid_.compare_exchange_strong(all_visible_cid,
+                                               pending_cid) == false) {
+    return false;
+  }
+
+  cid_t max_begin_cid = 0;
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+       tuple_slot_id++) {
+    cid_t begin_cid = GetBeginCommitId(tuple_slot_id);
+    if (GetTransactionId(tuple_slot_id) != INITIAL_TXN_ID ||
+        begin_cid >= settled_cid ||
+        GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      all_visible_cid = pending_cid;
+      all_visible_cid_.compare_exchange_strong(all_visible_cid, MAX_CID);
+      return false;
+    }
+    max_begin_cid = std::max(max_begin_cid, begin_cid);
+  }
+
+  all_visible_cid = pending_cid;
+  return all_visible_cid_.compare_exchange_strong(all_visible_cid,
+                                                  max_begin_cid);
+}
+
 // this function is called only when building tile groups for aggregation
 // operations.
 oid_t TileGroupHeader::GetActiveTupleCount() const {
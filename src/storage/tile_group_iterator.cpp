@@ -19,10 +19,12 @@ namespace peloton {
 namespace storage {
 
 bool TileGroupIterator::Next(std::shared_ptr<TileGroup> &tileGroup) {
-  if (HasNext()) {
+  while (HasNext()) {
     auto next = table_->GetTileGroup(tile_group_itr_);
-    tileGroup.swap(next);
     tile_group_itr_++;
+    // skip the tile groups that have been dropped after compaction
+    if (next == nullptr) continue;
+    tileGroup.swap(next);
     return (true);
   }
   return (false);
@@ -19,6 +19,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "storage/string_dictionary.h"
 #include "storage/tuple.h"
 #include "type/value.h"
 #include "type/value_factory.h"
@@ -57,6 +58,9 @@ void Tuple::SetValue(const oid_t column_offset, const type::Value &value,
             column_offset, value_location, column_length,
             TypeIdToString(type).c_str());
 
+  // The strings of a dictionary-encoded column are interned
+  auto *dictionary = tuple_schema_->GetDictionary(column_offset);
+
   // Skip casting if type is same
   if (type == value.GetTypeId()) {
     if ((type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY)
@@ -64,10 +68,18 @@ void Tuple::SetValue(const oid_t column_offset, const type::Value &value,
         && value.GetLength() > column_length + 1) {      // value.GetLength() == strlen(value) + 1 because of '\0'
       throw peloton::ValueOutOfRangeException(type, column_length);
     }
-    value.SerializeTo(value_location, is_inlined, data_pool);
+    if (dictionary != nullptr) {
+      dictionary->SerializeTo(value, value_location);
+    } else {
+      value.SerializeTo(value_location, is_inlined, data_pool);
+    }
   } else {
     type::Value casted_value = (value.CastAs(type));
-    casted_value.SerializeTo(value_location, is_inlined, data_pool);
+    if (dictionary != nullptr) {
+      dictionary->SerializeTo(casted_value, value_location);
+    } else {
+      casted_value.SerializeTo(value_location, is_inlined, data_pool);
+    }
   }
 }
 
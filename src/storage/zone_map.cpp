@@ -0,0 +1,228 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/zone_map.h"
+
+#include <cstring>
+#include <limits>
+
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+bool IsNumericType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// whether a predicate value can be compared with the range of a column
+// without a cast that may fail.
+bool IsComparable(type::TypeId column_type, type::TypeId value_type) {
+  if (IsNumericType(column_type)) {
+    return IsNumericType(value_type);
+  }
+  return column_type == value_type;
+}
+
+}  // namespace
+
+ZoneMap::ZoneMap(const std::vector<type::TypeId> &column_types)
+    : column_count_(column_types.size()),
+      column_types_(column_types),
+      ranges_(new ColumnRange[column_types.size()]) {
+  for (oid_t column_itr = 0; column_itr < column_count_; column_itr++) {
+    ranges_[column_itr].min = std::numeric_limits<int64_t>::max();
+    ranges_[column_itr].max = std::numeric_limits<int64_t>::min();
+  }
+}
+
+void ZoneMap::Widen(oid_t column_id, const type::Value &value) {
+  if (IsTracked(column_id) == false || value.IsNull()) {
+    return;
+  }
+
+  auto column_type = column_types_[column_id];
+  int64_t encoded = (value.GetTypeId() == column_type)
+                        ? Encode(column_type, value)
+                        : Encode(column_type, value.CastAs(column_type));
+
+  auto &range = ranges_[column_id];
+  int64_t current = range.min.load();
+  while (encoded < current &&
+         range.min.compare_exchange_weak(current, encoded) == false) {
+  }
+  current = range.max.load();
+  while (encoded > current &&
+         range.max.compare_exchange_weak(current, encoded) == false) {
+  }
+}
+
+void ZoneMap::CopyFrom(const ZoneMap &other) {
+  PELOTON_ASSERT(column_types_ == other.column_types_);
+  for (oid_t column_itr = 0; column_itr < column_count_; column_itr++) {
+    ranges_[column_itr].min = other.ranges_[column_itr].min.load();
+    ranges_[column_itr].max = other.ranges_[column_itr].max.load();
+  }
+}
+
+bool ZoneMap::ShouldScan(const PredicateInfo *predicates,
+                         int32_t num_predicates) const {
+  for (int32_t predicate_itr = 0; predicate_itr < num_predicates;
+       predicate_itr++) {
+    const PredicateInfo &predicate = predicates[predicate_itr];
+    const type::Value &value = predicate.predicate_value;
+    if (predicate.col_id < 0) {
+      continue;
+    }
+
+    oid_t column_id = predicate.col_id;
+    type::Value min, max;
+    if (GetRange(column_id, min, max) == false ||
+        IsComparable(column_types_[column_id], value.GetTypeId()) == false) {
+      continue;
+    }
+
+    bool may_match = true;
+    switch (static_cast<ExpressionType>(predicate.comparison_operator)) {
+      case ExpressionType::COMPARE_EQUAL:
+        may_match =
+            value.CompareGreaterThanEquals(min) == CmpBool::CmpTrue &&
+            value.CompareLessThanEquals(max) == CmpBool::CmpTrue;
+        break;
+      case ExpressionType::COMPARE_LESSTHAN:
+        may_match = value.CompareGreaterThan(min) == CmpBool::CmpTrue;
+        break;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        may_match = value.CompareGreaterThanEquals(min) == CmpBool::CmpTrue;
+        break;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        may_match = value.CompareLessThan(max) == CmpBool::CmpTrue;
+        break;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        may_match = value.CompareLessThanEquals(max) == CmpBool::CmpTrue;
+        break;
+      default:
+        break;
+    }
+    if (may_match == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ZoneMap::GetRange(oid_t column_id, type::Value &min,
+                       type::Value &max) const {
+  if (IsTracked(column_id) == false) {
+    return false;
+  }
+
+  int64_t encoded_min = ranges_[column_id].min.load();
+  int64_t encoded_max = ranges_[column_id].max.load();
+  if (encoded_min > encoded_max) {
+    return false;
+  }
+
+  min = Decode(column_types_[column_id], encoded_min);
+  max = Decode(column_types_[column_id], encoded_max);
+  return true;
+}
+
+bool ZoneMap::IsTrackedType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::DATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t ZoneMap::Encode(type::TypeId type_id, const type::Value &value) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::TypeId::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::TypeId::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::TypeId::BIGINT:
+      return value.GetAs<int64_t>();
+    case type::TypeId::TIMESTAMP:
+      return static_cast<int64_t>(value.GetAs<uint64_t>());
+    case type::TypeId::DATE:
+      return value.GetAs<int32_t>();
+    case type::TypeId::DECIMAL: {
+      // flip the bits of a negative double except for the sign, so that the
+      // order of the integers is the order of the doubles.
+      double decimal = value.GetAs<double>();
+      int64_t encoded;
+      PELOTON_MEMCPY(&encoded, &decimal, sizeof(encoded));
+      if (encoded < 0) {
+        encoded ^= std::numeric_limits<int64_t>::max();
+      }
+      return encoded;
+    }
+    default:
+      PELOTON_ASSERT(false);
+      return 0;
+  }
+}
+
+type::Value ZoneMap::Decode(type::TypeId type_id, int64_t encoded) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(static_cast<int8_t>(encoded));
+    case type::TypeId::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(encoded));
+    case type::TypeId::INTEGER:
+      return type::ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(encoded));
+    case type::TypeId::BIGINT:
+      return type::ValueFactory::GetBigIntValue(encoded);
+    case type::TypeId::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(encoded);
+    case type::TypeId::DATE:
+      return type::ValueFactory::GetDateValue(static_cast<uint32_t>(encoded));
+    case type::TypeId::DECIMAL: {
+      if (encoded < 0) {
+        encoded ^= std::numeric_limits<int64_t>::max();
+      }
+      double decimal;
+      PELOTON_MEMCPY(&decimal, &encoded, sizeof(decimal));
+      return type::ValueFactory::GetDecimalValue(decimal);
+    }
+    default:
+      PELOTON_ASSERT(false);
+      return type::Value();
+  }
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -19,6 +19,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/storage_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "type/ephemeral_pool.h"
 
 namespace peloton {
@@ -64,7 +65,10 @@ void ZoneMapManager::CreateZoneMapsForTable(
   for (size_t i = 0; i < num_tile_groups; i++) {
     auto tile_group = table->GetTileGroup(i);
     auto tile_group_ptr = tile_group.get();
-    PELOTON_ASSERT(tile_group_ptr != nullptr);
+    // the tile group has been dropped after compaction
+    if (tile_group_ptr == nullptr) {
+      continue;
+    }
     auto tile_group_header = tile_group_ptr->GetHeader();
     PELOTON_ASSERT(tile_group_header != nullptr);
     bool immutable = tile_group_header->GetImmutability();
@@ -218,8 +222,9 @@ ZoneMapManager::GetResultVectorAsZoneMap(
 }
 
 /**
- * The function compares the predicate against the zone map for the column
- * present in catalog.
+ * The function compares the predicate against the in-memory zone map of the
+ * tile group. The zone map is maintained on every write to the tile group, so
+ * it does not have to be created in the catalog first.
  *
  * @param parsed predicates array
  * @param num_predicates
@@ -231,51 +236,11 @@ ZoneMapManager::GetResultVectorAsZoneMap(
 bool ZoneMapManager::ShouldScanTileGroup(
     storage::PredicateInfo *parsed_predicates, int32_t num_predicates,
     storage::DataTable *table, int64_t tile_group_idx) {
-  for (int32_t i = 0; i < num_predicates; i++) {
-    // Extract the col_id, operator and predicate_value
-    int col_id = parsed_predicates[i].col_id;
-    int comparison_operator = parsed_predicates[i].comparison_operator;
-    type::Value predicate_value = parsed_predicates[i].predicate_value;
-
-    oid_t database_id = table->GetDatabaseOid();
-    oid_t table_id = table->GetOid();
-
-    std::unique_ptr<ZoneMapManager::ColumnStatistics> stats =
-        GetZoneMapFromCatalog(database_id, table_id, tile_group_idx, col_id);
-
-    if (stats == nullptr) {
-      return true;
-    }
-    switch (comparison_operator) {
-      case (int)ExpressionType::COMPARE_EQUAL:
-        if (!CheckEqual(predicate_value, stats.get())) {
-          return false;
-        }
-        break;
-      case (int)ExpressionType::COMPARE_LESSTHAN:
-        if (!CheckLessThan(predicate_value, stats.get())) {
-          return false;
-        }
-        break;
-      case (int)ExpressionType::COMPARE_LESSTHANOREQUALTO:
-        if (!CheckLessThanEquals(predicate_value, stats.get())) {
-          return false;
-        }
-        break;
-      case (int)ExpressionType::COMPARE_GREATERTHAN:
-        if (!CheckGreaterThan(predicate_value, stats.get())) {
-          return false;
-        }
-        break;
-      case (int)ExpressionType::COMPARE_GREATERTHANOREQUALTO:
-        if (!CheckGreaterThanEquals(predicate_value, stats.get())) {
-          return false;
-        }
-        break;
-      default: { throw Exception{"Invalid expression type for translation "}; }
-    }
+  auto tile_group = table->GetTileGroup(tile_group_idx);
+  if (tile_group == nullptr) {
+    return true;
   }
-  return true;
+  return tile_group->ShouldScan(parsed_predicates, num_predicates);
 }
 
 /**
@@ -19,23 +19,54 @@
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/expression_util.h"
+#include "logging/log_manager_factory.h"
 #include "optimizer/optimizer.h"
+#include "parser/transaction_statement.h"
+#include "parser/variable_set_statement.h"
 #include "planner/plan_util.h"
 #include "settings/settings_manager.h"
 #include "threadpool/mono_queue_pool.h"
+#include "util/string_util.h"
 
 namespace peloton {
 namespace tcop {
 
+// Whether a statement may modify the database, so that a read-only
+// transaction can not execute it
+static bool IsWriteQuery(QueryType query_type) {
+  switch (query_type) {
+    case QueryType::QUERY_BEGIN:
+    case QueryType::QUERY_COMMIT:
+    case QueryType::QUERY_ROLLBACK:
+    case QueryType::QUERY_PREPARE:
+    case QueryType::QUERY_EXECUTE:
+    case QueryType::QUERY_SET:
+    case QueryType::QUERY_SHOW:
+    case QueryType::QUERY_SELECT:
+    case QueryType::QUERY_EXPLAIN:
+      return false;
+    default:
+      return true;
+  }
+}
+
 TrafficCop::TrafficCop()
     : is_queuing_(false),
       rows_affected_(0),
       optimizer_(new optimizer::Optimizer()),
-      single_statement_txn_(true) {}
+      single_statement_txn_(true),
+      synchronous_commit_(settings::SettingsManager::GetBool(
+          settings::SettingId::synchronous_commit)),
+      default_transaction_read_only_(settings::SettingsManager::GetBool(
+          settings::SettingId::default_transaction_read_only)) {}
 
 TrafficCop::TrafficCop(void (*task_callback)(void *), void *task_callback_arg)
     : optimizer_(new optimizer::Optimizer()),
       single_statement_txn_(true),
+      synchronous_commit_(settings::SettingsManager::GetBool(
+          settings::SettingId::synchronous_commit)),
+      default_transaction_read_only_(settings::SettingsManager::GetBool(
+          settings::SettingId::default_transaction_read_only)),
       task_callback_(task_callback),
       task_callback_arg_(task_callback_arg) {}
 
@@ -47,6 +78,10 @@ void TrafficCop::Reset() {
   results_.clear();
   param_values_.clear();
   setRowsAffected(0);
+  synchronous_commit_ =
+      settings::SettingsManager::GetBool(settings::SettingId::synchronous_commit);
+  default_transaction_read_only_ = settings::SettingsManager::GetBool(
+      settings::SettingId::default_transaction_read_only);
 }
 
 TrafficCop::~TrafficCop() {
@@ -78,10 +113,33 @@ TrafficCop::TcopTxnState &TrafficCop::GetCurrentTxnState() {
   return tcop_txn_state_.top();
 }
 
-ResultType TrafficCop::BeginQueryHelper(size_t thread_id) {
+concurrency::TransactionContext *TrafficCop::BeginTransaction(
+    size_t thread_id, bool read_only) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  return txn_manager.BeginTransaction(
+      thread_id, concurrency::TransactionManagerFactory::GetIsolationLevel(),
+      read_only);
+}
+
+bool TrafficCop::IsReadOnlyBegin(Statement &statement) const {
+  if (statement.GetQueryType() != QueryType::QUERY_BEGIN) {
+    return default_transaction_read_only_;
+  }
+  auto &begin_stmt = static_cast<const parser::TransactionStatement &>(
+      *statement.GetStmtParseTreeList()->GetStatement(0));
+  switch (begin_stmt.access_mode) {
+    case parser::TransactionStatement::kReadOnly:
+      return true;
+    case parser::TransactionStatement::kReadWrite:
+      return false;
+    default:
+      return default_transaction_read_only_;
+  }
+}
+
+ResultType TrafficCop::BeginQueryHelper(size_t thread_id, bool read_only) {
   if (tcop_txn_state_.empty()) {
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    auto txn = txn_manager.BeginTransaction(thread_id);
+    auto txn = BeginTransaction(thread_id, read_only);
     // this shouldn't happen
     if (txn == nullptr) {
       LOG_DEBUG("Begin txn failed");
@@ -106,6 +164,7 @@ ResultType TrafficCop::CommitQueryHelper() {
   // 'ROLLBACK' After receive 'COMMIT', see if it is rollback or really commit.
   if (curr_state.second != ResultType::ABORTED) {
     // txn committed
+    txn->SetSynchronousCommit(synchronous_commit_);
     return txn_manager.CommitTransaction(txn);
   } else {
     // otherwise, rollback
@@ -113,6 +172,38 @@ ResultType TrafficCop::CommitQueryHelper() {
   }
 }
 
+ResultType TrafficCop::ExecuteVariableSet(
+    const parser::VariableSetStatement &set_stmt) {
+  bool *session_value;
+  settings::SettingId setting_id;
+  if (set_stmt.name == "synchronous_commit") {
+    session_value = &synchronous_commit_;
+    setting_id = settings::SettingId::synchronous_commit;
+  } else if (set_stmt.name == "default_transaction_read_only") {
+    session_value = &default_transaction_read_only_;
+    setting_id = settings::SettingId::default_transaction_read_only;
+  } else {
+    LOG_TRACE("Skip setting %s", set_stmt.name.c_str());
+    return ResultType::SUCCESS;
+  }
+
+  // SET ... TO DEFAULT and RESET fall back to the server setting.
+  auto value = StringUtil::Lower(set_stmt.value);
+  if (value.empty()) {
+    *session_value = settings::SettingsManager::GetBool(setting_id);
+  } else if (value == "on" || value == "true" || value == "1" ||
+             (value == "local" && set_stmt.name == "synchronous_commit")) {
+    *session_value = true;
+  } else if (value == "off" || value == "false" || value == "0") {
+    *session_value = false;
+  } else {
+    error_message_ = "invalid value for parameter \"" + set_stmt.name +
+                     "\": \"" + set_stmt.value + "\"";
+    return ResultType::FAILURE;
+  }
+  return ResultType::SUCCESS;
+}
+
 ResultType TrafficCop::AbortQueryHelper() {
   // do nothing if we have no active txns
   if (tcop_txn_state_.empty()) return ResultType::NOOP;
@@ -131,6 +222,36 @@ ResultType TrafficCop::AbortQueryHelper() {
   }
 }
 
+void TrafficCop::RecordCommand(const std::shared_ptr<Statement> &statement,
+                               const std::vector<type::Value> &params) {
+  auto &log_manager = logging::LogManagerFactory::GetInstance();
+  if (log_manager.GetLoggingMode() != LoggingModeType::COMMAND ||
+      tcop_txn_state_.empty()) {
+    return;
+  }
+
+  auto txn = tcop_txn_state_.top().first;
+  switch (statement->GetQueryType()) {
+    case QueryType::QUERY_SELECT:
+      // reads are not replayed.
+      break;
+    case QueryType::QUERY_INSERT:
+    case QueryType::QUERY_UPDATE:
+    case QueryType::QUERY_DELETE:
+      // statements without parameters are mostly ad-hoc queries. their
+      // writes are logged tuple by tuple.
+      if (params.empty() == false) {
+        txn->RecordCommand(statement, default_database_name_, params);
+        break;
+      }
+      txn->InvalidateCommands();
+      break;
+    default:
+      txn->InvalidateCommands();
+      break;
+  }
+}
+
 ResultType TrafficCop::ExecuteStatementGetResult() {
   LOG_TRACE("Statement executed. Result: %s",
             ResultTypeToString(p_status_.m_result).c_str());
@@ -160,11 +281,10 @@ executor::ExecutionResult TrafficCop::ExecuteHelper(
     txn = curr_state.first;
   } else {
     // No active txn, single-statement txn
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     // new txn, reset result status
     curr_state.second = ResultType::SUCCESS;
     single_statement_txn_ = true;
-    txn = txn_manager.BeginTransaction(thread_id);
+    txn = BeginTransaction(thread_id, default_transaction_read_only_);
     tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
   }
 
@@ -271,7 +391,6 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   // We can learn transaction's states, BEGIN, COMMIT, ABORT, or ROLLBACK from
   // member variables, tcop_txn_state_. We can also get single-statement txn or
   // multi-statement txn from member variable single_statement_txn_
-  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   // --multi-statements except BEGIN in a transaction
   if (!tcop_txn_state_.empty()) {
     single_statement_txn_ = false;
@@ -296,7 +415,7 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
       LOG_TRACE("SINGLE TXN");
       single_statement_txn_ = true;
     }
-    auto txn = txn_manager.BeginTransaction(thread_id);
+    auto txn = BeginTransaction(thread_id, IsReadOnlyBegin(*statement));
     // this shouldn't happen
     if (txn == nullptr) {
       LOG_TRACE("Begin txn failed");
@@ -371,8 +490,7 @@ bool TrafficCop::BindParamsForCachePlan(
     const size_t thread_id UNUSED_ATTRIBUTE) {
   if (tcop_txn_state_.empty()) {
     single_statement_txn_ = true;
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    auto txn = txn_manager.BeginTransaction(thread_id);
+    auto txn = BeginTransaction(thread_id, default_transaction_read_only_);
     // this shouldn't happen
     if (txn == nullptr) {
       LOG_ERROR("Begin txn failed");
@@ -577,7 +695,7 @@ ResultType TrafficCop::ExecuteStatement(
   try {
     switch (statement->GetQueryType()) {
       case QueryType::QUERY_BEGIN: {
-        return BeginQueryHelper(thread_id);
+        return BeginQueryHelper(thread_id, IsReadOnlyBegin(*statement));
       }
       case QueryType::QUERY_COMMIT: {
         return CommitQueryHelper();
@@ -586,6 +704,21 @@ ResultType TrafficCop::ExecuteStatement(
         return AbortQueryHelper();
       }
       default:
+        // A read-only transaction has no commit id to install versions with.
+        // Without an open transaction, the statement runs in a transaction
+        // of its own, which is read-only if the session default is.
+        if (IsWriteQuery(statement->GetQueryType()) &&
+            (tcop_txn_state_.empty()
+                 ? default_transaction_read_only_
+                 : tcop_txn_state_.top().first->IsReadOnly())) {
+          error_message_ = "cannot execute " + statement->GetQueryTypeString() +
+                           " in a read-only transaction";
+          if (!tcop_txn_state_.empty()) {
+            ProcessInvalidStatement();
+          }
+          return ResultType::FAILURE;
+        }
+
         // The statement may be out of date
         // It needs to be replan
         if (statement->GetNeedsReplan()) {
@@ -603,6 +736,7 @@ ResultType TrafficCop::ExecuteStatement(
 
         ExecuteHelper(statement->GetPlanTree(), params, result, result_format,
                       thread_id);
+        RecordCommand(statement, params);
         if (GetQueuing()) {
           return ResultType::QUEUING;
         } else {
@@ -108,6 +108,11 @@ void IndexTuner::BuildIndex(storage::DataTable *table,
         new storage::Tuple(table_schema, true));
 
     auto tile_group = table->GetTileGroup(index_tile_group_offset);
+    // the tile group has been dropped after compaction
+    if (tile_group == nullptr) {
+      index_tile_group_offset++;
+      continue;
+    }
     auto tile_group_id = tile_group->GetTileGroupId();
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
@@ -20,8 +20,12 @@
 #include "catalog/schema.h"
 #include "common/logger.h"
 #include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "settings/settings_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace tuning {
@@ -131,26 +135,110 @@ bool LayoutTuner::UpdateDefaultPartition(storage::DataTable *table) {
   return true;
 }
 
+oid_t LayoutTuner::MigrateTileGroups(storage::DataTable *table) {
+  auto tile_group_count = table->GetTileGroupCount();
+  if (tile_group_count == 0) {
+    return 0;
+  }
+
+  // Sweep over the table, so that every cold tile group is eventually
+  // transformed. Tile groups that are not cold are skipped, and visited
+  // again in the next sweep.
+  // Tile groups whose versions were all committed before this epoch are
+  // frozen, if they are not transformed.
+  eid_t cold_epoch_id = 0;
+  auto freeze_interval = settings::SettingsManager::GetInt(
+      settings::SettingId::tile_group_freeze_interval);
+  if (freeze_interval > 0) {
+    auto current_epoch_id = concurrency::EpochManagerFactory::GetInstance()
+                                .GetCurrentEpochId();
+    eid_t freeze_epoch_count =
+        static_cast<eid_t>(freeze_interval) * 1000 / EPOCH_LENGTH;
+    if (current_epoch_id > freeze_epoch_count) {
+      cold_epoch_id = current_epoch_id - freeze_epoch_count;
+    }
+  }
+
+  auto &tile_group_offset = migration_offsets[table];
+  oid_t migrated_count = 0;
+  for (oid_t visit_itr = 0; visit_itr < migration_tile_group_count;
+       visit_itr++) {
+    if (tile_group_offset >= tile_group_count) {
+      tile_group_offset = 0;
+    }
+
+    LOG_TRACE("Transforming tile group at offset: %u", tile_group_offset);
+    if (table->TransformTileGroup(tile_group_offset, theta) != nullptr) {
+      migrated_count++;
+    } else if (cold_epoch_id != 0 &&
+               table->FreezeTileGroup(tile_group_offset, cold_epoch_id) !=
+                   nullptr) {
+      migrated_count++;
+    }
+    tile_group_offset++;
+  }
+
+  // Frozen tile groups, and the ones that scans have read back in, are
+  // evicted while the tile data takes more memory than the budget. The data
+  // of the replaced tile groups is freed once their epoch expires, so it is
+  // counted as evicted right away.
+  size_t memory_budget =
+      static_cast<size_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::tile_group_memory_budget)) *
+      1024 * 1024;
+  if (memory_budget == 0) {
+    return migrated_count;
+  }
+
+  auto &eviction_offset = eviction_offsets[table];
+  size_t evicted_size = 0;
+  for (oid_t visit_itr = 0;
+       visit_itr < tile_group_count &&
+       storage::Tile::GetResidentDataSize() > memory_budget + evicted_size;
+       visit_itr++) {
+    if (eviction_offset >= tile_group_count) {
+      eviction_offset = 0;
+    }
+
+    auto tile_group = table->GetTileGroup(eviction_offset);
+    if (tile_group != nullptr &&
+        table->EvictTileGroup(eviction_offset) != nullptr) {
+      evicted_size += tile_group->GetResidentSize();
+      migrated_count++;
+    }
+    eviction_offset++;
+  }
+
+  return migrated_count;
+}
+
 void LayoutTuner::Tune() {
   Timer<std::milli> timer;
   // Continue till signal is not false
   while (layout_tuning_stop == false) {
-    // Go over all tables
-    for (auto table : tables) {
-      // Transform
-      auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
-
-      LOG_TRACE("Transforming tile group at offset: %lu", tile_group_offset);
-      table->TransformTileGroup(tile_group_offset, theta);
-
-      // Update partitioning periodically
-      // TODO Lin/Tianyu - Add Failure Handling/Retry logic.
-      UNUSED_ATTRIBUTE bool update_result = UpdateDefaultPartition(table);
+    // Go over all tables. A table is not removed while it is being tuned.
+    for (size_t table_itr = 0;; table_itr++) {
+      {
+        std::lock_guard<std::mutex> lock(layout_tuner_mutex);
+        if (table_itr >= tables.size()) {
+          break;
+        }
+        auto table = tables[table_itr];
+
+        // Transform
+        MigrateTileGroups(table);
+
+        // Update partitioning periodically
+        // TODO Lin/Tianyu - Add Failure Handling/Retry logic.
+        UNUSED_ATTRIBUTE bool update_result = UpdateDefaultPartition(table);
+      }
 
       // Sleep a bit
       std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
     }
+
+    // Sleep a bit when there is no table to tune
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
   }
 }
 
@@ -173,10 +261,24 @@ void LayoutTuner::AddTable(storage::DataTable* table) {
   }
 }
 
+void LayoutTuner::RemoveTable(storage::DataTable* table) {
+  {
+    std::lock_guard<std::mutex> lock(layout_tuner_mutex);
+    LOG_TRACE("Layout tuner removing table : %p", table);
+
+    tables.erase(std::remove(tables.begin(), tables.end(), table),
+                 tables.end());
+    migration_offsets.erase(table);
+    eviction_offsets.erase(table);
+  }
+}
+
 void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    migration_offsets.clear();
+    eviction_offsets.clear();
   }
 }
 
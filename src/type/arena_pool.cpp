@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_pool.cpp
+//
+// Identification: src/type/arena_pool.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/arena_pool.h"
+
+#include <new>
+
+namespace peloton {
+namespace type {
+
+const size_t ArenaPool::block_size_;
+const size_t ArenaPool::max_chunk_size_;
+const size_t ArenaPool::chunk_alignment_;
+const size_t ArenaPool::block_header_size_;
+
+ArenaPool::~ArenaPool() {
+  blocks_lock_.Lock();
+  for (auto block : blocks_) {
+    free(block);
+  }
+  blocks_.clear();
+  blocks_lock_.Unlock();
+}
+
+void *ArenaPool::Allocate(size_t size) {
+  size_t chunk_size = (size + chunk_alignment_ - 1) & ~(chunk_alignment_ - 1);
+
+  // a large chunk is the only chunk of its block, so the block is released
+  // as soon as the chunk is freed.
+  if (chunk_size > max_chunk_size_) {
+    blocks_lock_.Lock();
+    Block *block = NewBlock(block_header_size_ + chunk_size, 1);
+    blocks_lock_.Unlock();
+    return reinterpret_cast<char *>(block) + block_header_size_;
+  }
+
+  while (true) {
+    Block *block = current_block_.load(std::memory_order_acquire);
+    if (block != nullptr) {
+      // the chunk is counted before it is carved out, so that the block
+      // cannot be released by a concurrent thread that finds it full.
+      block->live_count.fetch_add(1, std::memory_order_relaxed);
+      size_t offset =
+          block->next_offset.fetch_add(chunk_size, std::memory_order_relaxed);
+      if (offset + chunk_size <= block_size_) {
+        return reinterpret_cast<char *>(block) + offset;
+      }
+    }
+
+    // the current block is full. the first thread that gets here installs
+    // a new block, and the others retry on it.
+    blocks_lock_.Lock();
+    if (current_block_.load(std::memory_order_relaxed) == block) {
+      Block *new_block = NewBlock(block_size_, 1);
+      current_block_.store(new_block, std::memory_order_release);
+      blocks_lock_.Unlock();
+
+      // the full block is released once all of its chunks are freed.
+      if (block != nullptr) {
+        ReleaseBlock(block);
+      }
+    } else {
+      blocks_lock_.Unlock();
+    }
+
+    // drop the count of the chunk that did not fit. it is only dropped now,
+    // so the block cannot have been released and reallocated at the same
+    // address before it is compared with the current block.
+    if (block != nullptr) {
+      ReleaseBlock(block);
+    }
+  }
+}
+
+void ArenaPool::Free(void *ptr) {
+  auto block = reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(ptr) &
+                                         ~(block_size_ - 1));
+  ReleaseBlock(block);
+}
+
+size_t ArenaPool::GetBlockCount() {
+  blocks_lock_.Lock();
+  size_t block_count = blocks_.size();
+  blocks_lock_.Unlock();
+  return block_count;
+}
+
+// must be called with the blocks latch held.
+ArenaPool::Block *ArenaPool::NewBlock(size_t size, size_t live_count) {
+  size = (size + block_size_ - 1) & ~(block_size_ - 1);
+  void *memory = nullptr;
+  if (posix_memalign(&memory, block_size_, size) != 0) {
+    throw std::bad_alloc();
+  }
+
+  Block *block = new (memory) Block();
+  block->next_offset.store(block_header_size_, std::memory_order_relaxed);
+  block->live_count.store(live_count, std::memory_order_relaxed);
+  blocks_.insert(block);
+  return block;
+}
+
+void ArenaPool::ReleaseBlock(Block *block) {
+  if (block->live_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  blocks_lock_.Lock();
+  blocks_.erase(block);
+  blocks_lock_.Unlock();
+  free(block);
+}
+
+}  // namespace type
+}  // namespace peloton
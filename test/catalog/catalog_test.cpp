@@ -226,6 +226,7 @@ TEST_F(CatalogTests, TableObject) {
   EXPECT_TRUE(column_objects[0]->IsInlined());
   EXPECT_FALSE(column_objects[0]->IsNotNull());
   EXPECT_FALSE(column_objects[0]->HasDefault());
+  EXPECT_FALSE(column_objects[0]->IsDictionaryEncoded());
 
   EXPECT_EQ(table_object->GetTableOid(), column_objects[1]->GetTableOid());
   EXPECT_EQ("name", column_objects[1]->GetColumnName());
@@ -236,6 +237,7 @@ TEST_F(CatalogTests, TableObject) {
   EXPECT_TRUE(column_objects[1]->IsInlined());
   EXPECT_FALSE(column_objects[1]->IsNotNull());
   EXPECT_FALSE(column_objects[1]->HasDefault());
+  EXPECT_FALSE(column_objects[1]->IsDictionaryEncoded());
 
   // update pg_table SET version_oid = 1 where table_name = department_table
   oid_t department_table_oid = table_object->GetTableOid();
@@ -256,6 +258,43 @@ TEST_F(CatalogTests, TableObject) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CatalogTests, DictionaryEncodedColumn) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto id_column = catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "id", true);
+  auto name_column = catalog::Column(type::TypeId::VARCHAR, 32, "name", false);
+  name_column.SetDictionaryEncoded();
+
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column, name_column}));
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateTable(txn,
+                       "emp_db",
+                       DEFAULT_SCHEMA_NAME,
+                       std::move(table_schema),
+                       "dictionary_table",
+                       false);
+  txn_manager.CommitTransaction(txn);
+
+  // The encoding is read back from pg_attribute rather than from the cache
+  txn = txn_manager.BeginTransaction();
+  auto table_object = catalog->GetTableCatalogEntry(txn,
+                                                    "emp_db",
+                                                    DEFAULT_SCHEMA_NAME,
+                                                    "dictionary_table");
+  auto column_objects = table_object->GetColumnCatalogEntries();
+  EXPECT_FALSE(column_objects[0]->IsDictionaryEncoded());
+  EXPECT_TRUE(column_objects[1]->IsDictionaryEncoded());
+
+  catalog->DropTable(txn,
+                     "emp_db",
+                     DEFAULT_SCHEMA_NAME,
+                     "dictionary_table");
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(CatalogTests, TestingNamespace) {
   EXPECT_EQ(ResultType::SUCCESS, TestingSQLUtil::ExecuteSQLQuery("begin;"));
   // create namespaces emp_ns0 and emp_ns1
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+
 #include "catalog/catalog.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/query_compiler.h"
@@ -95,6 +97,69 @@ TEST_F(GroupByTranslatorTest, SingleColumnGrouping) {
   }
 }
 
+TEST_F(GroupByTranslatorTest, DictionaryEncodedGrouping) {
+  //
+  // SELECT d, count(*) FROM dictionary_table GROUP BY d;
+  //
+
+  uint32_t num_rows = 100;
+  uint32_t num_strings = 4;
+  auto *table = CreateAndLoadDictionaryTable(num_rows, num_strings);
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  auto *tve_expr =
+      new expression::TupleValueExpression(type::TypeId::VARCHAR, 0, 0);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr}};
+
+  // 3) The grouping column, which is hashed on its codes
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::VARCHAR, 32, "COL_D"},
+                           {type::TypeId::BIGINT, 8, "COUNT_D"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{
+      new planner::SeqScanPlan(table, nullptr, {3})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // Compile and run
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Check results, the groups are decoded back into their strings
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(num_strings, results.size());
+
+  std::set<std::string> groups;
+  type::Value const_count =
+      type::ValueFactory::GetBigIntValue(num_rows / num_strings);
+  for (const auto &tuple : results) {
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(1).CompareEquals(const_count));
+    groups.insert(tuple.GetValue(0).ToString());
+  }
+  EXPECT_EQ((std::set<std::string>{"str0", "str1", "str2", "str3"}), groups);
+}
+
 TEST_F(GroupByTranslatorTest, MultiColumnGrouping) {
   //
   // SELECT a, b, count(*) FROM table GROUP BY a, b;
@@ -16,10 +16,13 @@
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
 #include "expression/operator_expression.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/storage_manager.h"
+#include "storage/string_dictionary.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group.h"
 
 #include "codegen/testing_codegen_util.h"
 
@@ -664,6 +667,128 @@ TEST_F(TableScanTranslatorTest, ScanColumnLayout) {
   ScanLayoutTable(tuples_per_tilegroup, tilegroup_count, column_count);
 }
 
+TEST_F(TableScanTranslatorTest, ScanFrozenLayout) {
+  //
+  // Creates a table with LayoutType::ROW, freezes its tile groups and
+  // invokes the TableScanTranslator on the compressed columns
+  //
+  uint32_t tuples_per_tilegroup = 100;
+  uint32_t tilegroup_count = 5;
+  uint32_t column_count = 10;
+  bool is_inlined = true;
+  CreateAndLoadTableWithLayout(LayoutType::ROW, tuples_per_tilegroup,
+                               tilegroup_count, column_count, is_inlined);
+
+  auto table = GetLayoutTable();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tilegroup_count;
+       tile_group_offset++) {
+    EXPECT_NE(nullptr, table->FreezeTileGroup(
+                           tile_group_offset,
+                           std::numeric_limits<eid_t>::max()));
+  }
+
+  ScanLayoutTable(tuples_per_tilegroup, tilegroup_count, column_count);
+
+  // The scan decoded the compressed columns without thawing their tiles
+  for (oid_t tile_group_offset = 0; tile_group_offset < tilegroup_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    EXPECT_TRUE(tile_group->IsFrozen());
+    for (oid_t col_id = 0; col_id < column_count; col_id++) {
+      EXPECT_NE(nullptr, tile_group->GetCompressedColumn(col_id));
+    }
+  }
+}
+
+TEST_F(TableScanTranslatorTest, ScanDictionaryEncodedColumn) {
+  //
+  // SELECT a, d FROM dictionary_table WHERE d = 'str1';
+  //
+  uint32_t num_rows = 100;
+  uint32_t num_strings = 4;
+  auto *table = CreateAndLoadDictionaryTable(num_rows, num_strings);
+
+  // Every row points to one of the strings in the dictionary
+  auto *dictionary = table->GetSchema()->GetDictionary(3);
+  ASSERT_NE(nullptr, dictionary);
+  EXPECT_EQ(num_strings, dictionary->GetStringCount());
+
+  auto str_expr = [](const std::string &str) {
+    return ExpressionPtr{new expression::ConstantValueExpression(
+        type::ValueFactory::GetVarcharValue(str))};
+  };
+
+  // The equality is evaluated on the codes
+  {
+    ExpressionPtr d_eq_str1 =
+        CmpEqExpr(ColRefExpr(type::TypeId::VARCHAR, 3), str_expr("str1"));
+    planner::SeqScanPlan scan{table, d_eq_str1.release(), {0, 3}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer);
+
+    const auto &results = buffer.GetOutputTuples();
+    EXPECT_EQ(num_rows / num_strings, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(1).CompareEquals(
+                    type::ValueFactory::GetVarcharValue("str1")));
+    }
+  }
+
+  // A string that is not in the dictionary matches no row
+  {
+    ExpressionPtr d_eq_missing =
+        CmpEqExpr(ColRefExpr(type::TypeId::VARCHAR, 3), str_expr("missing"));
+    planner::SeqScanPlan scan{table, d_eq_missing.release(), {0, 3}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer);
+
+    EXPECT_EQ(0, buffer.GetOutputTuples().size());
+    EXPECT_EQ(num_strings, dictionary->GetStringCount());
+  }
+
+  // d IN ('str0', 'str2'), as a disjunction of equalities
+  {
+    ExpressionPtr d_eq_str0 =
+        CmpEqExpr(ColRefExpr(type::TypeId::VARCHAR, 3), str_expr("str0"));
+    ExpressionPtr d_eq_str2 =
+        CmpEqExpr(ColRefExpr(type::TypeId::VARCHAR, 3), str_expr("str2"));
+    ExpressionPtr d_in = ExpressionPtr{new expression::ConjunctionExpression(
+        ExpressionType::CONJUNCTION_OR, d_eq_str0.release(),
+        d_eq_str2.release())};
+    planner::SeqScanPlan scan{table, d_in.release(), {0, 3}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer);
+
+    EXPECT_EQ(2 * num_rows / num_strings, buffer.GetOutputTuples().size());
+  }
+
+  // The inequality is evaluated on the codes too
+  {
+    ExpressionPtr d_ne_str1 =
+        CmpExpr(ExpressionType::COMPARE_NOTEQUAL,
+                ColRefExpr(type::TypeId::VARCHAR, 3), str_expr("str1"));
+    planner::SeqScanPlan scan{table, d_ne_str1.release(), {0, 3}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer);
+
+    EXPECT_EQ(num_rows - num_rows / num_strings,
+              buffer.GetOutputTuples().size());
+  }
+}
+
 TEST_F(TableScanTranslatorTest, MultiLayoutScan) {
   //
   // Creates a table with LayoutType::ROW
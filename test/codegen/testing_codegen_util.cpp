@@ -271,6 +271,55 @@ void PelotonCodeGenTest::CreateAndLoadTableWithLayout(
   txn_manager.CommitTransaction(txn);
 }
 
+storage::DataTable *PelotonCodeGenTest::CreateAndLoadDictionaryTable(
+    uint32_t num_rows, uint32_t num_strings) {
+  auto table_schema = CreateTestSchema();
+  std::vector<catalog::Column> columns = table_schema->GetColumns();
+  columns[3].SetDictionaryEncoded();
+  table_schema.reset(new catalog::Schema(columns));
+  std::string table_name("DICTIONARY_TABLE");
+
+  auto *catalog = catalog::Catalog::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateTable(txn,
+                       test_db_name,
+                       DEFAULT_SCHEMA_NAME,
+                       std::move(table_schema),
+                       table_name,
+                       false);
+  auto *dictionary_table = catalog->GetTableWithName(txn,
+                                                     test_db_name,
+                                                     DEFAULT_SCHEMA_NAME,
+                                                     table_name);
+  txn_manager.CommitTransaction(txn);
+
+  txn = txn_manager.BeginTransaction();
+  auto *table_schema_ptr = dictionary_table->GetSchema();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  const bool allocate = true;
+  for (uint32_t rowid = 0; rowid < num_rows; rowid++) {
+    storage::Tuple tuple{table_schema_ptr, allocate};
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(10 * rowid));
+    tuple.SetValue(1, type::ValueFactory::GetIntegerValue(10 * rowid + 1));
+    tuple.SetValue(2, type::ValueFactory::GetDecimalValue(10 * rowid + 2));
+    tuple.SetValue(3,
+                   type::ValueFactory::GetVarcharValue(
+                       "str" + std::to_string(rowid % num_strings)),
+                   testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    ItemPointer tuple_slot_id =
+        dictionary_table->InsertTuple(&tuple, txn, &index_entry_ptr);
+    PELOTON_ASSERT(tuple_slot_id.block != INVALID_OID);
+    PELOTON_ASSERT(tuple_slot_id.offset != INVALID_OID);
+    txn_manager.PerformInsert(txn, tuple_slot_id, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  return dictionary_table;
+}
+
 PelotonCodeGenTest::CodeGenStats PelotonCodeGenTest::CompileAndExecute(
     planner::AbstractPlan &plan, codegen::ExecutionConsumer &consumer) {
   codegen::QueryParameters parameters(plan, {});
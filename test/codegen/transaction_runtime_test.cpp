@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_runtime_test.cpp
+//
+// Identification: test/codegen/transaction_runtime_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "codegen/transaction_runtime.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+class TransactionRuntimeTest : public PelotonTest {};
+
+TEST_F(TransactionRuntimeTest, BatchedVisibilityCheck) {
+  // An odd number of tuples, so that the last ones do not fill a batch
+  const int tuple_count = 23;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto tile_group = data_table->GetTileGroup(0);
+  auto header = tile_group->GetHeader();
+
+  txn = txn_manager.BeginTransaction();
+  auto other_txn = txn_manager.BeginTransaction();
+
+  // Mix versions that are owned by the reading transaction, owned by another
+  // transaction, invalidated, and not committed yet
+  EXPECT_TRUE(header->SetAtomicTransactionId(1, txn->GetTransactionId()));
+  EXPECT_TRUE(header->SetAtomicTransactionId(6, other_txn->GetTransactionId()));
+  header->SetEndCommitId(9, txn->GetReadId());
+  header->SetBeginCommitId(13, txn->GetReadId() + 1);
+  header->SetTransactionId(17, INVALID_TXN_ID);
+  header->SetEndCommitId(22, INVALID_CID);
+
+  for (uint32_t tid_start = 0; tid_start < 4; tid_start++) {
+    std::vector<uint32_t> selection_vector(tuple_count);
+    uint32_t visible_count = codegen::TransactionRuntime::PerformVisibilityCheck(
+        *txn, *tile_group, tid_start, tuple_count, selection_vector.data());
+
+    // The batches agree with the check of each tuple
+    std::vector<uint32_t> expected;
+    for (uint32_t tid = tid_start; tid < tuple_count; tid++) {
+      if (txn_manager.IsVisible(txn, header, tid) == VisibilityType::OK) {
+        expected.push_back(tid);
+      }
+    }
+    selection_vector.resize(visible_count);
+    EXPECT_EQ(expected, selection_vector);
+  }
+
+  header->SetTransactionId(1, INITIAL_TXN_ID);
+  header->SetTransactionId(6, INITIAL_TXN_ID);
+  txn_manager.CommitTransaction(other_txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
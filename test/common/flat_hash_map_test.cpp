@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// flat_hash_map_test.cpp
+//
+// Identification: test/common/flat_hash_map_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/container/flat_hash_map.h"
+
+#include "common/harness.h"
+#include "common/item_pointer.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// FlatHashMap Test
+//===--------------------------------------------------------------------===//
+
+class FlatHashMapTests : public PelotonTest {};
+
+typedef FlatHashMap<ItemPointer, oid_t, ItemPointerHasher,
+                    ItemPointerComparator, 16>
+    TestMap;
+
+TEST_F(FlatHashMapTests, BasicTest) {
+  TestMap map;
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(16, map.GetCapacity());
+  EXPECT_TRUE(map.find(ItemPointer(0, 0)) == map.end());
+
+  // A few entries stay in the inline slots
+  for (oid_t offset = 0; offset < 8; offset++) {
+    map[ItemPointer(1, offset)] = offset;
+  }
+  EXPECT_EQ(8, map.GetSize());
+  EXPECT_EQ(16, map.GetCapacity());
+
+  // Looking a key up again does not add it
+  map[ItemPointer(1, 3)] = 100;
+  EXPECT_EQ(8, map.GetSize());
+  EXPECT_EQ(100, map.find(ItemPointer(1, 3))->second);
+  EXPECT_TRUE(map.find(ItemPointer(3, 1)) == map.end());
+}
+
+TEST_F(FlatHashMapTests, GrowTest) {
+  const oid_t block_count = 10;
+  const oid_t offset_count = 100;
+  TestMap map;
+
+  for (oid_t block = 0; block < block_count; block++) {
+    for (oid_t offset = 0; offset < offset_count; offset++) {
+      map[ItemPointer(block, offset)] = block * offset_count + offset;
+    }
+  }
+  EXPECT_EQ(block_count * offset_count, map.GetSize());
+  EXPECT_LE(map.GetSize() * 2, map.GetCapacity());
+
+  for (oid_t block = 0; block < block_count; block++) {
+    for (oid_t offset = 0; offset < offset_count; offset++) {
+      auto entry = map.find(ItemPointer(block, offset));
+      ASSERT_TRUE(entry != map.end());
+      EXPECT_EQ(block * offset_count + offset, entry->second);
+    }
+  }
+
+  // Every entry is visited once
+  size_t entry_count = 0;
+  for (auto &entry : map) {
+    EXPECT_EQ(entry.first.block * offset_count + entry.first.offset,
+              entry.second);
+    entry_count++;
+  }
+  EXPECT_EQ(map.GetSize(), entry_count);
+
+  // Clearing keeps the heap slots, resetting gives them back
+  size_t capacity = map.GetCapacity();
+  map.Clear();
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(capacity, map.GetCapacity());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(ItemPointer(0, 0)) == map.end());
+
+  map[ItemPointer(0, 0)] = 1;
+  map.Reset();
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(16, map.GetCapacity());
+  EXPECT_TRUE(map.find(ItemPointer(0, 0)) == map.end());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -455,6 +455,32 @@ TEST_F(InternalTypesTests, LoggingTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(InternalTypesTests, LoggingModeTypeTest) {
+  std::vector<LoggingModeType> list = {LoggingModeType::INVALID,
+                                       LoggingModeType::TUPLE,
+                                       LoggingModeType::COMMAND};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::LoggingModeTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToLoggingModeType(str);
+    EXPECT_EQ(val, newVal);
+
+    std::ostringstream os;
+    os << val;
+    EXPECT_EQ(str, os.str());
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToLoggingModeType(invalid), peloton::Exception);
+  EXPECT_THROW(
+      peloton::LoggingModeTypeToString(static_cast<LoggingModeType>(-99999)),
+      peloton::Exception);
+}
+
 TEST_F(InternalTypesTests, CheckpointingTypeTest) {
   std::vector<CheckpointingType> list = {
       CheckpointingType::INVALID, CheckpointingType::OFF, CheckpointingType::ON
@@ -481,6 +507,33 @@ TEST_F(InternalTypesTests, CheckpointingTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(InternalTypesTests, CheckpointFormatTypeTest) {
+  std::vector<CheckpointFormatType> list = {CheckpointFormatType::INVALID,
+                                            CheckpointFormatType::ROW,
+                                            CheckpointFormatType::BINARY};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::CheckpointFormatTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToCheckpointFormatType(str);
+    EXPECT_EQ(val, newVal);
+
+    std::ostringstream os;
+    os << val;
+    EXPECT_EQ(str, os.str());
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToCheckpointFormatType(invalid),
+               peloton::Exception);
+  EXPECT_THROW(peloton::CheckpointFormatTypeToString(
+                   static_cast<CheckpointFormatType>(-99999)),
+               peloton::Exception);
+}
+
 TEST_F(InternalTypesTests, GarbageCollectionTypeTest) {
   std::vector<GarbageCollectionType> list = {
       GarbageCollectionType::INVALID, GarbageCollectionType::OFF, GarbageCollectionType::ON
@@ -511,7 +564,8 @@ TEST_F(InternalTypesTests, GarbageCollectionTypeTest) {
 TEST_F(InternalTypesTests, ProtocolTypeTest) {
   std::vector<ProtocolType> list = {
       ProtocolType::INVALID, 
-      ProtocolType::TIMESTAMP_ORDERING
+      ProtocolType::TIMESTAMP_ORDERING,
+      ProtocolType::OPTIMISTIC
   };
 
   // Make sure that ToString and FromString work
@@ -992,6 +1046,7 @@ TEST_F(InternalTypesTests, LogRecordTypeTest) {
       LogRecordType::TRANSACTION_COMMIT, LogRecordType::TUPLE_INSERT,
       LogRecordType::TUPLE_DELETE, LogRecordType::TUPLE_UPDATE,
       LogRecordType::EPOCH_BEGIN, LogRecordType::EPOCH_END,
+      LogRecordType::COMMAND,
   };
 
   // Make sure that ToString and FromString work
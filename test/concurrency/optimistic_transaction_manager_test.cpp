@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/testing_transaction_util.h"
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic TransactionContext Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {
+ protected:
+  void SetUp() override {
+    PelotonTest::SetUp();
+    concurrency::TransactionManagerFactory::Configure(
+        ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  }
+};
+
+TEST_F(OptimisticTransactionManagerTests, ReadWithoutTraceTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  EXPECT_EQ(ProtocolType::OPTIMISTIC,
+            concurrency::TransactionManagerFactory::GetProtocol());
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  auto tile_group = table->GetTileGroup(0);
+  auto header = tile_group->GetHeader();
+  ItemPointer location(tile_group->GetTileGroupId(), 0);
+  cid_t last_reader_cid = header->GetLastReaderCommitId(0);
+
+  // The read is only recorded in the read/write set of the transaction
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(txn_manager.PerformRead(txn, location, header, false));
+  EXPECT_EQ(last_reader_cid, header->GetLastReaderCommitId(0));
+  EXPECT_EQ(RWType::READ, txn->GetRWType(location));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+TEST_F(OptimisticTransactionManagerTests, ReadWriteConflictTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  TransactionScheduler scheduler(3, table, &txn_manager);
+
+  // T0 reads (0, 0)
+  // T1 updates (0, 0) to (0, 1) and commits, it does not wait for T0
+  // T0 fails its validation
+  scheduler.Txn(0).Read(0);
+  scheduler.Txn(1).Update(0, 1);
+  scheduler.Txn(1).Commit();
+  scheduler.Txn(0).Read(1);
+  scheduler.Txn(0).Commit();
+
+  // observer
+  scheduler.Txn(2).Read(0);
+  scheduler.Txn(2).Commit();
+
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::ABORTED);
+  EXPECT_TRUE(scheduler.schedules[1].txn_result == ResultType::SUCCESS);
+  EXPECT_TRUE(scheduler.schedules[2].txn_result == ResultType::SUCCESS);
+  EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  EXPECT_EQ(1, scheduler.schedules[2].results[0]);
+}
+
+TEST_F(OptimisticTransactionManagerTests, DisjointTransactionTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  TransactionScheduler scheduler(3, table, &txn_manager);
+
+  // T0 and T1 read and write disjoint tuples, both commit
+  scheduler.Txn(0).Read(0);
+  scheduler.Txn(1).Read(1);
+  scheduler.Txn(0).Update(2, 2);
+  scheduler.Txn(1).Update(3, 3);
+  scheduler.Txn(1).Commit();
+  scheduler.Txn(0).Commit();
+
+  // observer
+  scheduler.Txn(2).Read(2);
+  scheduler.Txn(2).Read(3);
+  scheduler.Txn(2).Commit();
+
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  EXPECT_TRUE(scheduler.schedules[1].txn_result == ResultType::SUCCESS);
+  EXPECT_TRUE(scheduler.schedules[2].txn_result == ResultType::SUCCESS);
+  EXPECT_EQ(2, scheduler.schedules[2].results[0]);
+  EXPECT_EQ(3, scheduler.schedules[2].results[1]);
+}
+
+TEST_F(OptimisticTransactionManagerTests, WriteWriteConflictTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  TransactionScheduler scheduler(3, table, &txn_manager);
+
+  // T1 can not lock the tuple locked by T0
+  scheduler.Txn(0).Update(0, 1);
+  scheduler.Txn(1).Update(0, 2);
+  scheduler.Txn(0).Commit();
+  scheduler.Txn(1).Commit();
+
+  // observer
+  scheduler.Txn(2).Read(0);
+  scheduler.Txn(2).Commit();
+
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  EXPECT_TRUE(scheduler.schedules[1].txn_result == ResultType::ABORTED);
+  EXPECT_EQ(1, scheduler.schedules[2].results[0]);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -399,6 +399,74 @@ bool TestingTransactionUtil::ExecuteUpdate(
   return update_executor.Execute();
 }
 
+// Run an update of the tuple with the given key
+bool ExecuteUpdatePlan(concurrency::TransactionContext *transaction,
+                       storage::DataTable *table, int id,
+                       TargetList &&target_list,
+                       DirectMapList &&direct_map_list,
+                       bool select_for_update) {
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(transaction));
+
+  // Update plan
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+  planner::UpdatePlan update_node(table, std::move(project_info));
+
+  executor::UpdateExecutor update_executor(&update_node, context.get());
+
+  // Index scan
+  std::vector<oid_t> column_ids = {0};
+  std::unique_ptr<planner::IndexScanPlan> idx_scan_node(
+      new planner::IndexScanPlan(table, nullptr, column_ids,
+                                 MakeIndexDesc(table, id), select_for_update));
+  executor::IndexScanExecutor idx_scan_executor(idx_scan_node.get(),
+                                                context.get());
+
+  update_node.AddChild(std::move(idx_scan_node));
+  update_executor.AddChild(&idx_scan_executor);
+
+  EXPECT_TRUE(update_executor.Init());
+  return update_executor.Execute();
+}
+
+bool TestingTransactionUtil::ExecuteUpdateAdd(
+    concurrency::TransactionContext *transaction, storage::DataTable *table,
+    int id, int increment, bool select_for_update) {
+  auto increment_val = type::ValueFactory::GetIntegerValue(increment);
+
+  // ProjectInfo
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  auto *expr = expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_PLUS, type::TypeId::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER, 0,
+                                                    1),
+      expression::ExpressionUtil::ConstantValueFactory(increment_val));
+  planner::DerivedAttribute attribute{expr};
+  target_list.emplace_back(1, attribute);
+  direct_map_list.emplace_back(0, std::pair<oid_t, oid_t>(0, 0));
+
+  return ExecuteUpdatePlan(transaction, table, id, std::move(target_list),
+                           std::move(direct_map_list), select_for_update);
+}
+
+bool TestingTransactionUtil::ExecuteTouch(
+    concurrency::TransactionContext *transaction, storage::DataTable *table,
+    int id, bool select_for_update) {
+  // ProjectInfo
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  direct_map_list.emplace_back(0, std::pair<oid_t, oid_t>(0, 0));
+  direct_map_list.emplace_back(1, std::pair<oid_t, oid_t>(0, 1));
+
+  return ExecuteUpdatePlan(transaction, table, id, std::move(target_list),
+                           std::move(direct_map_list), select_for_update);
+}
+
 bool TestingTransactionUtil::ExecuteUpdateByValue(
     concurrency::TransactionContext *txn, storage::DataTable *table,
     int old_value, int new_value, bool select_for_update) {
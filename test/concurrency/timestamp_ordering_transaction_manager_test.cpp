@@ -11,8 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <atomic>
+#include <thread>
+
 #include "concurrency/testing_transaction_util.h"
 #include "common/harness.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 
@@ -29,5 +33,106 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(TimestampOrderingTransactionManagerTests, ReadOnlyReadTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  auto tile_group = table->GetTileGroup(0);
+  auto header = tile_group->GetHeader();
+  ItemPointer location(tile_group->GetTileGroupId(), 0);
+  cid_t last_reader_cid = header->GetLastReaderCommitId(0);
+
+  // A read-only transaction reads its snapshot without leaving a trace
+  auto txn = txn_manager.BeginTransaction(
+      0, IsolationLevelType::SERIALIZABLE, true);
+  EXPECT_TRUE(txn->IsReadOnly());
+  EXPECT_TRUE(txn_manager.PerformRead(txn, location, header, false));
+  EXPECT_EQ(last_reader_cid, header->GetLastReaderCommitId(0));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // A serializable transaction records itself as the last reader
+  txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(txn->IsReadOnly());
+  EXPECT_TRUE(txn_manager.PerformRead(txn, location, header, false));
+  EXPECT_EQ(txn->GetCommitId(), header->GetLastReaderCommitId(0));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+TEST_F(TimestampOrderingTransactionManagerTests, WaitDieYoungerDiesTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE,
+      ConflictAvoidanceType::WAIT);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  auto header = table->GetTileGroup(0)->GetHeader();
+
+  auto older_txn = txn_manager.BeginTransaction();
+  auto younger_txn = txn_manager.BeginTransaction();
+  EXPECT_LT(older_txn->GetTransactionId(), younger_txn->GetTransactionId());
+
+  // A younger transaction does not wait for an older one
+  EXPECT_TRUE(txn_manager.IsOwnable(older_txn, header, 0));
+  EXPECT_TRUE(txn_manager.AcquireOwnership(older_txn, header, 0));
+  EXPECT_FALSE(txn_manager.IsOwnable(younger_txn, header, 0));
+  EXPECT_TRUE(txn_manager.IsOwner(older_txn, header, 0));
+
+  txn_manager.YieldOwnership(older_txn, header, 0);
+  txn_manager.AbortTransaction(younger_txn);
+  txn_manager.AbortTransaction(older_txn);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(TimestampOrderingTransactionManagerTests, WaitDieOlderWaitsTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE,
+      ConflictAvoidanceType::WAIT);
+  settings::SettingsManager::SetInt(settings::SettingId::conflict_wait_timeout,
+                                    10 * 1000 * 1000);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  auto header = table->GetTileGroup(0)->GetHeader();
+
+  auto older_txn = txn_manager.BeginTransaction();
+  auto younger_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(txn_manager.AcquireOwnership(younger_txn, header, 0));
+
+  // An older transaction waits for the younger one to release the tuple
+  std::atomic<bool> is_ownable(false);
+  std::thread older_thread([&] {
+    is_ownable = txn_manager.IsOwnable(older_txn, header, 0) &&
+                 txn_manager.AcquireOwnership(older_txn, header, 0);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(is_ownable);
+  txn_manager.YieldOwnership(younger_txn, header, 0);
+  older_thread.join();
+
+  EXPECT_TRUE(is_ownable);
+  EXPECT_TRUE(txn_manager.IsOwner(older_txn, header, 0));
+
+  txn_manager.YieldOwnership(older_txn, header, 0);
+  txn_manager.AbortTransaction(younger_txn);
+  txn_manager.AbortTransaction(older_txn);
+
+  // The wait is bounded
+  settings::SettingsManager::SetInt(settings::SettingId::conflict_wait_timeout,
+                                    1000);
+  older_txn = txn_manager.BeginTransaction();
+  younger_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(txn_manager.AcquireOwnership(younger_txn, header, 0));
+  EXPECT_FALSE(txn_manager.IsOwnable(older_txn, header, 0));
+
+  txn_manager.YieldOwnership(younger_txn, header, 0);
+  txn_manager.AbortTransaction(younger_txn);
+  txn_manager.AbortTransaction(older_txn);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_context_test.cpp
+//
+// Identification: test/concurrency/transaction_context_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "common/harness.h"
+#include "common/item_pointer.h"
+#include "concurrency/transaction_context.h"
+
+// The heap allocations of the calling thread, while they are counted
+static thread_local bool count_allocations = false;
+static thread_local size_t allocation_count = 0;
+
+void *operator new(size_t size) {
+  if (count_allocations) {
+    allocation_count++;
+  }
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// TransactionContext Tests
+//===--------------------------------------------------------------------===//
+
+class TransactionContextTests : public PelotonTest {};
+
+// The tuples touched by a short OLTP transaction
+static void RunShortTransaction(concurrency::TransactionContext *txn,
+                                const oid_t tuple_count) {
+  for (oid_t offset = 0; offset < tuple_count; offset++) {
+    txn->RecordReadOwn(ItemPointer(1, offset));
+    txn->RecordUpdate(ItemPointer(1, offset));
+    txn->RecordInsert(ItemPointer(2, offset));
+    txn->GetGCSet()[ItemPointer(1, offset)] = GCVersionType::COMMIT_UPDATE;
+  }
+  txn->RecordDelete(ItemPointer(2, 0));
+}
+
+TEST_F(TransactionContextTests, AllocationFreeSetsTest) {
+  const oid_t tuple_count = 10;
+
+  // The first transaction of the thread creates its context
+  auto txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 1);
+  RunShortTransaction(txn, tuple_count);
+  concurrency::TransactionContext::Release(txn);
+
+  count_allocations = true;
+  allocation_count = 0;
+  auto next_txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 2);
+  RunShortTransaction(next_txn, tuple_count);
+  EXPECT_EQ(RWType::UPDATE, next_txn->GetRWType(ItemPointer(1, 0)));
+  EXPECT_EQ(RWType::INS_DEL, next_txn->GetRWType(ItemPointer(2, 0)));
+  EXPECT_EQ(RWType::INSERT, next_txn->GetRWType(ItemPointer(2, 1)));
+  EXPECT_EQ(RWType::INVALID, next_txn->GetRWType(ItemPointer(3, 0)));
+  concurrency::TransactionContext::Release(next_txn);
+  count_allocations = false;
+
+  EXPECT_EQ(txn, next_txn);
+  EXPECT_EQ(0, allocation_count);
+}
+
+TEST_F(TransactionContextTests, ReuseGrownSetsTest) {
+  const oid_t tuple_count = 1000;
+
+  // A larger transaction moves its sets to the heap once
+  auto txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 1);
+  RunShortTransaction(txn, tuple_count);
+  concurrency::TransactionContext::Release(txn);
+
+  count_allocations = true;
+  allocation_count = 0;
+  txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 2);
+  EXPECT_TRUE(txn->GetReadWriteSet().IsEmpty());
+  EXPECT_TRUE(txn->IsGCSetEmpty());
+  RunShortTransaction(txn, tuple_count);
+  EXPECT_EQ(tuple_count * 2, txn->GetReadWriteSet().GetSize());
+  concurrency::TransactionContext::Release(txn);
+  count_allocations = false;
+
+  EXPECT_EQ(0, allocation_count);
+}
+
+TEST_F(TransactionContextTests, ReleaseOnOtherThreadTest) {
+  auto txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 1);
+  RunShortTransaction(txn, 1);
+
+  // The GC releases contexts on its own threads
+  std::thread gc_thread(
+      [txn] { concurrency::TransactionContext::Release(txn); });
+  gc_thread.join();
+
+  auto next_txn = concurrency::TransactionContext::Acquire(
+      0, IsolationLevelType::SERIALIZABLE, 2);
+  EXPECT_EQ(txn, next_txn);
+  EXPECT_EQ(2, next_txn->GetReadId());
+  EXPECT_TRUE(next_txn->GetReadWriteSet().IsEmpty());
+  EXPECT_FALSE(next_txn->IsReadOnly());
+  concurrency::TransactionContext::Release(next_txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -335,7 +335,8 @@ executor::LogicalTile *TestingExecutorUtil::ExecuteTile(
 }
 
 storage::DataTable *TestingExecutorUtil::CreateTable(
-    int tuples_per_tilegroup_count, bool indexes, oid_t table_oid) {
+    int tuples_per_tilegroup_count, bool indexes, oid_t table_oid,
+    oid_t database_oid) {
   catalog::Schema *table_schema = new catalog::Schema(
       {GetColumnInfo(0), GetColumnInfo(1), GetColumnInfo(2), GetColumnInfo(3)});
   std::string table_name("test_table");
@@ -344,7 +345,7 @@ storage::DataTable *TestingExecutorUtil::CreateTable(
   bool own_schema = true;
   bool adapt_table = false;
   storage::DataTable *table = storage::TableFactory::GetDataTable(
-      INVALID_OID, table_oid, table_schema, table_name,
+      database_oid, table_oid, table_schema, table_name,
       tuples_per_tilegroup_count, own_schema, adapt_table);
 
   if (indexes == true) {
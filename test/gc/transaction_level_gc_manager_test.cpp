@@ -17,8 +17,10 @@
 #include "concurrency/epoch_manager.h"
 
 #include "catalog/catalog.h"
+#include "settings/settings_manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 #include "storage/database.h"
 #include "storage/storage_manager.h"
 
@@ -493,5 +495,180 @@ TEST_F(TransactionLevelGCManagerTests, ImmutabilityTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+/*
+The live tuples of a sparse tile group are moved out by compaction, and the
+tile group is dropped once the GC has reclaimed its versions.
+*/
+TEST_F(TransactionLevelGCManagerTests, CompactionTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("compactiondb");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  const int num_key = 25;
+  const size_t tuples_per_tilegroup = 5;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE1", db_id, 12348, 1234, true, tuples_per_tilegroup));
+  oid_t num_tile_groups = table->GetTileGroupCount();
+  oid_t sparse_tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+  oid_t full_tile_group_id = table->GetTileGroup(1)->GetTileGroupId();
+
+  // Deleting all but one tuple of the 1st tile group
+  for (int key = 0; key < 4; key++) {
+    EXPECT_EQ(ResultType::SUCCESS, DeleteTuple(table.get(), key));
+  }
+  epoch_manager.SetCurrentEpochId(2);
+  EXPECT_EQ(4, gc_manager.Unlink(0, epoch_manager.GetExpiredEpochId()));
+  epoch_manager.SetCurrentEpochId(3);
+  EXPECT_EQ(4, gc_manager.Reclaim(0, epoch_manager.GetExpiredEpochId()));
+
+  // Only the sparse tile group is compacted
+  EXPECT_FALSE(table->CompactTileGroup(full_tile_group_id, 0.5));
+  EXPECT_FALSE(table->GetTileGroup(1)->GetHeader()->GetImmutability());
+  EXPECT_TRUE(table->CompactTileGroup(sparse_tile_group_id, 0.5));
+  EXPECT_TRUE(table->GetTileGroup(0)->GetHeader()->GetImmutability());
+
+  // The moved version is not reclaimed yet
+  EXPECT_FALSE(table->DropCompactedTileGroup(sparse_tile_group_id));
+
+  epoch_manager.SetCurrentEpochId(4);
+  EXPECT_EQ(1, gc_manager.Unlink(0, epoch_manager.GetExpiredEpochId()));
+  epoch_manager.SetCurrentEpochId(5);
+  EXPECT_EQ(1, gc_manager.Reclaim(0, epoch_manager.GetExpiredEpochId()));
+
+  EXPECT_TRUE(table->DropCompactedTileGroup(sparse_tile_group_id));
+  EXPECT_EQ(nullptr, storage_manager->GetTileGroup(sparse_tile_group_id));
+  EXPECT_EQ(nullptr, table->GetTileGroup(0));
+  EXPECT_EQ(num_tile_groups, table->GetTileGroupCount());
+
+  // The moved tuple is still found through the index
+  std::vector<int> results;
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 4, results));
+  EXPECT_TRUE(results[0] != -1);
+  results.clear();
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 0, results));
+  EXPECT_TRUE(results[0] == -1);
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("compactiondb");
+}
+
+/*
+The updates of a table with delta versions only write the updated column. The
+new versions read the key from the older versions, until the GC copies it
+over before it reclaims them.
+*/
+TEST_F(TransactionLevelGCManagerTests, DeltaVersionTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("deltadb");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  settings::SettingsManager::SetBool(settings::SettingId::delta_versions,
+                                     true);
+  const int num_key = 1;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE1", db_id, 12349, 1234, true));
+  settings::SettingsManager::SetBool(settings::SettingId::delta_versions,
+                                     false);
+  EXPECT_TRUE(table->UsesDeltaVersions());
+
+  // The first update installs a delta version, the second one writes it in
+  // place
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 1));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 2));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 3));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  auto first_tile_group = table->GetTileGroup(0);
+  ItemPointer middle_location =
+      first_tile_group->GetHeader()->GetPrevItemPointer(0);
+  ItemPointer newest_location =
+      storage_manager->GetTileGroup(middle_location.block)
+          ->GetHeader()
+          ->GetPrevItemPointer(middle_location.offset);
+  auto newest_tile_group = storage_manager->GetTileGroup(newest_location.block);
+  auto newest_header = newest_tile_group->GetHeader();
+
+  auto delta_record = newest_header->GetDeltaRecord(newest_location.offset);
+  ASSERT_TRUE(delta_record != nullptr);
+  EXPECT_EQ(middle_location.block, delta_record->GetOlderLocation().block);
+  EXPECT_EQ(middle_location.offset, delta_record->GetOlderLocation().offset);
+  EXPECT_TRUE(delta_record->IsInherited(0));
+  EXPECT_FALSE(delta_record->IsInherited(1));
+
+  // The key is read through both older versions
+  EXPECT_EQ(0, newest_tile_group->GetValue(newest_location.offset, 0)
+                   .GetAs<int32_t>());
+  EXPECT_EQ(3, newest_tile_group->GetValue(newest_location.offset, 1)
+                   .GetAs<int32_t>());
+
+  // The key is copied into the delta versions when the older versions are
+  // unlinked
+  epoch_manager.SetCurrentEpochId(2);
+  EXPECT_EQ(2, gc_manager.Unlink(0, epoch_manager.GetExpiredEpochId()));
+  EXPECT_TRUE(delta_record->IsFolded());
+  EXPECT_FALSE(delta_record->IsInherited(0));
+  EXPECT_FALSE(newest_header->HasDeltaRecords());
+  EXPECT_EQ(0, newest_tile_group->GetValue(newest_location.offset, 0)
+                   .GetAs<int32_t>());
+
+  epoch_manager.SetCurrentEpochId(3);
+  EXPECT_EQ(2, gc_manager.Reclaim(0, epoch_manager.GetExpiredEpochId()));
+  EXPECT_EQ(nullptr, storage_manager->GetTileGroup(middle_location.block)
+                         ->GetHeader()
+                         ->GetDeltaRecord(middle_location.offset));
+
+  std::vector<int> results;
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 0, results));
+  EXPECT_EQ(3, results[0]);
+
+  // The value is still inherited when an update in place reads it, and
+  // writes it (SET value = value + 1). The update reads the value of the
+  // version it replaced, not the bytes of the slot.
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteTouch(txn, table.get(), 0));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdateAdd(txn, table.get(), 0, 1));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdateAdd(txn, table.get(), 0, 1));
+  int result = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(5, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 0, results));
+  EXPECT_EQ(5, results[0]);
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("deltadb");
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -106,6 +106,12 @@ class PelotonCodeGenTest : public PelotonTest {
                                     oid_t tile_group_count, oid_t column_count,
                                     bool is_inlined);
 
+  // Create a table with the test schema whose varchar column is
+  // dictionary-encoded, and load it with rows whose varchar values cycle
+  // through the given number of distinct strings "str0", "str1", ...
+  storage::DataTable *CreateAndLoadDictionaryTable(uint32_t num_rows,
+                                                   uint32_t num_strings);
+
   // Compile and execute the given plan
   CodeGenStats CompileAndExecute(
       planner::AbstractPlan &plan, codegen::ExecutionConsumer &consumer);
@@ -142,6 +142,15 @@ class TestingTransactionUtil {
   static bool ExecuteUpdate(concurrency::TransactionContext *txn,
                             storage::DataTable *table, int id, int value,
                             bool select_for_update = false);
+  // Add increment to the value of the tuple, reading the value it replaces
+  static bool ExecuteUpdateAdd(concurrency::TransactionContext *txn,
+                               storage::DataTable *table, int id, int increment,
+                               bool select_for_update = false);
+  // Update the tuple without a target, every column is mapped over from the
+  // version it replaces
+  static bool ExecuteTouch(concurrency::TransactionContext *txn,
+                           storage::DataTable *table, int id,
+                           bool select_for_update = false);
   static bool ExecuteUpdateByValue(concurrency::TransactionContext *txn,
                                    storage::DataTable *table, int old_value,
                                    int new_value,
@@ -74,6 +74,15 @@ class TestingSQLUtil {
   // A another simpler wrapper around ExecuteSQLQuery
   static ResultType ExecuteSQLQuery(const std::string query);
 
+  // Prepare a statement with parameters, such as "... WHERE a = $1"
+  static std::shared_ptr<Statement> PrepareStatement(const std::string query);
+
+  // Execute a prepared statement end-to-end with the given parameters, the
+  // way the network layer binds and executes it
+  static ResultType ExecutePreparedStatement(
+      std::shared_ptr<Statement> statement,
+      std::vector<type::Value> param_values);
+
   // Executes a query and compares the result with the given rows, either
   // ordered or not
   // The result vector has to be specified as follows:
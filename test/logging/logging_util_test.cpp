@@ -1,35 +1,60 @@
-// //===----------------------------------------------------------------------===//
-// //
-// //                         Peloton
-// //
-// // logging_util_test.cpp
-// //
-// // Identification: test/logging/logging_util_test.cpp
-// //
-// // Copyright (c) 2015-16, Carnegie Mellon University Database Group
-// //
-// //===----------------------------------------------------------------------===//
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_util_test.cpp
+//
+// Identification: test/logging/logging_util_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
 
 
-// #include "common/harness.h"
+#include "common/harness.h"
 
-// #include "logging/logging_util.h"
+#include "logging/logging_util.h"
 
-// namespace peloton {
-// namespace test {
+namespace peloton {
+namespace test {
 
-// //===--------------------------------------------------------------------===//
-// // Logging Tests
-// //===--------------------------------------------------------------------===//
-// class LoggingUtilTests : public PelotonTest {};
+//===--------------------------------------------------------------------===//
+// Logging Tests
+//===--------------------------------------------------------------------===//
+class LoggingUtilTests : public PelotonTest {};
 
-// TEST_F(LoggingUtilTests, BasicLoggingUtilTest) {
-//   auto status = logging::LoggingUtil::CreateDirectory("test_dir", 0700);
-//   EXPECT_TRUE(status);
+TEST_F(LoggingUtilTests, BasicLoggingUtilTest) {
+  auto status = logging::LoggingUtil::CreateDirectory("test_dir", 0700);
+  EXPECT_TRUE(status);
 
-//   status = logging::LoggingUtil::RemoveDirectory("test_dir", true);
-//   EXPECT_TRUE(status);
-// }
+  status = logging::LoggingUtil::CheckDirectoryExistence("test_dir");
+  EXPECT_TRUE(status);
 
-// }  // namespace test
-// }  // namespace peloton
+  FileHandle file_handle;
+  status = logging::LoggingUtil::OpenFile("test_dir/test_file", "wb",
+                                          file_handle);
+  EXPECT_TRUE(status);
+
+  int data = 99;
+  fwrite(&data, sizeof(data), 1, file_handle.file);
+  logging::LoggingUtil::FFlushFsync(file_handle);
+
+  EXPECT_EQ(sizeof(data), logging::LoggingUtil::GetFileSize(file_handle));
+
+  status = logging::LoggingUtil::CloseFile(file_handle);
+  EXPECT_TRUE(status);
+
+  std::vector<std::string> file_names;
+  status = logging::LoggingUtil::GetDirectoryList("test_dir", file_names);
+  EXPECT_TRUE(status);
+  EXPECT_EQ(1, file_names.size());
+
+  status = logging::LoggingUtil::RemoveDirectory("test_dir", false);
+  EXPECT_TRUE(status);
+
+  status = logging::LoggingUtil::CheckDirectoryExistence("test_dir");
+  EXPECT_FALSE(status);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -10,8 +10,21 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+
 #include "logging/checkpoint_manager_factory.h"
 #include "common/harness.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "logging/logical_logger.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "type/ephemeral_pool.h"
 
 namespace peloton {
 namespace test {
@@ -25,9 +38,135 @@ class NewCheckpointingTests : public PelotonTest {};
 TEST_F(NewCheckpointingTests, MyTest) {
   auto &checkpoint_manager = logging::CheckpointManagerFactory::GetInstance();
   checkpoint_manager.Reset();
-  
+
   EXPECT_TRUE(true);
 }
 
+namespace {
+
+// take a checkpoint in the given format, and recover the table from the
+// checkpoint and the log written after it.
+void CheckpointAndRecover(const CheckpointFormatType format) {
+  const std::string logging_dir = "new_checkpoint_test_log_dir";
+  const std::string checkpoint_dir = "new_checkpoint_test_dir";
+  const std::string db_name = "checkpoint_db";
+  const oid_t table_oid = 12346;
+  const int tuple_count = 100;
+  const int new_tuple_count = 10;
+
+  auto database = TestingExecutorUtil::InitializeDatabase(db_name);
+  auto database_oid = database->GetOid();
+  auto table = TestingExecutorUtil::CreateTable(tuple_count / 4, true,
+                                                table_oid, database_oid);
+  database->AddTable(table);
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+
+  auto &checkpoint_manager = logging::LogicalCheckpointManager::GetInstance(2);
+  checkpoint_manager.SetDirectory(checkpoint_dir);
+  checkpoint_manager.SetCheckpointFormat(format);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, tuple_count, false, false, false,
+                                     txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // close the epoch of the populating transaction.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.SetCurrentEpochId(epoch_manager.GetCurrentEpochId() + 1);
+
+  eid_t checkpoint_eid = checkpoint_manager.DoCheckpoint();
+  EXPECT_NE(INVALID_EID, checkpoint_eid);
+  EXPECT_EQ(checkpoint_eid, checkpoint_manager.GetCheckpointEpochId());
+
+  // one checkpoint file per checkpointer, and the checkpoint epoch file.
+  std::vector<std::string> file_names;
+  EXPECT_TRUE(logging::LoggingUtil::GetDirectoryList(checkpoint_dir.c_str(),
+                                                     file_names));
+  EXPECT_EQ(3, file_names.size());
+
+  // the log files that are covered by the checkpoint are truncated.
+  file_names.clear();
+  EXPECT_TRUE(
+      logging::LoggingUtil::GetDirectoryList(logging_dir.c_str(), file_names));
+  for (auto &file_name : file_names) {
+    auto file_eid = logging::LoggingUtil::GetEpochIdFromFileName(
+        file_name, logging::LogicalLogger::GetLogFilePrefix());
+    EXPECT_TRUE(file_eid == INVALID_EID || file_eid >= checkpoint_eid);
+  }
+
+  // these tuples are only recovered from the log.
+  type::EphemeralPool pool;
+  txn = txn_manager.BeginTransaction();
+  for (int tuple_itr = tuple_count; tuple_itr < tuple_count + new_tuple_count;
+       ++tuple_itr) {
+    auto tuple = TestingExecutorUtil::GetTuple(table, tuple_itr, &pool);
+    ItemPointer *index_entry_ptr = nullptr;
+    ItemPointer location =
+        table->InsertTuple(tuple.get(), txn, &index_entry_ptr);
+    EXPECT_FALSE(location.IsNull());
+    txn_manager.PerformInsert(txn, location, index_entry_ptr);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  log_manager.StopLogging();
+
+  // simulate a crash: the table is re-created without any data.
+  database->DropTableWithOid(table_oid);
+  table = TestingExecutorUtil::CreateTable(tuple_count / 4, true, table_oid,
+                                           database_oid);
+  database->AddTable(table);
+
+  EXPECT_EQ(checkpoint_eid, checkpoint_manager.DoCheckpointRecovery());
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(4, checkpoint_eid));
+
+  EXPECT_EQ(tuple_count + new_tuple_count, table->GetTupleCount());
+
+  // every recovered tuple is reachable from the primary key index.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  EXPECT_EQ(tuple_count + new_tuple_count, index_entries.size());
+
+  std::set<int> keys;
+  for (auto index_entry : index_entries) {
+    auto tile_group = storage_manager->GetTileGroup(index_entry->block);
+    int key = tile_group->GetValue(index_entry->offset, 0).GetAs<int>();
+    keys.insert(key);
+
+    // the uninlined column is recovered as well.
+    int tuple_id = key / 10;
+    std::string expected_value =
+        tuple_id < tuple_count
+            ? std::to_string(TestingExecutorUtil::PopulatedValue(tuple_id, 3))
+            : "12345";
+    EXPECT_EQ(expected_value,
+              tile_group->GetValue(index_entry->offset, 3).ToString());
+  }
+  EXPECT_EQ(tuple_count + new_tuple_count, keys.size());
+  EXPECT_EQ(TestingExecutorUtil::PopulatedValue(0, 0), *keys.begin());
+  EXPECT_EQ(TestingExecutorUtil::PopulatedValue(
+                tuple_count + new_tuple_count - 1, 0),
+            *keys.rbegin());
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+  EXPECT_TRUE(
+      logging::LoggingUtil::RemoveDirectory(checkpoint_dir.c_str(), false));
+  TestingExecutorUtil::DeleteDatabase(db_name);
+}
+
+}  // namespace
+
+TEST_F(NewCheckpointingTests, RowCheckpointTest) {
+  CheckpointAndRecover(CheckpointFormatType::ROW);
+}
+
+TEST_F(NewCheckpointingTests, BinaryCheckpointTest) {
+  CheckpointAndRecover(CheckpointFormatType::BINARY);
+}
+
 }
 }
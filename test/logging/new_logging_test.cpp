@@ -10,8 +10,22 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "logging/log_manager_factory.h"
+#include "catalog/catalog.h"
 #include "common/harness.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "logging/log_manager_factory.h"
+#include "logging/logging_util.h"
+#include "planner/project_info.h"
+#include "sql/testing_sql_util.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -30,5 +44,374 @@ TEST_F(NewLoggingTests, MyTest) {
   
 }
 
+TEST_F(NewLoggingTests, GroupCommitTest) {
+  const std::string logging_dir = "new_logging_test_dir";
+  const int tuple_count = 100;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+  EXPECT_TRUE(log_manager.GetStatus());
+
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                     false, txn);
+  auto commit_eid = concurrency::EpochManagerFactory::GetInstance()
+                        .GetCurrentEpochId();
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // a read-only transaction does not produce any log record.
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // stopping the log manager persists all the buffered records.
+  log_manager.StopLogging();
+  EXPECT_FALSE(log_manager.GetStatus());
+  EXPECT_GE(log_manager.GetPersistEpochId(), commit_eid);
+
+  // walk through the records in the log files.
+  std::vector<std::string> file_names;
+  EXPECT_TRUE(logging::LoggingUtil::GetDirectoryList(logging_dir.c_str(),
+                                                     file_names));
+
+  int begin_count = 0, insert_count = 0, commit_count = 0;
+  for (auto &file_name : file_names) {
+    if (file_name == "pepoch") continue;
+
+    FileHandle file_handle;
+    std::string file_path = logging_dir + "/" + file_name;
+    EXPECT_TRUE(
+        logging::LoggingUtil::OpenFile(file_path.c_str(), "rb", file_handle));
+
+    int32_t record_length;
+    while (logging::LoggingUtil::ReadNBytesFromFile(
+               file_handle, &record_length, sizeof(record_length))) {
+      std::unique_ptr<char[]> record(new char[record_length]);
+      EXPECT_TRUE(logging::LoggingUtil::ReadNBytesFromFile(
+          file_handle, record.get(), record_length));
+
+      auto record_type = static_cast<LogRecordType>(record[0]);
+      if (record_type == LogRecordType::TRANSACTION_BEGIN) begin_count++;
+      if (record_type == LogRecordType::TUPLE_INSERT) insert_count++;
+      if (record_type == LogRecordType::TRANSACTION_COMMIT) commit_count++;
+    }
+
+    logging::LoggingUtil::CloseFile(file_handle);
+  }
+
+  EXPECT_EQ(1, begin_count);
+  EXPECT_EQ(tuple_count, insert_count);
+  EXPECT_EQ(1, commit_count);
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+}
+
+TEST_F(NewLoggingTests, SynchronousCommitTest) {
+  const std::string logging_dir = "new_sync_commit_test_dir";
+  const int tuple_count = 10;
+
+  // the persistent epoch only advances with the epochs.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.StartEpoch();
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+
+  // a synchronous commit returns once its epoch is durable.
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  txn->SetSynchronousCommit(true);
+  TestingExecutorUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                     false, txn);
+  auto commit_eid = epoch_manager.GetCurrentEpochId();
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_GE(log_manager.GetPersistEpochId(), commit_eid);
+
+  log_manager.StopLogging();
+  epoch_manager.StopEpoch();
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+}
+
+TEST_F(NewLoggingTests, RecoveryTest) {
+  const std::string logging_dir = "new_recovery_test_dir";
+  const std::string db_name = "recovery_db";
+  const oid_t table_oid = 12345;
+  const int tuple_count = 100;
+
+  auto database = TestingExecutorUtil::InitializeDatabase(db_name);
+  auto database_oid = database->GetOid();
+  auto table = TestingExecutorUtil::CreateTable(tuple_count / 4, true,
+                                                table_oid, database_oid);
+  database->AddTable(table);
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, tuple_count, false, false, false,
+                                     txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  log_manager.StopLogging();
+
+  // simulate a crash: the table is re-created without any data.
+  database->DropTableWithOid(table_oid);
+  table = TestingExecutorUtil::CreateTable(tuple_count / 4, true, table_oid,
+                                           database_oid);
+  database->AddTable(table);
+
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(4));
+
+  auto &stats = log_manager.GetRecoveryStats();
+  EXPECT_EQ(1, stats.txn_count);
+  EXPECT_EQ(tuple_count, stats.record_count);
+  EXPECT_EQ(0, stats.skipped_record_count);
+  EXPECT_EQ(tuple_count, table->GetTupleCount());
+
+  // every recovered tuple is reachable from every index.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  cid_t max_begin_cid = 0;
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); ++index_itr) {
+    std::vector<ItemPointer *> index_entries;
+    table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(tuple_count, index_entries.size());
+
+    std::set<int> keys;
+    for (auto index_entry : index_entries) {
+      auto tile_group = storage_manager->GetTileGroup(index_entry->block);
+      keys.insert(tile_group->GetValue(index_entry->offset, 0).GetAs<int>());
+      max_begin_cid = std::max(
+          max_begin_cid,
+          tile_group->GetHeader()->GetBeginCommitId(index_entry->offset));
+    }
+    EXPECT_EQ(tuple_count, keys.size());
+    EXPECT_EQ(TestingExecutorUtil::PopulatedValue(0, 0), *keys.begin());
+    EXPECT_EQ(TestingExecutorUtil::PopulatedValue(tuple_count - 1, 0),
+              *keys.rbegin());
+  }
+
+  // new transactions observe the recovered tuples.
+  txn = txn_manager.BeginTransaction();
+  EXPECT_LT(max_begin_cid, txn->GetReadId());
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+  TestingExecutorUtil::DeleteDatabase(db_name);
+}
+
+namespace {
+
+// update the third column of the latest version of the first tuple_count
+// tuples in the primary key index, in a single transaction.
+void UpdateThirdColumn(storage::DataTable *table, const int tuple_count,
+                       const int delta) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto storage_manager = storage::StorageManager::GetInstance();
+  type::EphemeralPool pool;
+  auto schema = table->GetSchema();
+
+  TargetList target_list;
+  target_list.emplace_back(2, planner::DerivedAttribute(nullptr));
+
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  std::sort(index_entries.begin(), index_entries.end(),
+            [](ItemPointer *lhs, ItemPointer *rhs) {
+              return lhs->block < rhs->block ||
+                     (lhs->block == rhs->block && lhs->offset < rhs->offset);
+            });
+
+  auto txn = txn_manager.BeginTransaction();
+  for (int tuple_itr = 0; tuple_itr < tuple_count; ++tuple_itr) {
+    ItemPointer *index_entry = index_entries[tuple_itr];
+    ItemPointer old_location = *index_entry;
+    auto tile_group = storage_manager->GetTileGroup(old_location.block);
+    EXPECT_TRUE(txn_manager.AcquireOwnership(txn, tile_group->GetHeader(),
+                                             old_location.offset));
+
+    storage::Tuple tuple(schema, true);
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         ++column_itr) {
+      tuple.SetValue(column_itr,
+                     tile_group->GetValue(old_location.offset, column_itr),
+                     &pool);
+    }
+    double value =
+        tile_group->GetValue(old_location.offset, 2).GetAs<double>();
+    tuple.SetValue(2, type::ValueFactory::GetDecimalValue(value + delta),
+                   &pool);
+
+    ItemPointer new_location = table->AcquireVersion();
+    storage_manager->GetTileGroup(new_location.block)
+        ->CopyTuple(&tuple, new_location.offset);
+    EXPECT_TRUE(table->InstallVersion(&tuple, &target_list, txn, index_entry));
+    txn_manager.PerformUpdate(txn, old_location, new_location, &target_list);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+}  // namespace
+
+TEST_F(NewLoggingTests, UpdateRecoveryTest) {
+  const std::string logging_dir = "new_update_recovery_test_dir";
+  const std::string db_name = "update_recovery_db";
+  const oid_t table_oid = 12347;
+  const int tuple_count = 100;
+  const int updated_tuple_count = 50;
+
+  auto database = TestingExecutorUtil::InitializeDatabase(db_name);
+  auto database_oid = database->GetOid();
+  auto table = TestingExecutorUtil::CreateTable(tuple_count / 4, true,
+                                                table_oid, database_oid);
+  database->AddTable(table);
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, tuple_count, false, false, false,
+                                     txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // every tuple is updated once, and some of them twice. the new versions
+  // only carry the updated column in the log.
+  UpdateThirdColumn(table, tuple_count, 1000);
+  UpdateThirdColumn(table, updated_tuple_count, 1000);
+
+  log_manager.StopLogging();
+
+  // simulate a crash: the table is re-created without any data.
+  database->DropTableWithOid(table_oid);
+  table = TestingExecutorUtil::CreateTable(tuple_count / 4, true, table_oid,
+                                           database_oid);
+  database->AddTable(table);
+
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(4));
+
+  auto &stats = log_manager.GetRecoveryStats();
+  EXPECT_EQ(3, stats.txn_count);
+  EXPECT_EQ(2 * tuple_count + updated_tuple_count, stats.record_count);
+  EXPECT_EQ(tuple_count + updated_tuple_count, stats.delta_record_count);
+  EXPECT_EQ(0, stats.skipped_record_count);
+
+  // the latest versions are rebuilt from the versions they replaced.
+  auto storage_manager = storage::StorageManager::GetInstance();
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  EXPECT_EQ(tuple_count, index_entries.size());
+
+  int twice_updated_count = 0;
+  for (auto index_entry : index_entries) {
+    auto tile_group = storage_manager->GetTileGroup(index_entry->block);
+    auto tile_group_header = tile_group->GetHeader();
+    EXPECT_EQ(MAX_CID, tile_group_header->GetEndCommitId(index_entry->offset));
+
+    int tuple_id =
+        tile_group->GetValue(index_entry->offset, 0).GetAs<int>() / 10;
+    EXPECT_EQ(TestingExecutorUtil::PopulatedValue(tuple_id, 1),
+              tile_group->GetValue(index_entry->offset, 1).GetAs<int>());
+    EXPECT_EQ(std::to_string(TestingExecutorUtil::PopulatedValue(tuple_id, 3)),
+              tile_group->GetValue(index_entry->offset, 3).ToString());
+
+    double delta =
+        tile_group->GetValue(index_entry->offset, 2).GetAs<double>() -
+        TestingExecutorUtil::PopulatedValue(tuple_id, 2);
+    EXPECT_TRUE(delta == 1000 || delta == 2000);
+    if (delta == 2000) {
+      twice_updated_count++;
+    }
+  }
+  EXPECT_EQ(updated_tuple_count, twice_updated_count);
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+  TestingExecutorUtil::DeleteDatabase(db_name);
+}
+
+TEST_F(NewLoggingTests, CommandLoggingTest) {
+  const std::string logging_dir = "new_command_logging_test_dir";
+  const int tuple_count = 20;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE command_test(a INT PRIMARY KEY, b INT);");
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.SetLoggingMode(LoggingModeType::COMMAND);
+  log_manager.StartLogging();
+
+  auto insert_statement = TestingSQLUtil::PrepareStatement(
+      "INSERT INTO command_test VALUES ($1, $2);");
+  ASSERT_NE(nullptr, insert_statement);
+  for (int i = 0; i < tuple_count; ++i) {
+    EXPECT_EQ(ResultType::SUCCESS,
+              TestingSQLUtil::ExecutePreparedStatement(
+                  insert_statement, {type::ValueFactory::GetIntegerValue(i),
+                                     type::ValueFactory::GetIntegerValue(i)}));
+  }
+
+  auto update_statement = TestingSQLUtil::PrepareStatement(
+      "UPDATE command_test SET b = b + $1 WHERE a < $2;");
+  ASSERT_NE(nullptr, update_statement);
+  EXPECT_EQ(ResultType::SUCCESS,
+            TestingSQLUtil::ExecutePreparedStatement(
+                update_statement,
+                {type::ValueFactory::GetIntegerValue(100),
+                 type::ValueFactory::GetIntegerValue(tuple_count / 2)}));
+
+  log_manager.StopLogging();
+
+  // both statements are recorded once.
+  auto logged_statements = logging::LogicalLogRecovery::ReadStatementFile(
+      log_manager.GetStatementFileFullPath());
+  EXPECT_EQ(2, logged_statements.size());
+
+  // simulate a crash: the table is re-created without any data. the
+  // commands do not depend on the oid of the table.
+  TestingSQLUtil::ExecuteSQLQuery("DROP TABLE command_test;");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE command_test(a INT PRIMARY KEY, b INT);");
+
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(2));
+
+  auto &stats = log_manager.GetRecoveryStats();
+  EXPECT_EQ(tuple_count + 1, stats.txn_count);
+  EXPECT_EQ(tuple_count + 1, stats.command_count);
+  EXPECT_EQ(0, stats.failed_command_count);
+  EXPECT_EQ(0, stats.record_count);
+
+  std::vector<std::string> expected_result;
+  for (int i = 0; i < tuple_count; ++i) {
+    int b = i < tuple_count / 2 ? i + 100 : i;
+    expected_result.push_back(std::to_string(i) + "|" + std::to_string(b));
+  }
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(
+      "SELECT a, b FROM command_test;", expected_result, false);
+
+  log_manager.SetLoggingMode(LoggingModeType::TUPLE);
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
 }
 }
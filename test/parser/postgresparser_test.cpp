@@ -654,6 +654,24 @@ TEST_F(PostgresParserTests, TransactionTest) {
   EXPECT_TRUE(stmt_list->is_valid);
   EXPECT_EQ(parser::TransactionStatement::kBegin, transac_stmt->type);
 
+  EXPECT_EQ(parser::TransactionStatement::kDefaultAccess,
+            transac_stmt->access_mode);
+
+  stmt_list.reset(parser.BuildParseTree("BEGIN READ ONLY;").release());
+  transac_stmt = (parser::TransactionStatement *)stmt_list->GetStatement(0);
+  EXPECT_TRUE(stmt_list->is_valid);
+  EXPECT_EQ(parser::TransactionStatement::kBegin, transac_stmt->type);
+  EXPECT_EQ(parser::TransactionStatement::kReadOnly,
+            transac_stmt->access_mode);
+
+  stmt_list.reset(
+      parser.BuildParseTree("START TRANSACTION READ WRITE;").release());
+  transac_stmt = (parser::TransactionStatement *)stmt_list->GetStatement(0);
+  EXPECT_TRUE(stmt_list->is_valid);
+  EXPECT_EQ(parser::TransactionStatement::kBegin, transac_stmt->type);
+  EXPECT_EQ(parser::TransactionStatement::kReadWrite,
+            transac_stmt->access_mode);
+
   stmt_list.reset(parser.BuildParseTree("COMMIT TRANSACTION;").release());
   transac_stmt = (parser::TransactionStatement *)stmt_list->GetStatement(0);
   EXPECT_TRUE(stmt_list->is_valid);
@@ -1069,6 +1087,27 @@ TEST_F(PostgresParserTests, DropTriggerTest) {
   EXPECT_EQ("films", drop_trigger_stmt->GetTriggerTableName());
 }
 
+TEST_F(PostgresParserTests, VariableSetTest) {
+  auto parser = parser::PostgresParser::GetInstance();
+  std::vector<std::pair<std::string, std::string>> expected_values = {
+      {"SET synchronous_commit = off;", "off"},
+      {"SET SYNCHRONOUS_COMMIT TO on;", "on"},
+      {"SET synchronous_commit = 1;", "1"},
+      {"SET synchronous_commit TO DEFAULT;", ""}};
+
+  for (auto &expected_value : expected_values) {
+    std::unique_ptr<parser::SQLStatementList> stmt_list(
+        parser.BuildParseTree(expected_value.first).release());
+    EXPECT_TRUE(stmt_list->is_valid);
+    EXPECT_EQ(StatementType::VARIABLE_SET,
+              stmt_list->GetStatement(0)->GetType());
+    auto set_stmt = static_cast<parser::VariableSetStatement *>(
+        stmt_list->GetStatement(0));
+    EXPECT_EQ("synchronous_commit", set_stmt->name);
+    EXPECT_EQ(expected_value.second, set_stmt->value);
+  }
+}
+
 TEST_F(PostgresParserTests, FuncCallTest) {
   std::string query = "SELECT add(1,a), chr(99) FROM TEST WHERE FUN(b) > 2";
 
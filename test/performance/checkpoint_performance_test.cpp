@@ -0,0 +1,204 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// checkpoint_performance_test.cpp
+//
+// Identification: test/performance/checkpoint_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_checkpoint_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/table_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
+
+#include "executor/testing_executor_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Checkpoint Performance Tests
+//===--------------------------------------------------------------------===//
+
+class CheckpointPerformanceTests : public PelotonTest {};
+
+namespace {
+
+const oid_t checkpoint_table_oid = 34567;
+const size_t checkpoint_payload_size = 100;
+const size_t checkpoint_tuples_per_tilegroup = 10000;
+const size_t checkpoint_tuples_per_txn = 10000;
+
+// table with integer columns and an uninlined varchar payload.
+storage::DataTable *CreateCheckpointTable(const oid_t database_oid) {
+  const bool is_inlined = true;
+  std::vector<catalog::Column> columns;
+  for (int column_itr = 0; column_itr < 8; ++column_itr) {
+    columns.emplace_back(type::TypeId::BIGINT,
+                         type::Type::GetTypeSize(type::TypeId::BIGINT),
+                         "col_" + std::to_string(column_itr), is_inlined);
+  }
+  columns.emplace_back(type::TypeId::VARCHAR, checkpoint_payload_size,
+                       "payload", !is_inlined);
+
+  return storage::TableFactory::GetDataTable(
+      database_oid, checkpoint_table_oid, new catalog::Schema(columns),
+      "checkpoint_table", checkpoint_tuples_per_tilegroup, true, false);
+}
+
+void LoadTuples(storage::DataTable *table, const size_t tuple_count,
+                const uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  type::EphemeralPool pool;
+  auto schema = table->GetSchema();
+
+  std::string payload(checkpoint_payload_size - 1, 'a' + thread_itr % 26);
+  auto payload_value = type::ValueFactory::GetVarcharValue(payload);
+
+  size_t tuple_itr = 0;
+  while (tuple_itr < tuple_count) {
+    auto txn = txn_manager.BeginTransaction();
+    for (size_t i = 0;
+         i < checkpoint_tuples_per_txn && tuple_itr < tuple_count;
+         ++i, ++tuple_itr) {
+      int64_t key = thread_itr * tuple_count + tuple_itr;
+      storage::Tuple tuple(schema, true);
+      for (oid_t column_itr = 0; column_itr < 8; ++column_itr) {
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetBigIntValue(key + column_itr),
+                       &pool);
+      }
+      tuple.SetValue(8, payload_value, &pool);
+
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          table->InsertTuple(&tuple, txn, &index_entry_ptr);
+      EXPECT_TRUE(location.IsNull() == false);
+      txn_manager.PerformInsert(txn, location, index_entry_ptr);
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
+// number of tuples and sum of the first column of a table.
+std::pair<size_t, int64_t> GetTableSummary(storage::DataTable *table) {
+  size_t tuple_count = 0;
+  int64_t key_sum = 0;
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       ++tile_group_itr) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    auto next_tuple_slot = tile_group_header->GetCurrentNextTupleSlot();
+    for (oid_t tuple_slot = 0; tuple_slot < next_tuple_slot; ++tuple_slot) {
+      if (tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+        continue;
+      }
+      tuple_count++;
+      key_sum += tile_group->GetValue(tuple_slot, 0).GetAs<int64_t>();
+      EXPECT_EQ(checkpoint_payload_size - 1,
+                tile_group->GetValue(tuple_slot, 8).ToString().size());
+    }
+  }
+  return std::make_pair(tuple_count, key_sum);
+}
+
+// take a checkpoint of the table in the given format, re-create the table
+// and load the checkpoint back. returns the load time in milliseconds.
+double CheckpointAndLoad(storage::Database *database,
+                         const CheckpointFormatType format,
+                         const std::string &checkpoint_dir) {
+  auto &checkpoint_manager = logging::LogicalCheckpointManager::GetInstance(
+      std::thread::hardware_concurrency());
+  checkpoint_manager.SetDirectory(checkpoint_dir);
+  checkpoint_manager.SetCheckpointFormat(format);
+
+  Timer<std::milli> timer;
+  timer.Start();
+  EXPECT_NE(INVALID_EID, checkpoint_manager.DoCheckpoint());
+  timer.Stop();
+  LOG_INFO("%s checkpoint is taken in %.2lf ms",
+           CheckpointFormatTypeToString(format).c_str(), timer.GetDuration());
+
+  // simulate a crash: the table is re-created without any data.
+  auto database_oid = database->GetOid();
+  database->DropTableWithOid(checkpoint_table_oid);
+  database->AddTable(CreateCheckpointTable(database_oid));
+
+  timer.Reset();
+  timer.Start();
+  EXPECT_NE(INVALID_EID, checkpoint_manager.DoCheckpointRecovery());
+  timer.Stop();
+
+  EXPECT_TRUE(
+      logging::LoggingUtil::RemoveDirectory(checkpoint_dir.c_str(), false));
+
+  return timer.GetDuration();
+}
+
+}  // namespace
+
+TEST_F(CheckpointPerformanceTests, RowVersusBinaryLoadTest) {
+  // WARNING: the tuples of this test take about this much memory.
+  const size_t data_size = 1UL * 1024 * 1024 * 1024;
+  const size_t loader_thread_count = 4;
+
+  const std::string checkpoint_dir = "checkpoint_performance_test_dir";
+  const std::string db_name = "checkpoint_performance_db";
+
+  const size_t tuple_count_per_loader =
+      data_size / (8 * sizeof(int64_t) + checkpoint_payload_size) /
+      loader_thread_count;
+  const size_t tuple_count = tuple_count_per_loader * loader_thread_count;
+
+  auto database = TestingExecutorUtil::InitializeDatabase(db_name);
+  database->AddTable(CreateCheckpointTable(database->GetOid()));
+
+  LaunchParallelTest(loader_thread_count, LoadTuples,
+                     database->GetTableWithOid(checkpoint_table_oid),
+                     tuple_count_per_loader);
+
+  auto summary =
+      GetTableSummary(database->GetTableWithOid(checkpoint_table_oid));
+  EXPECT_EQ(tuple_count, summary.first);
+
+  // the table is loaded from a row checkpoint first, and the binary
+  // checkpoint is then taken from the loaded table.
+  double row_load_time =
+      CheckpointAndLoad(database, CheckpointFormatType::ROW, checkpoint_dir);
+  EXPECT_EQ(summary,
+            GetTableSummary(database->GetTableWithOid(checkpoint_table_oid)));
+
+  double binary_load_time = CheckpointAndLoad(
+      database, CheckpointFormatType::BINARY, checkpoint_dir);
+  EXPECT_EQ(summary,
+            GetTableSummary(database->GetTableWithOid(checkpoint_table_oid)));
+
+  LOG_INFO("Loaded %lu tuples", tuple_count);
+  LOG_INFO("Row: %.2lf ms, Binary: %.2lf ms, Speedup: %.2lf", row_load_time,
+           binary_load_time, row_load_time / binary_load_time);
+
+  TestingExecutorUtil::DeleteDatabase(db_name);
+}
+
+}  // namespace test
+}  // namespace peloton
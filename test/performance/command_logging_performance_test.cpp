@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// command_logging_performance_test.cpp
+//
+// Identification: test/performance/command_logging_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "type/value_factory.h"
+
+#include "sql/testing_sql_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Command Logging Performance Tests
+//===--------------------------------------------------------------------===//
+
+class CommandLoggingPerformanceTests : public PelotonTest {};
+
+namespace {
+
+const int command_logging_tuple_count = 10000;
+const int command_logging_txn_count = 10000;
+const int command_logging_tuples_per_update = 10;
+
+// total size of the files in the logging directory, including the
+// statement file.
+size_t GetLogSize(const std::string &logging_dir) {
+  size_t log_size = 0;
+  std::vector<std::string> file_names;
+  EXPECT_TRUE(
+      logging::LoggingUtil::GetDirectoryList(logging_dir.c_str(), file_names));
+  for (auto &file_name : file_names) {
+    std::string full_path = logging_dir + "/" + file_name;
+    FileHandle file_handle;
+    if (logging::LoggingUtil::OpenFile(full_path.c_str(), "rb", file_handle) ==
+        false) {
+      continue;
+    }
+    log_size += logging::LoggingUtil::GetFileSize(file_handle);
+    logging::LoggingUtil::CloseFile(file_handle);
+  }
+  return log_size;
+}
+
+// run a workload of prepared range updates in the given logging mode.
+// returns the number of log bytes written per transaction.
+double MeasureLogBytesPerTxn(const LoggingModeType mode,
+                             const std::string &logging_dir) {
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE command_logging_table(a INT PRIMARY KEY, b INT, c INT, "
+      "d INT, e INT, f INT, g INT, h INT, i INT);");
+
+  // the table is loaded before logging starts.
+  auto insert_statement = TestingSQLUtil::PrepareStatement(
+      "INSERT INTO command_logging_table VALUES ($1, $1, $1, $1, $1, $1, $1, "
+      "$1, $1);");
+  for (int tuple_itr = 0; tuple_itr < command_logging_tuple_count;
+       ++tuple_itr) {
+    TestingSQLUtil::ExecutePreparedStatement(
+        insert_statement, {type::ValueFactory::GetIntegerValue(tuple_itr)});
+  }
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.SetLoggingMode(mode);
+  log_manager.StartLogging();
+
+  auto update_statement = TestingSQLUtil::PrepareStatement(
+      "UPDATE command_logging_table SET b = b + $1, c = c + $1 "
+      "WHERE a >= $2 AND a < $3;");
+
+  Timer<std::milli> timer;
+  timer.Start();
+  for (int txn_itr = 0; txn_itr < command_logging_txn_count; ++txn_itr) {
+    int begin_key = (txn_itr * command_logging_tuples_per_update) %
+                    command_logging_tuple_count;
+    EXPECT_EQ(ResultType::SUCCESS,
+              TestingSQLUtil::ExecutePreparedStatement(
+                  update_statement,
+                  {type::ValueFactory::GetIntegerValue(1),
+                   type::ValueFactory::GetIntegerValue(begin_key),
+                   type::ValueFactory::GetIntegerValue(
+                       begin_key + command_logging_tuples_per_update)}));
+  }
+  timer.Stop();
+
+  log_manager.StopLogging();
+
+  double log_bytes_per_txn =
+      GetLogSize(logging_dir) * 1.0 / command_logging_txn_count;
+  LOG_INFO("%s logging: %d transactions in %.2lf ms, %.2lf bytes/txn",
+           LoggingModeTypeToString(mode).c_str(), command_logging_txn_count,
+           timer.GetDuration(), log_bytes_per_txn);
+
+  log_manager.SetLoggingMode(LoggingModeType::TUPLE);
+  EXPECT_TRUE(
+      logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+  TestingSQLUtil::ExecuteSQLQuery("DROP TABLE command_logging_table;");
+
+  return log_bytes_per_txn;
+}
+
+}  // namespace
+
+TEST_F(CommandLoggingPerformanceTests, LogBytesPerTxnTest) {
+  const std::string logging_dir = "command_logging_performance_test_dir";
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  double tuple_bytes =
+      MeasureLogBytesPerTxn(LoggingModeType::TUPLE, logging_dir);
+  double command_bytes =
+      MeasureLogBytesPerTxn(LoggingModeType::COMMAND, logging_dir);
+
+  // a command record holds the parameters of the statement, rather than a
+  // record per updated tuple.
+  EXPECT_LT(command_bytes, tuple_bytes);
+
+  LOG_INFO("Tuple: %.2lf bytes/txn, Command: %.2lf bytes/txn, Ratio: %.2lf",
+           tuple_bytes, command_bytes, tuple_bytes / command_bytes);
+
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrency_control_performance_test.cpp
+//
+// Identification: test/performance/concurrency_control_performance_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <random>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "concurrency/testing_transaction_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Concurrency Control Performance Tests
+//===--------------------------------------------------------------------===//
+
+class ConcurrencyControlPerformanceTests : public PelotonTest {};
+
+namespace {
+
+// a YCSB-style mix: short transactions of point reads and updates over
+// uniformly chosen keys, mostly reads.
+const int ycsb_key_count = 1000;
+const int ycsb_thread_count = 4;
+const int ycsb_txn_count = 2000;
+const int ycsb_ops_per_txn = 10;
+const int ycsb_update_percent = 5;
+
+std::atomic<int> committed_txn_count;
+std::atomic<int> aborted_txn_count;
+
+void RunYCSBWorkload(storage::DataTable *table, uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::mt19937 generator(thread_itr);
+  std::uniform_int_distribution<int> key_distribution(0, ycsb_key_count - 1);
+  std::uniform_int_distribution<int> op_distribution(0, 99);
+
+  for (int txn_itr = 0; txn_itr < ycsb_txn_count; txn_itr++) {
+    auto txn = txn_manager.BeginTransaction();
+
+    bool is_success = true;
+    for (int op_itr = 0; op_itr < ycsb_ops_per_txn && is_success; op_itr++) {
+      int key = key_distribution(generator);
+      if (op_distribution(generator) < ycsb_update_percent) {
+        is_success =
+            TestingTransactionUtil::ExecuteUpdate(txn, table, key, txn_itr);
+      } else {
+        int result;
+        is_success =
+            TestingTransactionUtil::ExecuteRead(txn, table, key, result);
+      }
+      is_success = is_success && txn->GetResult() != ResultType::FAILURE;
+    }
+
+    ResultType result = is_success ? txn_manager.CommitTransaction(txn)
+                                   : txn_manager.AbortTransaction(txn);
+    if (result == ResultType::SUCCESS) {
+      committed_txn_count++;
+    } else {
+      aborted_txn_count++;
+    }
+  }
+}
+
+// run the workload with the given protocol, and return the number of
+// committed transactions per second.
+double MeasureThroughput(const ProtocolType protocol) {
+  concurrency::TransactionManagerFactory::Configure(
+      protocol, IsolationLevelType::SERIALIZABLE);
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      ycsb_key_count, "YCSB_TABLE_" + ProtocolTypeToString(protocol));
+
+  committed_txn_count = 0;
+  aborted_txn_count = 0;
+
+  Timer<std::milli> timer;
+  timer.Start();
+  LaunchParallelTest(ycsb_thread_count, RunYCSBWorkload, table);
+  timer.Stop();
+
+  double throughput = committed_txn_count * 1000.0 / timer.GetDuration();
+  LOG_INFO("%s: %d committed, %d aborted in %.2lf ms, %.2lf txn/s",
+           ProtocolTypeToString(protocol).c_str(), committed_txn_count.load(),
+           aborted_txn_count.load(), timer.GetDuration(), throughput);
+
+  EXPECT_EQ(ycsb_thread_count * ycsb_txn_count,
+            committed_txn_count + aborted_txn_count);
+  return throughput;
+}
+
+}  // namespace
+
+TEST_F(ConcurrencyControlPerformanceTests, YCSBReadHeavyTest) {
+  double to_throughput = MeasureThroughput(ProtocolType::TIMESTAMP_ORDERING);
+  double occ_throughput = MeasureThroughput(ProtocolType::OPTIMISTIC);
+
+  EXPECT_GT(to_throughput, 0);
+  EXPECT_GT(occ_throughput, 0);
+
+  LOG_INFO("Timestamp ordering: %.2lf txn/s, Optimistic: %.2lf txn/s, "
+           "Ratio: %.2lf",
+           to_throughput, occ_throughput, occ_throughput / to_throughput);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE);
+}
+
+}  // namespace test
+}  // namespace peloton
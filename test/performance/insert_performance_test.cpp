@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 #include <atomic>
+#include <thread>
 
 #include "executor/testing_executor_util.h"
 #include "common/harness.h"
@@ -158,5 +159,46 @@ TEST_F(InsertPerformanceTests, LoadingTest) {
                bytes_to_megabytes_converter);
 }
 
+TEST_F(InsertPerformanceTests, ScalingTest) {
+  // Every loader inserts the same number of tuples, with an active tile
+  // group per loader, so the throughput should grow with the loaders.
+  oid_t tuples_per_tilegroup = TEST_TUPLES_PER_TILEGROUP;
+  bool build_indexes = false;
+  oid_t tilegroup_count_per_loader = 100;
+  oid_t max_loader_threads_count = std::thread::hardware_concurrency();
+
+  auto default_active_tilegroup_count =
+      storage::DataTable::GetActiveTileGroupCount();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  for (oid_t loader_threads_count = 1;
+       loader_threads_count <= max_loader_threads_count;
+       loader_threads_count *= 2) {
+    storage::DataTable::SetActiveTileGroupCount(loader_threads_count);
+    std::unique_ptr<storage::DataTable> data_table(
+        TestingExecutorUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(loader_threads_count, InsertTuple, data_table.get(),
+                       testing_pool, tilegroup_count_per_loader);
+    timer.Stop();
+
+    // every tile group but the active ones is full.
+    size_t tuple_count = loader_threads_count * tilegroup_count_per_loader *
+                         TEST_TUPLES_PER_TILEGROUP;
+    EXPECT_GE(data_table->GetTileGroupCount(),
+              tuple_count / TEST_TUPLES_PER_TILEGROUP);
+    EXPECT_LE(data_table->GetTileGroupCount(),
+              tuple_count / TEST_TUPLES_PER_TILEGROUP + loader_threads_count);
+
+    LOG_INFO("Loaders: %u, Duration: %.2lf s, Throughput: %.2lf tuples/s",
+             loader_threads_count, timer.GetDuration(),
+             tuple_count / timer.GetDuration());
+  }
+
+  storage::DataTable::SetActiveTileGroupCount(default_active_tilegroup_count);
+}
+
 }  // namespace test
 }  // namespace peloton
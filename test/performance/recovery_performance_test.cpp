@@ -0,0 +1,184 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// recovery_performance_test.cpp
+//
+// Identification: test/performance/recovery_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "index/index_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/table_factory.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
+
+#include "executor/testing_executor_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Recovery Performance Tests
+//===--------------------------------------------------------------------===//
+
+class RecoveryPerformanceTests : public PelotonTest {};
+
+namespace {
+
+const oid_t recovery_table_oid = 23456;
+const size_t recovery_payload_size = 1000;
+const size_t recovery_tuples_per_tilegroup = 10000;
+const size_t recovery_tuples_per_txn = 1000;
+
+// table with an integer primary key and an uninlined varchar payload.
+storage::DataTable *CreateRecoveryTable(const oid_t database_oid) {
+  const bool is_inlined = true;
+  catalog::Schema *table_schema = new catalog::Schema(
+      {catalog::Column(type::TypeId::INTEGER,
+                       type::Type::GetTypeSize(type::TypeId::INTEGER), "key",
+                       is_inlined),
+       catalog::Column(type::TypeId::VARCHAR, recovery_payload_size, "payload",
+                       !is_inlined)});
+
+  storage::DataTable *table = storage::TableFactory::GetDataTable(
+      database_oid, recovery_table_oid, table_schema, "recovery_table",
+      recovery_tuples_per_tilegroup, true, false);
+
+  std::vector<oid_t> key_attrs = {0};
+  auto tuple_schema = table->GetSchema();
+  catalog::Schema *key_schema =
+      catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "recovery_pkey_index", 123, recovery_table_oid, database_oid,
+      IndexType::BWTREE, IndexConstraintType::PRIMARY_KEY, tuple_schema,
+      key_schema, key_attrs, true);
+  std::shared_ptr<index::Index> pkey_index(
+      index::IndexFactory::GetIndex(index_metadata));
+  table->AddIndex(pkey_index);
+
+  return table;
+}
+
+void LoadTuples(storage::DataTable *table, const size_t tuple_count,
+                const uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  type::EphemeralPool pool;
+  auto schema = table->GetSchema();
+
+  std::string payload(recovery_payload_size - 1, 'a' + thread_itr % 26);
+  auto payload_value = type::ValueFactory::GetVarcharValue(payload);
+
+  size_t tuple_itr = 0;
+  while (tuple_itr < tuple_count) {
+    auto txn = txn_manager.BeginTransaction();
+    for (size_t i = 0; i < recovery_tuples_per_txn && tuple_itr < tuple_count;
+         ++i, ++tuple_itr) {
+      storage::Tuple tuple(schema, true);
+      tuple.SetValue(0, type::ValueFactory::GetIntegerValue(
+                            thread_itr * tuple_count + tuple_itr),
+                     &pool);
+      tuple.SetValue(1, payload_value, &pool);
+
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          table->InsertTuple(&tuple, txn, &index_entry_ptr);
+      EXPECT_TRUE(location.IsNull() == false);
+      txn_manager.PerformInsert(txn, location, index_entry_ptr);
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
+}  // namespace
+
+TEST_F(RecoveryPerformanceTests, MultiGigabyteRecoveryTest) {
+  // WARNING: this test writes and replays a log of the following size.
+  // the tuples are kept in memory twice as large at its peak.
+  const size_t log_size = 2UL * 1024 * 1024 * 1024;
+  const size_t loader_thread_count = 4;
+  const size_t recovery_thread_count = std::thread::hardware_concurrency();
+
+  const std::string logging_dir = "recovery_performance_test_dir";
+  const std::string db_name = "recovery_performance_db";
+
+  // besides the payload, each tuple record holds 37 bytes of header and
+  // fixed-size fields.
+  const size_t tuple_count_per_loader =
+      log_size / (recovery_payload_size + 37) / loader_thread_count;
+  const size_t tuple_count = tuple_count_per_loader * loader_thread_count;
+
+  auto database = TestingExecutorUtil::InitializeDatabase(db_name);
+  auto database_oid = database->GetOid();
+  database->AddTable(CreateRecoveryTable(database_oid));
+
+  // the epoch thread closes the epochs, so that the log is split into
+  // many epoch files.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.StartEpoch();
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectory(logging_dir);
+  log_manager.StartLogging();
+
+  Timer<std::milli> timer;
+  timer.Start();
+  LaunchParallelTest(loader_thread_count, LoadTuples,
+                     database->GetTableWithOid(recovery_table_oid),
+                     tuple_count_per_loader);
+  log_manager.StopLogging();
+  timer.Stop();
+
+  epoch_manager.StopEpoch();
+
+  LOG_INFO("Logged %lu tuples in %.2lf ms", tuple_count, timer.GetDuration());
+
+  // simulate a crash: the table is re-created without any data.
+  database->DropTableWithOid(recovery_table_oid);
+  auto table = CreateRecoveryTable(database_oid);
+  database->AddTable(table);
+
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(recovery_thread_count));
+
+  auto &stats = log_manager.GetRecoveryStats();
+  LOG_INFO("Recovered %lu bytes from %lu files with %lu threads",
+           stats.byte_count, stats.file_count, recovery_thread_count);
+  LOG_INFO("Read: %.2lf ms, Replay: %.2lf ms, Index: %.2lf ms",
+           stats.read_time_ms, stats.replay_time_ms, stats.index_time_ms);
+  LOG_INFO("Throughput: %.2lf records/s", stats.GetThroughput());
+
+  EXPECT_GE(stats.byte_count, log_size / 2);
+  EXPECT_EQ(tuple_count, stats.record_count);
+  EXPECT_EQ(0, stats.skipped_record_count);
+  EXPECT_EQ(tuple_count, table->GetTupleCount());
+
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  EXPECT_EQ(tuple_count, index_entries.size());
+
+  EXPECT_TRUE(logging::LoggingUtil::RemoveDirectory(logging_dir.c_str(), false));
+  TestingExecutorUtil::DeleteDatabase(db_name);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_only_transaction_sql_test.cpp
+//
+// Identification: test/sql/read_only_transaction_sql_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "parser/postgresparser.h"
+#include "sql/testing_sql_util.h"
+
+namespace peloton {
+namespace test {
+
+class ReadOnlyTransactionSQLTests : public PelotonTest {};
+
+// Apply a SET statement to the session, the way the network layer does
+ResultType SetVariable(const std::string &query) {
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto sql_stmt_list = peloton_parser.BuildParseTree(query);
+  EXPECT_TRUE(sql_stmt_list->is_valid);
+  return TestingSQLUtil::traffic_cop_.ExecuteVariableSet(
+      *static_cast<parser::VariableSetStatement *>(
+          sql_stmt_list->GetStatement(0)));
+}
+
+TEST_F(ReadOnlyTransactionSQLTests, DefaultReadOnlyTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 10);");
+
+  EXPECT_EQ(ResultType::SUCCESS,
+            SetVariable("SET default_transaction_read_only = on;"));
+  EXPECT_TRUE(TestingSQLUtil::traffic_cop_.IsDefaultTransactionReadOnly());
+
+  // Statements without a BEGIN run in read-only transactions of their own
+  EXPECT_EQ(ResultType::FAILURE, TestingSQLUtil::ExecuteSQLQuery(
+                                     "INSERT INTO test VALUES (2, 20);"));
+  EXPECT_EQ(ResultType::FAILURE,
+            TestingSQLUtil::ExecuteSQLQuery("UPDATE test SET b = 11;"));
+  EXPECT_EQ(ResultType::FAILURE,
+            TestingSQLUtil::ExecuteSQLQuery("DELETE FROM test;"));
+
+  // A prepared statement that is executed again begins its transaction only
+  // when it is executed
+  auto statement =
+      TestingSQLUtil::PrepareStatement("INSERT INTO test VALUES (3, 30);");
+  ASSERT_NE(nullptr, statement);
+  EXPECT_EQ(ResultType::FAILURE,
+            TestingSQLUtil::ExecutePreparedStatement(statement, {}));
+  EXPECT_EQ(ResultType::FAILURE,
+            TestingSQLUtil::ExecutePreparedStatement(statement, {}));
+
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult("SELECT * FROM test;",
+                                                {"1|10"});
+
+  // BEGIN READ WRITE overrides the default
+  TestingSQLUtil::ExecuteSQLQuery("BEGIN READ WRITE;");
+  EXPECT_EQ(ResultType::SUCCESS, TestingSQLUtil::ExecuteSQLQuery(
+                                     "INSERT INTO test VALUES (4, 40);"));
+  TestingSQLUtil::ExecuteSQLQuery("COMMIT;");
+
+  EXPECT_EQ(ResultType::SUCCESS,
+            SetVariable("SET default_transaction_read_only = off;"));
+  EXPECT_FALSE(TestingSQLUtil::traffic_cop_.IsDefaultTransactionReadOnly());
+
+  // BEGIN READ ONLY still rejects writes
+  TestingSQLUtil::ExecuteSQLQuery("BEGIN READ ONLY;");
+  EXPECT_EQ(ResultType::FAILURE, TestingSQLUtil::ExecuteSQLQuery(
+                                     "INSERT INTO test VALUES (5, 50);"));
+  TestingSQLUtil::ExecuteSQLQuery("ROLLBACK;");
+
+  EXPECT_EQ(ResultType::SUCCESS, TestingSQLUtil::ExecuteSQLQuery(
+                                     "INSERT INTO test VALUES (6, 60);"));
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult("SELECT * FROM test;",
+                                                {"1|10", "4|40", "6|60"});
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
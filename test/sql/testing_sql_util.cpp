@@ -238,6 +238,43 @@ ResultType TestingSQLUtil::ExecuteSQLQuery(const std::string query) {
   return status;
 }
 
+std::shared_ptr<Statement> TestingSQLUtil::PrepareStatement(
+    const std::string query) {
+  LOG_TRACE("Query: %s", query.c_str());
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto sql_stmt_list = peloton_parser.BuildParseTree(query);
+  PELOTON_ASSERT(sql_stmt_list);
+  if (!sql_stmt_list->is_valid) {
+    return nullptr;
+  }
+  return traffic_cop_.PrepareStatement("unnamed", query,
+                                       std::move(sql_stmt_list));
+}
+
+ResultType TestingSQLUtil::ExecutePreparedStatement(
+    std::shared_ptr<Statement> statement,
+    std::vector<type::Value> param_values) {
+  std::vector<ResultValue> result;
+  if (param_values.size() > 0) {
+    statement->GetPlanTree()->SetParameterValues(&param_values);
+  }
+
+  bool unnamed = false;
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  counter_.store(1);
+  auto status = traffic_cop_.ExecuteStatement(statement, param_values, unnamed,
+                                              nullptr, result_format, result);
+  if (traffic_cop_.GetQueuing()) {
+    ContinueAfterComplete();
+    traffic_cop_.ExecuteStatementPlanGetResult();
+    status = traffic_cop_.ExecuteStatementGetResult();
+    traffic_cop_.SetQueuing(false);
+  }
+  LOG_TRACE("Statement executed. Result: %s",
+            ResultTypeToString(status).c_str());
+  return status;
+}
+
 // Executes a query and compares the result with the given rows, either
 // ordered or not
 // The result vector has to be specified as follows:
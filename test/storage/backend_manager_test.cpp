@@ -12,6 +12,7 @@
 
 #include "common/harness.h"
 
+#include "settings/settings_manager.h"
 #include "storage/backend_manager.h"
 
 namespace peloton {
@@ -54,5 +55,38 @@ TEST_F(StorageManagerTests, BasicTest) {
   }
 }
 
+TEST_F(StorageManagerTests, MappedAllocationTest) {
+  peloton::storage::BackendManager backend_manager;
+
+  settings::SettingsManager::SetBool(settings::SettingId::huge_page_tile_data,
+                                     true);
+  settings::SettingsManager::SetBool(settings::SettingId::numa_aware_allocation,
+                                     true);
+
+  // Small allocations are not mapped on their own
+  std::vector<size_t> lengths = {256, 64 * 1024, 4 * 1024 * 1024 + 1};
+  std::vector<void *> locations;
+  for (auto length : lengths) {
+    auto location = backend_manager.Allocate(BackendType::MM, length);
+    PELOTON_MEMSET(location, '-', length);
+    locations.push_back(location);
+  }
+  EXPECT_EQ(lengths.size() - 1, backend_manager.GetMappedAllocationCount());
+
+  // Memory allocated before the settings change is still released correctly
+  settings::SettingsManager::SetBool(settings::SettingId::huge_page_tile_data,
+                                     false);
+  settings::SettingsManager::SetBool(settings::SettingId::numa_aware_allocation,
+                                     false);
+  auto location = backend_manager.Allocate(BackendType::MM, lengths[1]);
+  EXPECT_EQ(lengths.size() - 1, backend_manager.GetMappedAllocationCount());
+  backend_manager.Release(BackendType::MM, location);
+
+  for (auto location : locations) {
+    backend_manager.Release(BackendType::MM, location);
+  }
+  EXPECT_EQ(0, backend_manager.GetMappedAllocationCount());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,178 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column_test.cpp
+//
+// Identification: test/storage/compressed_column_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "storage/compressed_column.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compressed Column Tests
+//===--------------------------------------------------------------------===//
+
+class CompressedColumnTests : public PelotonTest {};
+
+TEST_F(CompressedColumnTests, FrameOfReferenceTest) {
+  const uint32_t tuple_count = 1000;
+  std::vector<int32_t> column(tuple_count);
+  for (uint32_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    column[tuple_itr] = -1000 + (tuple_itr * 7) % 100;
+  }
+
+  auto compressed = storage::CompressedColumn::Compress(
+      type::TypeId::INTEGER, reinterpret_cast<const char *>(column.data()),
+      sizeof(int32_t), tuple_count);
+  ASSERT_NE(nullptr, compressed);
+  EXPECT_EQ(storage::ColumnEncoding::FRAME_OF_REFERENCE,
+            compressed->GetEncoding());
+  EXPECT_EQ(-1000, compressed->GetReference());
+  EXPECT_EQ(7, compressed->GetBitWidth());
+  EXPECT_LT(compressed->GetSize(), tuple_count * sizeof(int32_t));
+
+  for (uint32_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(column[tuple_itr], compressed->GetRawValue(tuple_itr));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              compressed->GetValue(tuple_itr).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(column[tuple_itr])));
+  }
+
+  std::vector<int32_t> decompressed(tuple_count);
+  compressed->Decompress(reinterpret_cast<char *>(decompressed.data()),
+                         sizeof(int32_t));
+  EXPECT_EQ(column, decompressed);
+}
+
+TEST_F(CompressedColumnTests, RunLengthTest) {
+  const uint32_t tuple_count = 1000;
+  const int64_t run_values[] = {-5000000000000, 7, 7000000000000, 3};
+  std::vector<int64_t> column(tuple_count);
+  for (uint32_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    column[tuple_itr] = run_values[tuple_itr / 250];
+  }
+
+  auto compressed = storage::CompressedColumn::Compress(
+      type::TypeId::BIGINT, reinterpret_cast<const char *>(column.data()),
+      sizeof(int64_t), tuple_count);
+  ASSERT_NE(nullptr, compressed);
+  EXPECT_EQ(storage::ColumnEncoding::RUN_LENGTH, compressed->GetEncoding());
+
+  for (uint32_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(column[tuple_itr], compressed->GetRawValue(tuple_itr));
+  }
+
+  std::vector<int64_t> decompressed(tuple_count);
+  compressed->Decompress(reinterpret_cast<char *>(decompressed.data()),
+                         sizeof(int64_t));
+  EXPECT_EQ(column, decompressed);
+}
+
+TEST_F(CompressedColumnTests, IncompressibleTest) {
+  const uint32_t tuple_count = 1000;
+  std::vector<int64_t> column(tuple_count);
+  for (uint32_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    column[tuple_itr] = (tuple_itr % 2 == 0)
+                            ? std::numeric_limits<int64_t>::min() + tuple_itr
+                            : std::numeric_limits<int64_t>::max() - tuple_itr;
+  }
+
+  // The offsets need all 64 bits, and no two values are equal
+  EXPECT_EQ(nullptr, storage::CompressedColumn::Compress(
+                         type::TypeId::BIGINT,
+                         reinterpret_cast<const char *>(column.data()),
+                         sizeof(int64_t), tuple_count));
+
+  // Only integer types are compressed
+  EXPECT_EQ(nullptr, storage::CompressedColumn::Compress(
+                         type::TypeId::DECIMAL,
+                         reinterpret_cast<const char *>(column.data()),
+                         sizeof(double), tuple_count));
+}
+
+TEST_F(CompressedColumnTests, FreezeAndThawTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Versions committed in the cold epoch are not old enough
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(0, 0));
+
+  auto tile_group =
+      data_table->FreezeTileGroup(0, std::numeric_limits<eid_t>::max());
+  ASSERT_NE(nullptr, tile_group);
+  EXPECT_TRUE(tile_group->IsFrozen());
+  EXPECT_TRUE(tile_group->GetLayout().IsColumnStore());
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(
+                         0, std::numeric_limits<eid_t>::max()));
+
+  // The integer columns are compressed, the decimal and varchar ones are not
+  auto schema = data_table->GetSchema();
+  for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+       column_itr++) {
+    bool is_compressed = storage::CompressedColumn::IsCompressedType(
+        schema->GetType(column_itr));
+    EXPECT_EQ(is_compressed,
+              tile_group->GetCompressedColumn(column_itr) != nullptr);
+  }
+
+  // Values are decoded without thawing the tiles
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto value = tile_group->GetValue(tuple_itr, 0);
+    EXPECT_EQ(CmpBool::CmpTrue,
+              value.CompareEquals(type::ValueFactory::GetIntegerValue(
+                  TestingExecutorUtil::PopulatedValue(tuple_itr, 0))));
+  }
+  EXPECT_NE(nullptr, tile_group->GetCompressedColumn(0));
+
+  // Accessing the tile thaws it
+  auto tile = tile_group->GetTile(0);
+  EXPECT_EQ(nullptr, tile_group->GetCompressedColumn(0));
+  EXPECT_NE(nullptr, tile_group->GetCompressedColumn(1));
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto value = tile->GetValue(tuple_itr, 0);
+    EXPECT_EQ(CmpBool::CmpTrue,
+              value.CompareEquals(type::ValueFactory::GetIntegerValue(
+                  TestingExecutorUtil::PopulatedValue(tuple_itr, 0))));
+  }
+
+  // A thawed tile group is frozen again
+  EXPECT_FALSE(tile_group->IsFrozen());
+  tile_group =
+      data_table->FreezeTileGroup(0, std::numeric_limits<eid_t>::max());
+  ASSERT_NE(nullptr, tile_group);
+  EXPECT_TRUE(tile_group->IsFrozen());
+  EXPECT_NE(nullptr, tile_group->GetCompressedColumn(0));
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto value = tile_group->GetValue(tuple_itr, 0);
+    EXPECT_EQ(CmpBool::CmpTrue,
+              value.CompareEquals(type::ValueFactory::GetIntegerValue(
+                  TestingExecutorUtil::PopulatedValue(tuple_itr, 0))));
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
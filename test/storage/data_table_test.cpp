@@ -17,6 +17,8 @@
 #include "executor/testing_executor_util.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group_header.h"
 
 #include "concurrency/transaction_manager_factory.h"
 
@@ -73,6 +75,57 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
 }
 
 
+TEST_F(DataTableTests, TransformColdTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto tile_group_id = data_table->GetTileGroup(0)->GetTileGroupId();
+  auto orig_tile_group = storage_manager->GetTileGroup(tile_group_id);
+  auto orig_header = orig_tile_group->GetHeader();
+
+  // A version that is owned by a transaction keeps the tile group hot
+  orig_header->SetTransactionId(0, INITIAL_TXN_ID + 1);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(0, 0.0));
+  for (oid_t tuple_itr = 1; tuple_itr < orig_header->GetCurrentNextTupleSlot();
+       tuple_itr++) {
+    EXPECT_EQ(INITIAL_TXN_ID, orig_header->GetTransactionId(tuple_itr));
+  }
+  orig_header->SetTransactionId(0, INITIAL_TXN_ID);
+
+  auto new_tile_group = data_table->TransformTileGroup(0, 0.0);
+  ASSERT_NE(nullptr, new_tile_group);
+  EXPECT_EQ(new_tile_group,
+            storage_manager->GetTileGroup(tile_group_id).get());
+
+  // The new header points to the new tile group, and its versions are
+  // not owned, while the versions of the original stay owned.
+  auto new_header = new_tile_group->GetHeader();
+  EXPECT_EQ(new_tile_group, new_header->GetTileGroup());
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(INITIAL_TXN_ID, new_header->GetTransactionId(tuple_itr));
+    EXPECT_NE(INITIAL_TXN_ID, orig_header->GetTransactionId(tuple_itr));
+    EXPECT_EQ(orig_header->GetBeginCommitId(tuple_itr),
+              new_header->GetBeginCommitId(tuple_itr));
+    for (oid_t column_itr = 0;
+         column_itr < data_table->GetSchema()->GetColumnCount();
+         column_itr++) {
+      type::Value orig_value =
+          orig_tile_group->GetValue(tuple_itr, column_itr);
+      type::Value new_value = new_tile_group->GetValue(tuple_itr, column_itr);
+      EXPECT_EQ(CmpBool::CmpTrue, orig_value.CompareEquals(new_value));
+    }
+  }
+}
+
+
 TEST_F(DataTableTests, GlobalTableTest) {
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
 
@@ -87,5 +140,61 @@ TEST_F(DataTableTests, GlobalTableTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(DataTableTests, BulkInsertTest) {
+  const int tuples_per_tile_group = 5;
+  const int tuple_count = 12;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, true));
+  auto tile_group_count = data_table->GetTileGroupCount();
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Load the tuples in descending key order, a tile group at a time
+  auto txn = txn_manager.BeginTransaction();
+  storage::TileGroup *tile_group = nullptr;
+  oid_t tuple_start = 0;
+  for (int tuple_itr = tuple_count - 1; tuple_itr >= 0; tuple_itr--) {
+    auto tuple = TestingExecutorUtil::GetTuple(data_table.get(), tuple_itr,
+                                               pool);
+    oid_t tuple_id = INVALID_OID;
+    if (tile_group != nullptr) {
+      tuple_id = tile_group->InsertTuple(tuple.get());
+    }
+    if (tuple_id == INVALID_OID) {
+      if (tile_group != nullptr) {
+        EXPECT_TRUE(data_table->BulkInsertTuples(
+            tile_group, tuple_start, tuples_per_tile_group, txn));
+      }
+      tile_group = data_table->AddBulkLoadTileGroup();
+      tuple_start = 0;
+      tile_group->InsertTuple(tuple.get());
+    }
+  }
+  EXPECT_TRUE(data_table->BulkInsertTuples(
+      tile_group, tuple_start, tuple_count % tuples_per_tile_group, txn));
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(tile_group_count + 3, data_table->GetTileGroupCount());
+  EXPECT_EQ(static_cast<size_t>(tuple_count), data_table->GetTupleCount());
+  for (oid_t index_itr = 0; index_itr < data_table->GetIndexCount();
+       index_itr++) {
+    std::vector<ItemPointer *> index_entries;
+    data_table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(static_cast<size_t>(tuple_count), index_entries.size());
+  }
+
+  // A key that is loaded twice violates the primary key
+  txn = txn_manager.BeginTransaction();
+  tile_group = data_table->AddBulkLoadTileGroup();
+  for (int tuple_itr = 0; tuple_itr < 2; tuple_itr++) {
+    auto tuple = TestingExecutorUtil::GetTuple(data_table.get(), tuple_count,
+                                               pool);
+    tile_group->InsertTuple(tuple.get());
+  }
+  EXPECT_FALSE(data_table->BulkInsertTuples(tile_group, 0, 2, txn));
+  txn_manager.AbortTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
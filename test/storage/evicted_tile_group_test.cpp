@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// evicted_tile_group_test.cpp
+//
+// Identification: test/storage/evicted_tile_group_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Evicted Tile Group Tests
+//===--------------------------------------------------------------------===//
+
+class EvictedTileGroupTests : public PelotonTest {};
+
+TEST_F(EvictedTileGroupTests, EvictAndFaultInTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto schema = data_table->GetSchema();
+  std::vector<std::string> values;
+  auto orig_tile_group = data_table->GetTileGroup(0);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      values.push_back(
+          orig_tile_group->GetValue(tuple_itr, column_itr).ToString());
+    }
+  }
+
+  // Only frozen tile groups are evicted
+  EXPECT_EQ(nullptr, data_table->EvictTileGroup(0));
+  ASSERT_NE(nullptr, data_table->FreezeTileGroup(
+                         0, std::numeric_limits<eid_t>::max()));
+
+  auto tile_group = data_table->EvictTileGroup(0);
+  ASSERT_NE(nullptr, tile_group);
+  EXPECT_TRUE(tile_group->IsEvicted());
+  EXPECT_FALSE(tile_group->IsFrozen());
+  EXPECT_EQ(0, tile_group->GetResidentSize());
+  EXPECT_EQ(nullptr, data_table->EvictTileGroup(0));
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(
+                         0, std::numeric_limits<eid_t>::max()));
+
+  // A point read brings back the tile of its column only
+  EXPECT_EQ(values[0], tile_group->GetValue(0, 0).ToString());
+  EXPECT_TRUE(tile_group->IsEvicted());
+  EXPECT_TRUE(tile_group->IsFaultedIn());
+
+  tile_group->FaultIn();
+  EXPECT_FALSE(tile_group->IsEvicted());
+  EXPECT_NE(0, tile_group->GetResidentSize());
+  size_t value_itr = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      EXPECT_EQ(values[value_itr++],
+                tile_group->GetValue(tuple_itr, column_itr).ToString());
+    }
+  }
+}
+
+TEST_F(EvictedTileGroupTests, EvictAgainTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  ASSERT_NE(nullptr, data_table->FreezeTileGroup(
+                         0, std::numeric_limits<eid_t>::max()));
+  ASSERT_NE(nullptr, data_table->EvictTileGroup(0));
+  // keeps the copy that is replaced alive
+  auto tile_group = data_table->GetTileGroup(0);
+  tile_group->FaultIn();
+  EXPECT_FALSE(tile_group->IsEvicted());
+
+  // A tile group that was read back in is neither transformed nor frozen,
+  // but evicted again from the copy of its data in the eviction file
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(
+                         0, std::numeric_limits<eid_t>::max()));
+  auto evicted_tile_group = data_table->EvictTileGroup(0);
+  ASSERT_NE(nullptr, evicted_tile_group);
+  EXPECT_TRUE(evicted_tile_group->IsEvicted());
+  EXPECT_FALSE(evicted_tile_group->IsFaultedIn());
+  EXPECT_EQ(0, evicted_tile_group->GetResidentSize());
+  EXPECT_EQ(nullptr, data_table->EvictTileGroup(0));
+
+  auto schema = data_table->GetSchema();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      EXPECT_EQ(tile_group->GetValue(tuple_itr, column_itr).ToString(),
+                evicted_tile_group->GetValue(tuple_itr, column_itr).ToString());
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
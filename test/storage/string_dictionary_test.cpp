@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary_test.cpp
+//
+// Identification: test/storage/string_dictionary_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "storage/string_dictionary.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// String Dictionary Tests
+//===--------------------------------------------------------------------===//
+
+class StringDictionaryTests : public PelotonTest {};
+
+TEST_F(StringDictionaryTests, InternTest) {
+  storage::StringDictionary dictionary;
+  std::vector<std::string> strings = {"", "a", "ab", "abc"};
+
+  std::vector<const char *> varlens;
+  for (const auto &str : strings) {
+    varlens.push_back(dictionary.Intern(str.data(), str.size()));
+  }
+  EXPECT_EQ(strings.size(), dictionary.GetStringCount());
+
+  for (uint32_t str_itr = 0; str_itr < strings.size(); str_itr++) {
+    const auto &str = strings[str_itr];
+
+    // Interning a string again returns the same entry
+    std::string copy = str;
+    EXPECT_EQ(varlens[str_itr], dictionary.Intern(copy.data(), copy.size()));
+
+    // Codes are assigned in order, from 1
+    int32_t code = static_cast<int32_t>(str_itr) + 1;
+    EXPECT_EQ(code, storage::StringDictionary::GetCode(varlens[str_itr]));
+    EXPECT_EQ(code, dictionary.GetCode(str.data(), str.size()));
+    EXPECT_EQ(varlens[str_itr], dictionary.GetVarlen(code));
+
+    // The entry is read like any other varlen
+    auto value = type::Value::DeserializeFrom(
+        reinterpret_cast<const char *>(&varlens[str_itr]),
+        type::TypeId::VARCHAR, false);
+    EXPECT_EQ(str, value.ToString());
+  }
+  EXPECT_EQ(strings.size(), dictionary.GetStringCount());
+
+  std::string missing = "missing";
+  EXPECT_EQ(storage::StringDictionary::invalid_code_,
+            dictionary.GetCode(missing.data(), missing.size()));
+  EXPECT_EQ(nullptr, dictionary.GetVarlen(0));
+  EXPECT_EQ(nullptr, dictionary.GetVarlen(strings.size() + 1));
+}
+
+TEST_F(StringDictionaryTests, EncodedColumnTest) {
+  catalog::Column column(type::TypeId::VARCHAR, 25, "COL", false);
+  column.SetDictionaryEncoded();
+  std::unique_ptr<catalog::Schema> schema(new catalog::Schema({column}));
+  auto *dictionary = schema->GetDictionary(0);
+  ASSERT_NE(nullptr, dictionary);
+
+  // Tuples with equal strings share the entry of the string
+  storage::Tuple tuple1(schema.get(), true);
+  storage::Tuple tuple2(schema.get(), true);
+  tuple1.SetValue(0, type::ValueFactory::GetVarcharValue("dictionary"));
+  tuple2.SetValue(0, type::ValueFactory::GetVarcharValue("dictionary"));
+  EXPECT_EQ(1, dictionary->GetStringCount());
+  EXPECT_EQ(*reinterpret_cast<const char **>(tuple1.GetData()),
+            *reinterpret_cast<const char **>(tuple2.GetData()));
+  EXPECT_EQ(CmpBool::CmpTrue, tuple1.GetValue(0).CompareEquals(
+                                  tuple2.GetValue(0)));
+
+  // NULL strings are not added
+  tuple2.SetValue(0, type::ValueFactory::GetNullValueByType(
+                         type::TypeId::VARCHAR));
+  EXPECT_TRUE(tuple2.GetValue(0).IsNull());
+  EXPECT_EQ(1, dictionary->GetStringCount());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -17,7 +17,9 @@
 #include "type/value_factory.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
 #include "storage/tile_group.h"
+#include "storage/data_table.h"
 #include "storage/tile_group_factory.h"
 #include "storage/tile.h"
 #include "storage/tuple.h"
@@ -540,5 +542,83 @@ TEST_F(TileGroupTests, TileCopyTest) {
   EXPECT_TRUE(intended_behavior);
 }
 
+TEST_F(TileGroupTests, AllVisibleTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count + 1, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto full_header = data_table->GetTileGroup(0)->GetHeader();
+  auto partial_header = data_table->GetTileGroup(1)->GetHeader();
+  EXPECT_EQ(MAX_CID, full_header->GetAllVisibleCommitId());
+
+  // The versions must have been committed before the settled commit id
+  EXPECT_FALSE(full_header->SetAllVisible(INVALID_CID));
+  EXPECT_EQ(MAX_CID, full_header->GetAllVisibleCommitId());
+
+  // Tuples are still inserted into the tile group that is not full
+  EXPECT_FALSE(partial_header->SetAllVisible(MAX_CID - 1));
+  EXPECT_EQ(MAX_CID, partial_header->GetAllVisibleCommitId());
+
+  EXPECT_TRUE(full_header->SetAllVisible(MAX_CID - 1));
+  cid_t all_visible_cid = full_header->GetAllVisibleCommitId();
+  EXPECT_NE(MAX_CID, all_visible_cid);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_GE(all_visible_cid, full_header->GetBeginCommitId(tuple_itr));
+  }
+
+  // Transactions that start later skip the visibility checks
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(full_header->IsAllVisible(txn->GetReadId()));
+
+  // Taking ownership of a version resets the flag
+  EXPECT_TRUE(full_header->SetAtomicTransactionId(0, txn->GetTransactionId()));
+  EXPECT_EQ(MAX_CID, full_header->GetAllVisibleCommitId());
+  EXPECT_FALSE(full_header->IsAllVisible(txn->GetReadId()));
+  EXPECT_FALSE(full_header->SetAllVisible(MAX_CID - 1));
+
+  full_header->SetTransactionId(0, INITIAL_TXN_ID);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_TRUE(full_header->SetAllVisible(MAX_CID - 1));
+}
+
+TEST_F(TileGroupTests, RawLookupTest) {
+  catalog::Column column(type::TypeId::INTEGER,
+                         type::Type::GetTypeSize(type::TypeId::INTEGER), "A",
+                         true);
+  std::vector<catalog::Schema> schemas;
+  schemas.push_back(catalog::Schema({column}));
+  std::shared_ptr<const storage::Layout> layout =
+      std::make_shared<const storage::Layout>(1);
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  // the tile groups fall into different blocks of the lookup array.
+  oid_t tile_group_id = TestingHarness::GetInstance().GetNextTileGroupId();
+  std::vector<oid_t> tile_group_ids = {tile_group_id,
+                                       tile_group_id + (1 << 20)};
+  for (auto id : tile_group_ids) {
+    EXPECT_EQ(nullptr, storage_manager->GetTileGroupPtr(id));
+
+    std::shared_ptr<storage::TileGroup> tile_group(
+        storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID, id,
+                                                nullptr, schemas, layout, 4));
+    storage_manager->AddTileGroup(id, tile_group);
+    EXPECT_EQ(tile_group.get(), storage_manager->GetTileGroupPtr(id));
+    EXPECT_EQ(tile_group, storage_manager->GetTileGroup(id));
+  }
+
+  for (auto id : tile_group_ids) {
+    storage_manager->DropTileGroup(id);
+    EXPECT_EQ(nullptr, storage_manager->GetTileGroupPtr(id));
+    EXPECT_EQ(nullptr, storage_manager->GetTileGroup(id));
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
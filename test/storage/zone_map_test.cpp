@@ -418,6 +418,51 @@ TEST_F(ZoneMapTests, ZoneMapMultiColumnConjunctionPredicateTest) {
   pred4->ClearParsedPredicates();
   delete conj_pred;
 }
+
+TEST_F(ZoneMapTests, InMemoryZoneMapTest) {
+  // the zone maps are maintained on insert, without creating them in the
+  // catalog.
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(5, false, 1));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), 20, false, false, false,
+                                     txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto tile_group = data_table->GetTileGroup(1);
+  auto zone_map = tile_group->GetZoneMap();
+  type::Value min, max;
+  EXPECT_TRUE(zone_map->GetRange(0, min, max));
+  EXPECT_EQ(50, min.GetAs<int32_t>());
+  EXPECT_EQ(90, max.GetAs<int32_t>());
+  EXPECT_TRUE(zone_map->GetRange(2, min, max));
+  EXPECT_EQ(52, min.GetAs<double>());
+  EXPECT_EQ(92, max.GetAs<double>());
+
+  // the varchar column is not tracked
+  EXPECT_FALSE(zone_map->GetRange(3, min, max));
+
+  // Predicate A > 100
+  auto constant_value = type::ValueFactory::GetIntegerValue(100);
+  auto pred = CreateSinglePredicate(0, ExpressionType::COMPARE_GREATERTHAN,
+                                    constant_value);
+  EXPECT_TRUE(pred->IsZoneMappable());
+  auto temp =
+      (std::vector<storage::PredicateInfo> *)pred->GetParsedPredicates();
+  EXPECT_FALSE(tile_group->ShouldScan(temp->data(), 1));
+
+  // an update widens the range, and it is never shrunk
+  auto new_value = type::ValueFactory::GetIntegerValue(150);
+  tile_group->SetValue(new_value, 0, 0);
+  EXPECT_TRUE(tile_group->ShouldScan(temp->data(), 1));
+  EXPECT_TRUE(zone_map->GetRange(0, min, max));
+  EXPECT_EQ(50, min.GetAs<int32_t>());
+  EXPECT_EQ(150, max.GetAs<int32_t>());
+
+  pred->ClearParsedPredicates();
+  delete pred;
+}
 }
 }  // End test namespace
 }  // End peloton namespace
\ No newline at end of file
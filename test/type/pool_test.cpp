@@ -12,7 +12,9 @@
 
 #include <limits.h>
 #include <pthread.h>
+#include <vector>
 
+#include "type/arena_pool.h"
 #include "type/ephemeral_pool.h"
 #include "gtest/gtest.h"
 #include "common/harness.h"
@@ -63,5 +65,66 @@ TEST_F(PoolTests, AllocateOnceTest) {
   pool->Free(p);
 }
 
+// Chunks are carved out of shared blocks, and a block is released once all
+// of its chunks are freed
+TEST_F(PoolTests, ArenaAllocateTest) {
+  std::unique_ptr<type::ArenaPool> pool(new type::ArenaPool());
+  const size_t chunk_size = 100;
+  const size_t chunk_count = 3 * type::ArenaPool::block_size_ / chunk_size;
+
+  std::vector<char *> chunks;
+  for (size_t chunk_itr = 0; chunk_itr < chunk_count; chunk_itr++) {
+    char *p = static_cast<char *>(pool->Allocate(chunk_size));
+    EXPECT_TRUE(p != nullptr);
+    PELOTON_MEMSET(p, chunk_itr % CHAR_MAX, chunk_size);
+    chunks.push_back(p);
+  }
+  EXPECT_LE(3, pool->GetBlockCount());
+
+  // chunks do not overlap
+  for (size_t chunk_itr = 0; chunk_itr < chunk_count; chunk_itr++) {
+    for (size_t byte_itr = 0; byte_itr < chunk_size; byte_itr++) {
+      EXPECT_EQ(static_cast<char>(chunk_itr % CHAR_MAX),
+                chunks[chunk_itr][byte_itr]);
+    }
+  }
+
+  // only the current block is left
+  for (auto p : chunks) {
+    pool->Free(p);
+  }
+  EXPECT_EQ(1, pool->GetBlockCount());
+
+  // a large chunk gets a block of its own
+  void *p = pool->Allocate(type::ArenaPool::block_size_ * 2);
+  EXPECT_TRUE(p != nullptr);
+  EXPECT_EQ(2, pool->GetBlockCount());
+  pool->Free(p);
+  EXPECT_EQ(1, pool->GetBlockCount());
+}
+
+void ArenaAllocateHelper(type::ArenaPool *pool,
+                         UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  std::vector<char *> chunks;
+  for (size_t chunk_itr = 0; chunk_itr < M * 10; chunk_itr++) {
+    size_t size = RANDOM(str_len) + sizeof(uint32_t);
+    char *p = static_cast<char *>(pool->Allocate(size));
+    PELOTON_MEMSET(p, 0, size);
+    chunks.push_back(p);
+  }
+  for (auto p : chunks) {
+    pool->Free(p);
+  }
+}
+
+// Allocate and free from several threads
+TEST_F(PoolTests, ArenaConcurrentAllocateTest) {
+  std::unique_ptr<type::ArenaPool> pool(new type::ArenaPool());
+
+  LaunchParallelTest(N, ArenaAllocateHelper, pool.get());
+
+  EXPECT_EQ(1, pool->GetBlockCount());
+}
+
 }  // namespace test
 }  // namespace peloton